@@ -0,0 +1,467 @@
+//****************************************************************************
+// Product: Publish-subscribe fan-out benchmark (POSIX)
+// Last Updated for Version: 6.3.7
+// Date of the Last Update:  2018-11-22
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// Copyright (C) 2005-2018 Quantum Leaps, LLC. All rights reserved.
+//
+// This program is open source software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Alternatively, this program may be distributed and modified under the
+// terms of Quantum Leaps commercial licenses, which expressly supersede
+// the GNU General Public License and are specifically designed for
+// licensees interested in retaining the proprietary status of their code.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact information:
+// https://www.state-machine.com
+// mailto:info@state-machine.com
+//****************************************************************************
+#include "qpcpp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+using namespace QP;
+
+// The benchmark starts QF_MAX_ACTIVE "Sink" active objects, which only
+// count the received events, and lets 1, 8 and all of them subscribe to the
+// BENCH signal. The subscribers are spread evenly over the whole range of
+// priorities. The controller p-thread then publishes a static BENCH event
+// in bursts, which fill at most a half of the event queues of the Sinks,
+// and measures only the time spent in QF::PUBLISH(). During every burst all
+// Sinks are held in the HOLD event, so that the measurement includes the
+// insertion of the events into the queues, but not the wakeups of the
+// p-threads of the Sinks. The benchmark reports the average cost of
+// publishing an event and of a single delivery.
+//
+// With QF_PS_BROADCAST the BENCH signal has a broadcast channel, whose ring
+// holds a whole burst, so that the events are written only once into the
+// ring and every subscriber gets only a single doorbell per burst.
+//
+// With QF_PS_SPARSE the signals are spread over the whole signal space
+// (32-bit with Q_SIGNAL_SIZE == 4) and the subscriber lists form a hash
+// table of
+// NUM_LISTS lists, in which NUM_OTHER other signals claim their lists
+// before the BENCH signal, so that publishing probes a loaded hash table.
+//
+// With QF_PS_RANGES the benchmark first checks, which Sinks receive the
+// signals inside, on the edges of and outside of the overlapping ranges
+// subscribed by the first four Sinks (see checkRanges()).
+//
+enum {
+    NUM_SINKS   = QF_MAX_ACTIVE, // number of the Sink active objects
+    QUEUE_LEN   = 4096,          // length of the event queue of every Sink
+    BURST_LEN   = QUEUE_LEN / 2, // number of events published at once
+    DURATION_MS = 500,           // default duration of a single measurement
+    NUM_RANGE_SIGS = 16          // number of the signals of checkRanges()
+};
+
+#ifndef QF_PS_SPARSE
+enum BenchSignals {
+    BENCH_SIG = Q_USER_SIG,
+    RANGE_SIG, // the first of the signals of checkRanges()
+    MAX_PUB_SIG = RANGE_SIG + NUM_RANGE_SIGS,
+    HOLD_SIG = MAX_PUB_SIG, // hold the Sink until the burst is published
+    MAX_SIG
+};
+#elif (Q_SIGNAL_SIZE == 4) // signals spread over the 32-bit signal space
+enum BenchSignals {
+    HOLD_SIG   = Q_USER_SIG, // hold the Sink until the burst is published
+    OTHER_SIG  = 0x00010000, // the first of the other signals
+    OTHER_STEP = 0x00100007, // the distance of the other signals
+    BENCH_SIG  = 0x5A5A0001,
+    RANGE_SIG  = 0x5A5A0010  // the first of the signals of checkRanges()
+};
+#elif (Q_SIGNAL_SIZE == 2) // signals spread over the 16-bit signal space
+enum BenchSignals {
+    HOLD_SIG   = Q_USER_SIG, // hold the Sink until the burst is published
+    OTHER_SIG  = 0x0100,     // the first of the other signals
+    OTHER_STEP = 0x003D,     // the distance of the other signals
+    BENCH_SIG  = 0xFF01,
+    RANGE_SIG  = 0xFF10      // the first of the signals of checkRanges()
+};
+#else
+    #error "With QF_PS_SPARSE this benchmark requires Q_SIGNAL_SIZE 2 or 4"
+#endif // QF_PS_SPARSE
+
+#ifdef QF_PS_SPARSE
+enum {
+    NUM_OTHER = 1000, // the other signals, which claim the subscriber lists
+    NUM_LISTS = 1500  // the subscriber lists in the hash table
+};
+#endif // QF_PS_SPARSE
+
+//............................................................................
+class Sink : public QActive {
+public:
+    uint32_t volatile m_ctr; // number of BENCH events received
+#ifdef QF_PS_RANGES
+    uint32_t volatile m_got; // the signals of checkRanges() received
+#endif
+
+public:
+    Sink()
+      : QActive(Q_STATE_CAST(&Sink::initial)),
+        m_ctr(0U)
+#ifdef QF_PS_RANGES
+        , m_got(0U)
+#endif
+    {}
+    bool isIdle(void) const {
+        return m_eQueue.isEmpty();
+    }
+
+protected:
+    static void hold(void);
+    static QState initial(Sink * const me, QEvt const * const e);
+    static QState active(Sink * const me, QEvt const * const e);
+};
+
+//............................................................................
+static pthread_mutex_t l_holdMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  l_holdCond  = PTHREAD_COND_INITIALIZER;
+static uint32_t l_nHeld;   // number of the Sinks held in the HOLD event
+static bool     l_holding; // the Sinks are to be held
+
+//............................................................................
+void Sink::hold(void) {
+    pthread_mutex_lock(&l_holdMutex);
+    ++l_nHeld;
+    pthread_cond_broadcast(&l_holdCond);
+    while (l_holding) {
+        pthread_cond_wait(&l_holdCond, &l_holdMutex);
+    }
+    --l_nHeld;
+    pthread_cond_broadcast(&l_holdCond);
+    pthread_mutex_unlock(&l_holdMutex);
+}
+//............................................................................
+QState Sink::initial(Sink * const me, QEvt const * const e) {
+    (void)e; // unused parameter
+    return Q_TRAN(&Sink::active);
+}
+//............................................................................
+QState Sink::active(Sink * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case BENCH_SIG: {
+            ++me->m_ctr;
+            status_ = Q_HANDLED();
+            break;
+        }
+        case HOLD_SIG: {
+            hold();
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+#ifdef QF_PS_RANGES
+            uint32_t const k = static_cast<uint32_t>(e->sig)
+                               - static_cast<uint32_t>(RANGE_SIG);
+            if (k < static_cast<uint32_t>(NUM_RANGE_SIGS)) { // checkRanges()
+                me->m_got |= (static_cast<uint32_t>(1) << k);
+                ++me->m_ctr; // to detect any duplicates
+                status_ = Q_HANDLED();
+            }
+            else {
+                status_ = Q_SUPER(&QHsm::top);
+            }
+#else
+            status_ = Q_SUPER(&QHsm::top);
+#endif // QF_PS_RANGES
+            break;
+        }
+    }
+    return status_;
+}
+
+//............................................................................
+static Sink l_sink[NUM_SINKS];
+static QEvt const *l_sinkQueueSto[NUM_SINKS][QUEUE_LEN];
+#ifndef QF_PS_SPARSE
+static QSubscrList l_subscrSto[MAX_PUB_SIG];
+#else
+static QSubscrList l_subscrSto[NUM_LISTS]; // the hash table, see NOTE2
+#endif
+static QEvt const l_benchEvt = { static_cast<QSignal>(BENCH_SIG), 0U, 0U };
+static QEvt const l_holdEvt  = { static_cast<QSignal>(HOLD_SIG), 0U, 0U };
+#ifdef QF_PS_BROADCAST
+static QBroadcast  l_benchChan; // the broadcast channel of the BENCH signal
+static QEvt const *l_benchRing[BURST_LEN];
+#endif
+static uint32_t l_durationMs;
+
+//............................................................................
+static double elapsed(struct timespec const *t0, struct timespec const *t1) {
+    return static_cast<double>(t1->tv_sec - t0->tv_sec)
+           + static_cast<double>(t1->tv_nsec - t0->tv_nsec) * 1e-9;
+}
+//............................................................................
+static void holdSinks(void) {
+    pthread_mutex_lock(&l_holdMutex);
+    l_holding = true;
+    pthread_mutex_unlock(&l_holdMutex);
+
+    for (uint32_t i = 0U; i < static_cast<uint32_t>(NUM_SINKS); ++i) {
+        l_sink[i].POST(&l_holdEvt, static_cast<void *>(0));
+    }
+
+    pthread_mutex_lock(&l_holdMutex);
+    while (l_nHeld < static_cast<uint32_t>(NUM_SINKS)) { // not all held?
+        pthread_cond_wait(&l_holdCond, &l_holdMutex);
+    }
+    pthread_mutex_unlock(&l_holdMutex);
+}
+//............................................................................
+static void releaseSinks(void) {
+    pthread_mutex_lock(&l_holdMutex);
+    l_holding = false;
+    pthread_cond_broadcast(&l_holdCond);
+    while (l_nHeld > 0U) { // any Sinks still held?
+        pthread_cond_wait(&l_holdCond, &l_holdMutex);
+    }
+    pthread_mutex_unlock(&l_holdMutex);
+}
+//............................................................................
+static void drainSinks(uint32_t nSubscr, uint32_t nPublished) {
+    uint32_t i;
+    for (i = 0U; i < static_cast<uint32_t>(NUM_SINKS); ++i) {
+        while (!l_sink[i].isIdle()) {
+            sched_yield(); // let the Sink catch up
+        }
+    }
+    // the subscribers must also have read all the events of a broadcast
+    // channel, which are not in their event queues
+    uint32_t const step = static_cast<uint32_t>(NUM_SINKS) / nSubscr;
+    for (i = 0U; i < nSubscr; ++i) {
+        while (l_sink[i * step].m_ctr != nPublished) {
+            sched_yield(); // let the Sink catch up
+        }
+    }
+}
+#ifdef QF_PS_RANGES
+#if (QF_PS_RANGES < 5)
+    #error "checkRanges() requires QF_PS_RANGES of at least 5"
+#endif
+//............................................................................
+// Publishes all the signals RANGE_SIG + 0..15 and checks that the Sinks
+// 0..3 received exactly the signals of the bitmasks @p expected[] (and
+// every one of them only once).
+static bool checkRangeStep(char const *what, uint32_t const expected[4]) {
+    static QEvt rangeEvt[NUM_RANGE_SIGS];
+    uint32_t i;
+    bool ok = true;
+
+    for (i = 0U; i < 4U; ++i) { // the Sinks are idle
+        l_sink[i].m_got = 0U;
+        l_sink[i].m_ctr = 0U;
+    }
+    for (i = 0U; i < static_cast<uint32_t>(NUM_RANGE_SIGS); ++i) {
+        rangeEvt[i].sig = static_cast<QSignal>(RANGE_SIG + i);
+        rangeEvt[i].poolId_ = 0U;
+        rangeEvt[i].refCtr_ = 0U;
+        QF::PUBLISH(&rangeEvt[i], static_cast<void *>(0));
+    }
+    holdSinks(); // the Sinks have handled all the events before HOLD
+
+    printf("ranges %-26s", what);
+    for (i = 0U; i < 4U; ++i) {
+        uint32_t n = 0U; // the number of the expected signals
+        uint32_t m;
+        for (m = expected[i]; m != 0U; m &= m - 1U) {
+            ++n;
+        }
+        if ((l_sink[i].m_got != expected[i]) || (l_sink[i].m_ctr != n)) {
+            ok = false;
+        }
+        printf(" %04X", static_cast<unsigned>(l_sink[i].m_got));
+    }
+    printf(" %s\n", ok ? "PASS" : "FAIL");
+    releaseSinks();
+    return ok;
+}
+//............................................................................
+// Checks the range subscriptions of the Sinks 0..3 (the signals relative
+// to RANGE_SIG):
+//   Sink 0: ranges 2..9 and 14..15
+//   Sink 1: range 6..12, overlapping the range 2..9 of Sink 0
+//   Sink 2: range 9..9, on the edges of the ranges of Sinks 0 and 1
+//   Sink 3: range 4..5 and the direct subscription of the signal 4
+// The signals 0, 1 and 13 are outside of all the ranges.
+static bool checkRanges(void) {
+    static uint32_t const expAll[4]   = { 0xC3FCU, 0x1FC0U, 0x0200U, 0x30U };
+    static uint32_t const expUnsub[4] = { 0xC000U, 0x1FC0U, 0x0200U, 0x30U };
+    static uint32_t const expUnsubAll[4] = { 0xC000U, 0x0000U, 0x0200U, 0x00U };
+    enum_t const r = static_cast<enum_t>(RANGE_SIG);
+    bool ok;
+
+    l_sink[0].subscribeRange(r + 2, r + 9);
+    l_sink[0].subscribeRange(r + 14, r + 15);
+    l_sink[1].subscribeRange(r + 6, r + 12);
+    l_sink[2].subscribeRange(r + 9, r + 9);
+    l_sink[3].subscribe(r + 4);
+    l_sink[3].subscribeRange(r + 4, r + 5);
+    ok = checkRangeStep("overlapping ranges:", expAll);
+
+    l_sink[0].unsubscribeRange(r + 2, r + 9);
+    l_sink[3].unsubscribe(r + 4); // the range 4..5 still covers the signal
+    ok = checkRangeStep("after unsubscribeRange():", expUnsub) && ok;
+
+    l_sink[1].unsubscribeAll();
+    l_sink[3].unsubscribeAll();
+    ok = checkRangeStep("after unsubscribeAll():", expUnsubAll) && ok;
+
+    for (uint32_t i = 0U; i < 4U; ++i) {
+        l_sink[i].unsubscribeAll();
+    }
+    printf("\n");
+    return ok;
+}
+#endif // QF_PS_RANGES
+
+//............................................................................
+static void runPhase(uint32_t nSubscr) {
+    struct timespec tStart;
+    struct timespec t0;
+    struct timespec t1;
+    uint32_t i;
+
+    // subscribe every (NUM_SINKS / nSubscr)-th Sink
+    for (i = 0U; i < static_cast<uint32_t>(NUM_SINKS); ++i) {
+        l_sink[i].m_ctr = 0U; // all Sinks are idle between the phases
+    }
+    for (i = 0U; i < nSubscr; ++i) {
+        l_sink[i * (static_cast<uint32_t>(NUM_SINKS) / nSubscr)]
+            .subscribe(static_cast<enum_t>(BENCH_SIG));
+    }
+
+    uint32_t nPublished = 0U;
+    double sec = 0.0; // time spent in QF::PUBLISH()
+    clock_gettime(CLOCK_MONOTONIC, &tStart);
+    do {
+        holdSinks(); // outside of the measurement
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (i = 0U; i < static_cast<uint32_t>(BURST_LEN); ++i) {
+            QF::PUBLISH(&l_benchEvt, static_cast<void *>(0));
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        sec += elapsed(&t0, &t1);
+        nPublished += static_cast<uint32_t>(BURST_LEN);
+        releaseSinks();
+        drainSinks(nSubscr, nPublished); // outside of the measurement
+    } while (elapsed(&tStart, &t1) * 1000.0
+             < static_cast<double>(l_durationMs));
+
+    printf("%11u   %17.1f   %18.1f\n",
+           static_cast<unsigned>(nSubscr),
+           sec * 1e9 / static_cast<double>(nPublished),
+           sec * 1e9 / static_cast<double>(nPublished * nSubscr));
+
+    for (i = 0U; i < static_cast<uint32_t>(NUM_SINKS); ++i) {
+        l_sink[i].unsubscribeAll();
+    }
+}
+//............................................................................
+static void *controller(void * /*arg*/) {
+    struct timespec ts = { 0, 100000000L };
+    nanosleep(&ts, static_cast<struct timespec *>(0)); // let the QF start
+
+    printf("subscribers: %s\n",
+#if defined(QF_PS_BROADCAST)
+           "broadcast ring");
+#elif defined(QF_SUBSCR_DENSE)
+           "dense arrays");
+#else
+           "priority sets");
+#endif
+#ifdef QF_PS_SPARSE
+    // claim the lists of the other signals (they stay claimed even after
+    // unsubscribing), so that the BENCH signal is published from a loaded
+    // hash table
+    for (uint32_t k = 0U; k < static_cast<uint32_t>(NUM_OTHER); ++k) {
+        l_sink[0].subscribe(static_cast<enum_t>(OTHER_SIG)
+                            + static_cast<enum_t>(k * OTHER_STEP));
+    }
+    l_sink[0].unsubscribeAll();
+    printf("signals: sparse, %u other signals in %u lists\n",
+           static_cast<unsigned>(NUM_OTHER),
+           static_cast<unsigned>(NUM_LISTS));
+#endif
+    printf("%u ms per measurement\n\n", static_cast<unsigned>(l_durationMs));
+
+    bool ok = true;
+#ifdef QF_PS_RANGES
+    ok = checkRanges();
+#endif
+    if (ok) { // skip the measurements if the check failed
+        static uint32_t const nSubscr[] = { 1U, 8U, NUM_SINKS };
+        printf("subscribers   publish cost [ns]   delivery cost [ns]\n");
+        for (uint32_t n = 0U; n < Q_DIM(nSubscr); ++n) {
+            runPhase(nSubscr[n]);
+        }
+    }
+
+    QF::stop(); // stop the QF::run() loop in main()
+    return static_cast<void *>(0);
+}
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    l_durationMs = (argc > 1)
+                   ? static_cast<uint32_t>(atoi(argv[1]))
+                   : static_cast<uint32_t>(DURATION_MS);
+
+    QF::init(); // initialize the framework
+    QF::psInit(l_subscrSto, Q_DIM(l_subscrSto)); // init publish-subscribe
+#ifdef QF_PS_BROADCAST
+    QF::psBroadcast(static_cast<enum_t>(BENCH_SIG), &l_benchChan,
+                    l_benchRing, Q_DIM(l_benchRing));
+#endif
+
+    for (uint32_t i = 0U; i < static_cast<uint32_t>(NUM_SINKS); ++i) {
+        l_sink[i].start(static_cast<uint_fast8_t>(i + 1U), // priority
+                        l_sinkQueueSto[i], Q_DIM(l_sinkQueueSto[i]),
+                        static_cast<void *>(0), 0U); // no stack
+    }
+
+    pthread_t thread;
+    pthread_create(&thread, static_cast<pthread_attr_t *>(0),
+                   &controller, static_cast<void *>(0));
+
+    return QF::run(); // run the QF application until QF::stop()
+}
+
+//****************************************************************************
+extern "C" void Q_onAssert(char const * const module, int loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+//............................................................................
+void QF::onStartup(void) {
+    QF_setTickRate(100U, 50); // 100 ticks per second
+}
+//............................................................................
+void QF::onCleanup(void) {
+}
+//............................................................................
+void QP::QF_onClockTick(void) {
+    QF::TICK_X(0U, static_cast<void *>(0)); // QF clock tick processing
+}
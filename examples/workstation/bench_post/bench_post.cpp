@@ -0,0 +1,357 @@
+//****************************************************************************
+// Product: Event-posting contention benchmark (POSIX)
+// Last Updated for Version: 6.3.7
+// Date of the Last Update:  2018-11-20
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// Copyright (C) 2005-2018 Quantum Leaps, LLC. All rights reserved.
+//
+// This program is open source software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Alternatively, this program may be distributed and modified under the
+// terms of Quantum Leaps commercial licenses, which expressly supersede
+// the GNU General Public License and are specifically designed for
+// licensees interested in retaining the proprietary status of their code.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact information:
+// https://www.state-machine.com
+// mailto:info@state-machine.com
+//****************************************************************************
+#include "qpcpp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+
+using namespace QP;
+
+// The benchmark runs 1..N independent producer/consumer pairs, where N is
+// the number of online CPUs. Every producer is a plain p-thread posting
+// events as fast as it can to its own "Sink" active object. Because the
+// pairs share no QF objects (except the event pool for dynamic events),
+// the total throughput should grow with the number of pairs, unless the
+// QF critical sections serialize them.
+//
+enum {
+    MAX_PAIRS   = 16,  // maximum number of producer/consumer pairs
+    QUEUE_LEN   = 256, // length of the event queue of every Sink
+    DURATION_MS = 500, // default duration of a single measurement
+    BATCH_LEN   = 8    // number of events posted at once in a batch
+};
+
+enum BenchSignals {
+    BENCH_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+struct BenchEvt : public QEvt {
+    uint32_t seq; // sequence number of the event
+};
+
+enum BenchMode {
+    STATIC_EVT,  // post a static event
+    DYNAMIC_EVT, // post a dynamic event allocated from the event pool
+    BATCH_EVT,   // post BATCH_LEN static events at once
+    INLINE_EVT   // post a small event by value (QF_EVT_INLINE only)
+};
+
+//............................................................................
+class Sink : public QActive {
+public:
+    uint32_t volatile m_ctr; // number of BENCH events received
+
+public:
+    Sink()
+      : QActive(Q_STATE_CAST(&Sink::initial)),
+        m_ctr(0U)
+    {}
+
+protected:
+    static QState initial(Sink * const me, QEvt const * const e);
+    static QState active(Sink * const me, QEvt const * const e);
+};
+
+//............................................................................
+QState Sink::initial(Sink * const me, QEvt const * const e) {
+    (void)e; // unused parameter
+    return Q_TRAN(&Sink::active);
+}
+//............................................................................
+QState Sink::active(Sink * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case BENCH_SIG: {
+            ++me->m_ctr;
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm::top);
+            break;
+        }
+    }
+    return status_;
+}
+
+//............................................................................
+struct Producer {
+    Sink *sink;       // the Sink AO to post to
+    BenchMode mode;   // the kind of events to post
+    uint32_t nPosted; // number of events successfully posted
+};
+
+static Sink l_sink[MAX_PAIRS];
+static QEvt const *l_sinkQueueSto[MAX_PAIRS][QUEUE_LEN];
+static QF_MPOOL_EL(BenchEvt) l_evtPoolSto[MAX_PAIRS * QUEUE_LEN * 2];
+static QEvt const l_staticEvt = { static_cast<QSignal>(BENCH_SIG), 0U, 0U };
+
+static uint_fast8_t l_nPairs;
+static uint32_t l_durationMs;
+static bool volatile l_produce;
+
+//............................................................................
+static void *producer(void *arg) {
+    Producer * const p = static_cast<Producer *>(arg);
+    uint32_t n = 0U;
+
+    while (l_produce) {
+#ifdef QF_EVT_INLINE
+        if (p->mode == INLINE_EVT) {
+            // post by value with margin, so that a full queue is not an error
+            if (p->sink->POST_INLINE_X(BENCH_SIG, n, 1U,
+                                       static_cast<void *>(0)))
+            {
+                ++n;
+            }
+            else {
+                sched_yield(); // let the consumer catch up
+            }
+            continue;
+        }
+#endif // QF_EVT_INLINE
+        if (p->mode == BATCH_EVT) {
+            static QEvt const * const batch[BATCH_LEN] = {
+                &l_staticEvt, &l_staticEvt, &l_staticEvt, &l_staticEvt,
+                &l_staticEvt, &l_staticEvt, &l_staticEvt, &l_staticEvt
+            };
+            // post the whole batch with margin (all or nothing)
+            if (p->sink->POST_BATCH_X(batch, BATCH_LEN, 1U,
+                                      static_cast<void *>(0)))
+            {
+                n += static_cast<uint32_t>(BATCH_LEN);
+            }
+            else {
+                sched_yield(); // let the consumer catch up
+            }
+            continue;
+        }
+        QEvt const *e;
+        if (p->mode == DYNAMIC_EVT) {
+            BenchEvt *be;
+            Q_NEW_X(be, BenchEvt, 1U, BENCH_SIG);
+            if (be == static_cast<BenchEvt *>(0)) { // pool depleted?
+                sched_yield(); // let the consumers catch up
+                continue;
+            }
+            be->seq = n;
+            e = be;
+        }
+        else {
+            e = &l_staticEvt;
+        }
+
+        // post with margin, so that a full queue is not an error
+        if (p->sink->POST_X(e, 1U, static_cast<void *>(0))) {
+            ++n;
+        }
+        else {
+            sched_yield(); // let the consumer catch up
+        }
+    }
+    p->nPosted = n;
+    return static_cast<void *>(0);
+}
+//............................................................................
+static void sleepMs(uint32_t ms) {
+    struct timespec ts;
+    ts.tv_sec  = ms / 1000U;
+    ts.tv_nsec = static_cast<long>(ms % 1000U) * 1000000L;
+    nanosleep(&ts, static_cast<struct timespec *>(0));
+}
+//............................................................................
+static uint32_t runPhase(uint_fast8_t nPairs, BenchMode mode,
+                         double *mevts)
+{
+    Producer prod[MAX_PAIRS];
+    pthread_t thread[MAX_PAIRS];
+    struct timespec t0;
+    struct timespec t1;
+    uint_fast8_t i;
+
+    l_produce = true;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (i = 0U; i < nPairs; ++i) {
+        prod[i].sink    = &l_sink[i];
+        prod[i].mode    = mode;
+        prod[i].nPosted = 0U;
+        pthread_create(&thread[i], static_cast<pthread_attr_t *>(0),
+                       &producer, &prod[i]);
+    }
+    sleepMs(l_durationMs);
+    l_produce = false;
+
+    uint32_t total = 0U;
+    for (i = 0U; i < nPairs; ++i) {
+        pthread_join(thread[i], static_cast<void **>(0));
+        total += prod[i].nPosted;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    double sec = static_cast<double>(t1.tv_sec - t0.tv_sec)
+                 + static_cast<double>(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    *mevts = static_cast<double>(total) / sec * 1e-6;
+
+    sleepMs(50U); // let the Sinks drain their queues
+    return total;
+}
+//............................................................................
+static void *controller(void * /*arg*/) {
+    sleepMs(100U); // let the QF and all Sink AOs start
+
+    printf("QF critical sections: %s\n",
+#ifdef QF_OBJ_LOCK_TYPE
+           "per-object locks");
+#else
+           "single global lock");
+#endif
+    printf("AO event queues:      %s\n",
+#ifdef QF_MPSC_EQUEUE
+           "lock-free MPSC");
+#else
+           "QEQueue");
+#endif
+    printf("event ref-counters:   %s\n",
+#ifdef QF_EVT_REF_ATOMIC
+           "atomic");
+#else
+           "in critical section");
+#endif
+    printf("event pools:          %s\n",
+#ifdef QF_LOCKFREE_EPOOL
+           "lock-free QLFPool");
+#else
+           "QMPool");
+#endif
+#ifdef QF_MAGAZINE_SIZE
+    printf("per-thread magazines: %u blocks\n",
+           static_cast<unsigned>(QF_MAGAZINE_SIZE));
+#endif
+#ifdef QF_DRAIN_MAX
+    printf("AO queue draining:    %u events at once\n",
+           static_cast<unsigned>(QF_DRAIN_MAX));
+#endif
+    printf("%u pair(s), %u ms per measurement\n\n",
+           static_cast<unsigned>(l_nPairs),
+           static_cast<unsigned>(l_durationMs));
+#ifdef QF_EVT_INLINE
+    printf("pairs   static [Mevt/s]   dynamic [Mevt/s]   batch [Mevt/s]"
+           "   inline [Mevt/s]\n");
+#else
+    printf("pairs   static [Mevt/s]   dynamic [Mevt/s]   batch [Mevt/s]\n");
+#endif
+
+    uint32_t posted = 0U;
+    for (uint_fast8_t n = 1U; n <= l_nPairs; ++n) {
+        double mStatic;
+        double mDynamic;
+        double mBatch;
+        posted += runPhase(n, STATIC_EVT,  &mStatic);
+        posted += runPhase(n, DYNAMIC_EVT, &mDynamic);
+        posted += runPhase(n, BATCH_EVT,   &mBatch);
+#ifdef QF_EVT_INLINE
+        double mInline;
+        posted += runPhase(n, INLINE_EVT,  &mInline);
+        printf("%5u   %16.3f   %16.3f   %14.3f   %15.3f\n",
+               static_cast<unsigned>(n), mStatic, mDynamic, mBatch, mInline);
+#else
+        printf("%5u   %16.3f   %16.3f   %14.3f\n",
+               static_cast<unsigned>(n), mStatic, mDynamic, mBatch);
+#endif
+    }
+
+    uint32_t received = 0U;
+    for (uint_fast8_t i = 0U; i < l_nPairs; ++i) {
+        received += l_sink[i].m_ctr;
+    }
+    printf("\nposted=%u received=%u pool-min=%u\n",
+           static_cast<unsigned>(posted), static_cast<unsigned>(received),
+           static_cast<unsigned>(QF::getPoolMin(1U)));
+
+    QF::stop(); // stop the QF::run() loop in main()
+    return static_cast<void *>(0);
+}
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    l_durationMs = (argc > 1)
+                   ? static_cast<uint32_t>(atoi(argv[1]))
+                   : static_cast<uint32_t>(DURATION_MS);
+
+    long ncpu = (argc > 2)
+                ? atol(argv[2])
+                : sysconf(_SC_NPROCESSORS_ONLN);
+    l_nPairs = static_cast<uint_fast8_t>(
+                   (ncpu < 1L) ? 1L
+                   : (ncpu > static_cast<long>(MAX_PAIRS))
+                       ? static_cast<long>(MAX_PAIRS) : ncpu);
+
+    QF::init(); // initialize the framework
+    QF::poolInit(l_evtPoolSto, sizeof(l_evtPoolSto),
+                 sizeof(l_evtPoolSto[0]));
+
+    for (uint_fast8_t i = 0U; i < l_nPairs; ++i) {
+        l_sink[i].start(i + 1U, // priority
+                        l_sinkQueueSto[i], Q_DIM(l_sinkQueueSto[i]),
+                        static_cast<void *>(0), 0U); // no stack
+    }
+
+    pthread_t thread;
+    pthread_create(&thread, static_cast<pthread_attr_t *>(0),
+                   &controller, static_cast<void *>(0));
+
+    return QF::run(); // run the QF application until QF::stop()
+}
+
+//****************************************************************************
+extern "C" void Q_onAssert(char const * const module, int loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+//............................................................................
+void QF::onStartup(void) {
+    QF_setTickRate(100U, 50); // 100 ticks per second
+}
+//............................................................................
+void QF::onCleanup(void) {
+}
+//............................................................................
+void QP::QF_onClockTick(void) {
+    QF::TICK_X(0U, static_cast<void *>(0)); // QF clock tick processing
+}
@@ -0,0 +1,375 @@
+//****************************************************************************
+// Product: Priority-set and QV scheduling benchmark (POSIX-QV)
+// Last Updated for Version: 6.3.7
+// Date of the Last Update:  2018-11-22
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// Copyright (C) 2005-2018 Quantum Leaps, LLC. All rights reserved.
+//
+// This program is open source software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Alternatively, this program may be distributed and modified under the
+// terms of Quantum Leaps commercial licenses, which expressly supersede
+// the GNU General Public License and are specifically designed for
+// licensees interested in retaining the proprietary status of their code.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact information:
+// https://www.state-machine.com
+// mailto:info@state-machine.com
+//****************************************************************************
+#include "qpcpp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+using namespace QP;
+
+// The benchmark measures first the cost of QPSet::findMax() alone on a
+// table of priority sets with 1..8 random elements. Then it starts the
+// "Driver" active object at the lowest priority and QF_MAX_ACTIVE - 1
+// "Sink" active objects, which only count the received events, and lets
+// 1, 8 and all Sinks subscribe to the BENCH signal. The subscribers are
+// spread evenly over the whole range of the priorities. In every cycle the
+// Driver publishes a static BENCH event and posts to itself the STEP event,
+// so that the QV event loop schedules all the subscribers and the Driver
+// again. The benchmark reports the average cost of a cycle and of a single
+// scheduled run-to-completion step (both in nanoseconds).
+//
+// With QF_PRIO_BANDS defined, the first four Sinks (priorities 2..5) form
+// a band with the quantum of 3 events, and the benchmark first checks the
+// order, in which the QV event loop dispatches the CHECK events posted to
+// the band (see checkBands()).
+//
+enum {
+    NUM_SINKS   = QF_MAX_ACTIVE - 1, // number of the Sink active objects
+    QUEUE_LEN   = 8,       // length of the event queues
+    NUM_SETS    = 1024,    // number of the priority sets for findMax()
+    DURATION_MS = 500      // default duration of a single measurement
+};
+
+enum BenchSignals {
+    BENCH_SIG = Q_USER_SIG,
+    MAX_PUB_SIG,
+    STEP_SIG = MAX_PUB_SIG, // the next cycle of the Driver
+    CHECK_SIG, // the check of the priority bands
+    MAX_SIG
+};
+
+//............................................................................
+class Sink : public QActive {
+public:
+    uint32_t m_ctr; // number of BENCH events received
+
+public:
+    Sink()
+      : QActive(Q_STATE_CAST(&Sink::initial)),
+        m_ctr(0U)
+    {}
+
+protected:
+    static QState initial(Sink * const me, QEvt const * const e);
+    static QState active(Sink * const me, QEvt const * const e);
+};
+
+//............................................................................
+class Driver : public QActive {
+private:
+    uint32_t m_phase;   // the current phase of the benchmark
+    uint32_t m_nCycles; // number of the cycles in the current phase
+    struct timespec m_t0; // start of the current phase
+
+public:
+    Driver()
+      : QActive(Q_STATE_CAST(&Driver::initial)),
+        m_phase(0U),
+        m_nCycles(0U)
+    {}
+
+protected:
+    void startPhase(void);
+    static QState initial(Driver * const me, QEvt const * const e);
+    static QState active(Driver * const me, QEvt const * const e);
+};
+
+//............................................................................
+static Sink   l_sink[NUM_SINKS];
+static Driver l_driver;
+static QEvt const *l_sinkQueueSto[NUM_SINKS][QUEUE_LEN];
+static QEvt const *l_driverQueueSto[QUEUE_LEN];
+static QSubscrList l_subscrSto[MAX_PUB_SIG];
+static QEvt const l_benchEvt = { static_cast<QSignal>(BENCH_SIG), 0U, 0U };
+static QEvt const l_stepEvt  = { static_cast<QSignal>(STEP_SIG),  0U, 0U };
+static uint32_t const l_nSubscr[] = { 1U, 8U, NUM_SINKS };
+static uint32_t l_durationMs;
+
+#ifdef QF_PRIO_BANDS
+enum {
+    BAND_LO      = 2, // the lowest priority of the band (Sink 0)
+    BAND_HI      = 5, // the highest priority of the band (Sink 3)
+    BAND_QUANTUM = 3, // the quantum of the band
+    BAND_CHECKS  = 7  // the CHECK events posted to every Sink of the band
+};
+static QEvt const l_checkEvt = { static_cast<QSignal>(CHECK_SIG), 0U, 0U };
+static char l_checkLog[64]; // the Sinks, which handled the CHECK events
+static uint32_t l_checkLen;
+#endif // QF_PRIO_BANDS
+
+//............................................................................
+static double elapsed(struct timespec const *t0, struct timespec const *t1) {
+    return static_cast<double>(t1->tv_sec - t0->tv_sec)
+           + static_cast<double>(t1->tv_nsec - t0->tv_nsec) * 1e-9;
+}
+
+//............................................................................
+QState Sink::initial(Sink * const me, QEvt const * const e) {
+    (void)e; // unused parameter
+    return Q_TRAN(&Sink::active);
+}
+//............................................................................
+QState Sink::active(Sink * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case BENCH_SIG: {
+            ++me->m_ctr;
+            status_ = Q_HANDLED();
+            break;
+        }
+#ifdef QF_PRIO_BANDS
+        case CHECK_SIG: {
+            uint32_t const i = static_cast<uint32_t>(me - &l_sink[0]);
+            if (l_checkLen < sizeof(l_checkLog) - 1U) {
+                l_checkLog[l_checkLen] = static_cast<char>('0' + i);
+                ++l_checkLen;
+            }
+            ++me->m_ctr;
+            // the 2nd event of Sink 1 wakes up Sink 4 above the band
+            if ((i == 1U) && (me->m_ctr == 2U)) {
+                l_sink[4].POST(&l_checkEvt, me);
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+#endif // QF_PRIO_BANDS
+        default: {
+            status_ = Q_SUPER(&QHsm::top);
+            break;
+        }
+    }
+    return status_;
+}
+
+#ifdef QF_PRIO_BANDS
+//............................................................................
+// Checks the order, in which the QV event loop dispatched the CHECK events
+// posted by the Driver to the Sinks 0..3 of the band. The Sinks of the band
+// must take turns of BAND_QUANTUM events, starting from the highest
+// priority of the band, while Sink 4 (above the band) must run right after
+// the event of Sink 1, which posted to it, even in the middle of the turn
+// of Sink 1.
+static bool checkBands(void) {
+    static char const expected[] =
+        "333" "222" "1141" "000" // the 1st round, Sink 4 preempts Sink 1
+        "333" "222" "111" "000"  // the 2nd round
+        "3" "2" "1" "0";         // the rest of the queues
+    l_checkLog[l_checkLen] = '\0';
+    bool const ok = (strcmp(l_checkLog, expected) == 0);
+    printf("bands (quantum %u): %s %s\n\n",
+           static_cast<unsigned>(BAND_QUANTUM),
+           l_checkLog, ok ? "PASS" : "FAIL");
+    return ok;
+}
+#endif // QF_PRIO_BANDS
+
+//............................................................................
+void Driver::startPhase(void) {
+    uint32_t const n = l_nSubscr[m_phase];
+    uint32_t i;
+    if (m_phase == 0U) {
+        printf("subscribers   cycle cost [ns]   per RTC step [ns]\n");
+    }
+    for (i = 0U; i < static_cast<uint32_t>(NUM_SINKS); ++i) {
+        l_sink[i].unsubscribeAll();
+        l_sink[i].m_ctr = 0U;
+    }
+    for (i = 0U; i < n; ++i) { // spread the subscribers evenly
+        l_sink[(i * NUM_SINKS) / n].subscribe(static_cast<enum_t>(BENCH_SIG));
+    }
+    m_nCycles = 0U;
+    clock_gettime(CLOCK_MONOTONIC, &m_t0);
+}
+//............................................................................
+QState Driver::initial(Driver * const me, QEvt const * const e) {
+    (void)e; // unused parameter
+#ifdef QF_PRIO_BANDS
+    // the Driver (at the lowest priority) gets the CHECK event only after
+    // the Sinks have handled all their CHECK events
+    for (uint32_t n = 0U; n < static_cast<uint32_t>(BAND_CHECKS); ++n) {
+        for (uint32_t i = 0U; i <= BAND_HI - BAND_LO; ++i) {
+            l_sink[i].POST(&l_checkEvt, me);
+        }
+    }
+    me->POST(&l_checkEvt, me);
+#else
+    me->startPhase();
+    me->POST(&l_stepEvt, me);
+#endif // QF_PRIO_BANDS
+    return Q_TRAN(&Driver::active);
+}
+//............................................................................
+QState Driver::active(Driver * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case STEP_SIG: {
+            double sec = 0.0;
+            if ((me->m_nCycles & 0xFFU) == 0U) { // time to check the clock?
+                struct timespec t1;
+                clock_gettime(CLOCK_MONOTONIC, &t1);
+                sec = elapsed(&me->m_t0, &t1);
+            }
+            if (sec * 1000.0 < static_cast<double>(l_durationMs)) {
+                QF::PUBLISH(&l_benchEvt, me);
+                me->POST(&l_stepEvt, me);
+                ++me->m_nCycles;
+            }
+            else {
+                uint32_t const n = l_nSubscr[me->m_phase];
+                double const ns = sec * 1e9
+                                  / static_cast<double>(me->m_nCycles);
+                printf("%11u   %15.1f   %17.1f\n",
+                       static_cast<unsigned>(n), ns,
+                       ns / static_cast<double>(n + 1U));
+                ++me->m_phase;
+                if (me->m_phase < Q_DIM(l_nSubscr)) {
+                    me->startPhase();
+                    me->POST(&l_stepEvt, me);
+                }
+                else {
+                    QF::stop(); // stop the QF::run() event loop in main()
+                }
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+#ifdef QF_PRIO_BANDS
+        case CHECK_SIG: { // all CHECK events of the Sinks handled
+            if (checkBands()) {
+                me->startPhase(); // proceed to the benchmark
+                me->POST(&l_stepEvt, me);
+            }
+            else {
+                QF::stop(); // stop the QF::run() event loop in main()
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+#endif // QF_PRIO_BANDS
+        default: {
+            status_ = Q_SUPER(&QHsm::top);
+            break;
+        }
+    }
+    return status_;
+}
+
+//............................................................................
+static void benchFindMax(void) {
+    static QPSet sets[NUM_SETS];
+    struct timespec t0;
+    struct timespec t1;
+    uint32_t i;
+    uint32_t nPasses = 0U; // number of passes over all the sets
+    uint32_t sum; // sum of the maximums of all the sets in a single pass
+    double sec;
+
+    srand(1U); // repeatable contents of the priority sets
+    for (i = 0U; i < static_cast<uint32_t>(NUM_SETS); ++i) {
+        uint32_t k = 1U + static_cast<uint32_t>(rand() % 8);
+        sets[i].setEmpty();
+        for (; k != 0U; --k) {
+            sets[i].insert(static_cast<QPrio>(1 + (rand() % QF_MAX_ACTIVE)));
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    do {
+        sum = 0U;
+        for (i = 0U; i < static_cast<uint32_t>(NUM_SETS); ++i) {
+            sum += static_cast<uint32_t>(sets[i].findMax());
+        }
+        ++nPasses;
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        sec = elapsed(&t0, &t1);
+    } while (sec * 1000.0 < static_cast<double>(l_durationMs));
+
+    printf("findMax() [ns]: %.2f (average maximum %u)\n\n",
+           sec * 1e9 / (static_cast<double>(nPasses) * NUM_SETS),
+           static_cast<unsigned>(sum / NUM_SETS));
+}
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    l_durationMs = (argc > 1)
+                   ? static_cast<uint32_t>(atoi(argv[1]))
+                   : static_cast<uint32_t>(DURATION_MS);
+
+    printf("QF_MAX_ACTIVE: %u, QF_LOG2: %s\n",
+           static_cast<unsigned>(QF_MAX_ACTIVE),
+#ifdef QF_LOG2
+           "defined");
+#else
+           "not defined");
+#endif
+    printf("%u ms per measurement\n\n", static_cast<unsigned>(l_durationMs));
+
+    benchFindMax();
+
+    QF::init(); // initialize the framework
+    QF::psInit(l_subscrSto, Q_DIM(l_subscrSto));
+#ifdef QF_PRIO_BANDS
+    QF::bandInit(static_cast<QPrio>(BAND_LO), static_cast<QPrio>(BAND_HI),
+                 static_cast<uint_fast16_t>(BAND_QUANTUM));
+#endif // QF_PRIO_BANDS
+
+    for (uint32_t i = 0U; i < static_cast<uint32_t>(NUM_SINKS); ++i) {
+        l_sink[i].start(static_cast<QPrio>(i + 2U), // priority
+                        l_sinkQueueSto[i], Q_DIM(l_sinkQueueSto[i]),
+                        static_cast<void *>(0), 0U); // no stack
+    }
+    l_driver.start(1U, // the lowest priority
+                   l_driverQueueSto, Q_DIM(l_driverQueueSto),
+                   static_cast<void *>(0), 0U); // no stack
+
+    return QF::run(); // run the QF application until QF::stop()
+}
+
+//****************************************************************************
+extern "C" void Q_onAssert(char const * const module, int loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+//............................................................................
+void QF::onStartup(void) {
+    QF_setTickRate(0U, 50); // no ticker thread
+}
+//............................................................................
+void QF::onCleanup(void) {
+}
+//............................................................................
+void QP::QF_onClockTick(void) {
+}
@@ -0,0 +1,313 @@
+//****************************************************************************
+// Product: Time-event tick processing benchmark (POSIX)
+// Last Updated for Version: 6.3.7
+// Date of the Last Update:  2018-11-22
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// Copyright (C) 2005-2018 Quantum Leaps, LLC. All rights reserved.
+//
+// This program is open source software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Alternatively, this program may be distributed and modified under the
+// terms of Quantum Leaps commercial licenses, which expressly supersede
+// the GNU General Public License and are specifically designed for
+// licensees interested in retaining the proprietary status of their code.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact information:
+// https://www.state-machine.com
+// mailto:info@state-machine.com
+//****************************************************************************
+#include "qpcpp.h"
+
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+using namespace QP;
+
+// The benchmark arms N periodic time events (N = 10^2..10^6) with random
+// periods and phases spread over about a million ticks, and then measures
+// the average cost of QF::tickX_() at the tick rate 1, which is driven by
+// the controller p-thread as fast as it can. (The tick rate 0 is driven by
+// the ticker thread of the POSIX port and has no time events.) All time
+// events post to a single "Sink" active object, which only counts them.
+//
+enum {
+    TICK_RATE   = 1,       // the tick rate used for the benchmark time events
+    QUEUE_LEN   = 4096,    // length of the event queue of the Sink
+    MAX_TIMERS  = 1000000, // maximum number of the armed time events
+    MIN_PERIOD  = 1 << 19, // minimum period of the time events [ticks]
+    DURATION_MS = 200      // default duration of a single measurement
+};
+
+enum BenchSignals {
+    TIMEOUT_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+//............................................................................
+class Sink : public QActive {
+public:
+    uint32_t volatile m_ctr; // number of TIMEOUT events received
+
+public:
+    Sink()
+      : QActive(Q_STATE_CAST(&Sink::initial)),
+        m_ctr(0U)
+    {}
+    uint_fast16_t nFree(void) const {
+        return static_cast<uint_fast16_t>(m_eQueue.getNFree());
+    }
+    bool isIdle(void) const {
+        return m_eQueue.isEmpty();
+    }
+
+protected:
+    static QState initial(Sink * const me, QEvt const * const e);
+    static QState active(Sink * const me, QEvt const * const e);
+};
+
+//............................................................................
+QState Sink::initial(Sink * const me, QEvt const * const e) {
+    (void)e; // unused parameter
+    return Q_TRAN(&Sink::active);
+}
+//............................................................................
+QState Sink::active(Sink * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case TIMEOUT_SIG: {
+            ++me->m_ctr;
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm::top);
+            break;
+        }
+    }
+    return status_;
+}
+
+//............................................................................
+static Sink l_sink;
+static QEvt const *l_sinkQueueSto[QUEUE_LEN];
+static QTimeEvt *l_timers; // storage for the benchmark time events
+static uint32_t l_durationMs;
+static bool l_checkOk = true; // result of the regression check
+
+//............................................................................
+static double elapsed(struct timespec const *t0, struct timespec const *t1) {
+    return static_cast<double>(t1->tv_sec - t0->tv_sec)
+           + static_cast<double>(t1->tv_nsec - t0->tv_nsec) * 1e-9;
+}
+//............................................................................
+static void drainSink(void) {
+    while (!l_sink.isIdle()) {
+        sched_yield(); // let the Sink catch up
+    }
+}
+//............................................................................
+static void runPhase(uint32_t nTimers) {
+    struct timespec t0;
+    struct timespec t1;
+    uint32_t i;
+
+    srand(nTimers); // repeatable periods and phases
+    for (i = 0U; i < nTimers; ++i) {
+        QTimeEvt * const te = new (&l_timers[i])
+            QTimeEvt(&l_sink, static_cast<enum_t>(TIMEOUT_SIG),
+                     static_cast<uint_fast8_t>(TICK_RATE));
+        QTimeEvtCtr const period = static_cast<QTimeEvtCtr>(
+            MIN_PERIOD + (rand() % MIN_PERIOD));
+        te->armX(static_cast<QTimeEvtCtr>(1 + (rand() % period)), period);
+    }
+
+    uint32_t const ctr0 = l_sink.m_ctr;
+    uint32_t nTicks = 0U;
+    double sec;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    do {
+        for (i = 0U; i < 256U; ++i) {
+            // keep enough room in the queue for the expiring time events
+            if (l_sink.nFree() < static_cast<uint_fast16_t>(QUEUE_LEN / 2)) {
+                drainSink();
+            }
+            QF::TICK_X(static_cast<uint_fast8_t>(TICK_RATE),
+                       static_cast<void *>(0));
+        }
+        nTicks += 256U;
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        sec = elapsed(&t0, &t1);
+    } while (sec * 1000.0 < static_cast<double>(l_durationMs));
+    drainSink();
+
+    uint32_t const nExpired = l_sink.m_ctr - ctr0;
+    printf("%9u   %14.1f   %15.3f\n",
+           static_cast<unsigned>(nTimers),
+           sec * 1e9 / static_cast<double>(nTicks),
+           static_cast<double>(nExpired) / static_cast<double>(nTicks));
+
+    for (i = 0U; i < nTimers; ++i) {
+        (void)l_timers[i].disarm();
+    }
+    // let the linear list of time events unlink the disarmed time events
+    // before their storage is reused
+    QF::TICK_X(static_cast<uint_fast8_t>(TICK_RATE), static_cast<void *>(0));
+    drainSink();
+}
+#ifdef QF_TIMEEVT_WHEEL
+//............................................................................
+// Regression check of a time event armed 2^(2*QF_TIMEEVT_WHEEL)-1 ticks
+// ahead, which lands in the current slot of the level 1 of the timing wheel
+// (a full rotation ahead). The time event must expire exactly on time and,
+// in the tickless mode, QF::ticksToNextX() must not miss its cascading.
+static bool checkWheel(void) {
+    QTimeEvtCtr const timeout = static_cast<QTimeEvtCtr>(
+        (static_cast<uint32_t>(1) << (2 * QF_TIMEEVT_WHEEL)) - 1U);
+    bool ok = true;
+
+#ifdef QF_TICKLESS
+    // run the tick counter ahead of the ticker thread, so that the timeout
+    // is not extended by the ticks the ticker has not processed yet (see
+    // NOTE3 in qf_time.cpp) and the time event lands in the intended slot
+    for (uint32_t i = 0U; i < 1000U; ++i) {
+        QF::TICK_X(static_cast<uint_fast8_t>(TICK_RATE),
+                   static_cast<void *>(0));
+    }
+#endif // QF_TICKLESS
+
+    // the time event lands in the current slot of the level 1 only when
+    // the level 0 is not at the start of its rotation
+    while ((QF::getTickCtr(static_cast<uint_fast8_t>(TICK_RATE))
+            & ((static_cast<QTickCtr>(1) << QF_TIMEEVT_WHEEL) - 1U)) == 0U)
+    {
+        QF::TICK_X(static_cast<uint_fast8_t>(TICK_RATE),
+                   static_cast<void *>(0));
+    }
+
+    QTimeEvt * const te = new (&l_timers[0])
+        QTimeEvt(&l_sink, static_cast<enum_t>(TIMEOUT_SIG),
+                 static_cast<uint_fast8_t>(TICK_RATE));
+    te->armX(timeout, 0U); // counts from the current tick
+
+    QTickCtr start;
+    QTimeEvtCtr left;
+    do { // the ticker thread can tick in between
+        start = QF::getTickCtr(static_cast<uint_fast8_t>(TICK_RATE));
+        left  = te->ctr();
+    } while (start != QF::getTickCtr(static_cast<uint_fast8_t>(TICK_RATE)));
+
+#ifdef QF_TICKLESS
+    QTimeEvtCtr const next =
+        QF::ticksToNextX(static_cast<uint_fast8_t>(TICK_RATE));
+    ok = (next != static_cast<QTimeEvtCtr>(0)) && (next <= left);
+#endif // QF_TICKLESS
+
+    while (ok && (te->ctr() != static_cast<QTimeEvtCtr>(0))) {
+        QF::TICK_X(static_cast<uint_fast8_t>(TICK_RATE),
+                   static_cast<void *>(0));
+        ok = ((QF::getTickCtr(static_cast<uint_fast8_t>(TICK_RATE)) - start)
+              <= static_cast<QTickCtr>(left));
+    }
+    ok = ok && ((QF::getTickCtr(static_cast<uint_fast8_t>(TICK_RATE))
+                 - start) == static_cast<QTickCtr>(left));
+    (void)te->disarm();
+    drainSink();
+
+    printf("wheel check: timeout of %u ticks %s\n\n",
+           static_cast<unsigned>(timeout), ok ? "OK" : "FAILED");
+    return ok;
+}
+#endif // QF_TIMEEVT_WHEEL
+
+//............................................................................
+static void *controller(void * /*arg*/) {
+    struct timespec ts = { 0, 100000000L };
+    nanosleep(&ts, static_cast<struct timespec *>(0)); // let the QF start
+
+    printf("time events: %s\n",
+#ifdef QF_TIMEEVT_WHEEL
+           "hierarchical timing wheel");
+    printf("wheel slots: %u per level\n",
+           static_cast<unsigned>(1U << QF_TIMEEVT_WHEEL));
+#else
+           "linear list");
+#endif
+    printf("%u ms per measurement\n\n", static_cast<unsigned>(l_durationMs));
+
+#ifdef QF_TIMEEVT_WHEEL
+    l_checkOk = checkWheel();
+#endif
+    printf("   timers   tick cost [ns]   expired [1/tick]\n");
+
+    for (uint32_t n = 100U; n <= static_cast<uint32_t>(MAX_TIMERS); n *= 10U) {
+        runPhase(n);
+    }
+
+    QF::stop(); // stop the QF::run() loop in main()
+    return static_cast<void *>(0);
+}
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    l_durationMs = (argc > 1)
+                   ? static_cast<uint32_t>(atoi(argv[1]))
+                   : static_cast<uint32_t>(DURATION_MS);
+
+    l_timers = static_cast<QTimeEvt *>(
+                   malloc(sizeof(QTimeEvt) * MAX_TIMERS));
+    if (l_timers == static_cast<QTimeEvt *>(0)) {
+        fprintf(stderr, "Not enough memory for %u time events\n",
+                static_cast<unsigned>(MAX_TIMERS));
+        return -1;
+    }
+
+    QF::init(); // initialize the framework
+
+    l_sink.start(1U, // priority
+                 l_sinkQueueSto, Q_DIM(l_sinkQueueSto),
+                 static_cast<void *>(0), 0U); // no stack
+
+    pthread_t thread;
+    pthread_create(&thread, static_cast<pthread_attr_t *>(0),
+                   &controller, static_cast<void *>(0));
+
+    int ret = QF::run(); // run the QF application until QF::stop()
+    free(l_timers);
+    return l_checkOk ? ret : -1;
+}
+
+//****************************************************************************
+extern "C" void Q_onAssert(char const * const module, int loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+//............................................................................
+void QF::onStartup(void) {
+    QF_setTickRate(100U, 50); // 100 ticks per second
+}
+//............................................................................
+void QF::onCleanup(void) {
+}
+//............................................................................
+void QP::QF_onClockTick(void) {
+    QF::TICK_X(0U, static_cast<void *>(0)); // QF clock tick processing
+}
@@ -0,0 +1,247 @@
+//****************************************************************************
+// Product: M:N work-stealing executor benchmark (POSIX)
+// Last Updated for Version: 6.3.7
+// Date of the Last Update:  2018-11-22
+//
+//                    Q u a n t u m  L e a P s
+//                    ------------------------
+//                    Modern Embedded Software
+//
+// Copyright (C) 2005-2018 Quantum Leaps, LLC. All rights reserved.
+//
+// This program is open source software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published
+// by the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// Alternatively, this program may be distributed and modified under the
+// terms of Quantum Leaps commercial licenses, which expressly supersede
+// the GNU General Public License and are specifically designed for
+// licensees interested in retaining the proprietary status of their code.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+//
+// Contact information:
+// https://www.state-machine.com
+// mailto:info@state-machine.com
+//****************************************************************************
+#include "qpcpp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+using namespace QP;
+
+// The benchmark starts QF_MAX_ACTIVE "Node" active objects arranged in a
+// ring and circulates 1, 8 and 64 TOKEN events around the ring. Every Node
+// only counts a received TOKEN and forwards it to the next Node, so that
+// most of the Nodes are idle most of the time and every TOKEN event wakes
+// up an idle active object. The controller p-thread measures the number
+// of the TOKEN hops in a fixed duration and reports the average cost of
+// a hop (post, scheduling and run-to-completion step) in nanoseconds.
+//
+// With the posix-ws port the Nodes are executed by the pool of the worker
+// threads. With the posix port every Node has its own p-thread.
+//
+enum {
+    NUM_NODES   = QF_MAX_ACTIVE, // number of the Node active objects
+    MAX_TOKENS  = 64,      // maximum number of the circulating tokens
+    QUEUE_LEN   = MAX_TOKENS, // all tokens might end up in a single queue
+    DURATION_MS = 500      // default duration of a single measurement
+};
+
+enum BenchSignals {
+    TOKEN_SIG = Q_USER_SIG,
+    MAX_SIG
+};
+
+static QEvt const l_tokenEvt = { static_cast<QSignal>(TOKEN_SIG), 0U, 0U };
+static bool volatile l_isCirculating; // the Nodes forward the tokens
+
+//............................................................................
+class Node : public QActive {
+public:
+    uint32_t volatile m_hops;     // number of TOKEN events received
+    uint32_t volatile m_absorbed; // number of TOKEN events not forwarded
+    Node *m_next;                 // the next Node in the ring
+
+public:
+    Node()
+      : QActive(Q_STATE_CAST(&Node::initial)),
+        m_hops(0U),
+        m_absorbed(0U),
+        m_next(static_cast<Node *>(0))
+    {}
+
+protected:
+    static QState initial(Node * const me, QEvt const * const e);
+    static QState active(Node * const me, QEvt const * const e);
+};
+
+//............................................................................
+QState Node::initial(Node * const me, QEvt const * const e) {
+    (void)e; // unused parameter
+    return Q_TRAN(&Node::active);
+}
+//............................................................................
+QState Node::active(Node * const me, QEvt const * const e) {
+    QState status_;
+    switch (e->sig) {
+        case TOKEN_SIG: {
+            ++me->m_hops;
+            if (l_isCirculating) {
+                me->m_next->POST(e, me); // forward the immutable token
+            }
+            else {
+                ++me->m_absorbed; // the measurement is over
+            }
+            status_ = Q_HANDLED();
+            break;
+        }
+        default: {
+            status_ = Q_SUPER(&QHsm::top);
+            break;
+        }
+    }
+    return status_;
+}
+
+//............................................................................
+static Node l_nodes[NUM_NODES];
+static QEvt const *l_nodeQueueSto[NUM_NODES][QUEUE_LEN];
+static uint32_t l_durationMs;
+
+//............................................................................
+static double elapsed(struct timespec const *t0, struct timespec const *t1) {
+    return static_cast<double>(t1->tv_sec - t0->tv_sec)
+           + static_cast<double>(t1->tv_nsec - t0->tv_nsec) * 1e-9;
+}
+//............................................................................
+static uint32_t sumHops(void) {
+    uint32_t sum = 0U;
+    for (uint32_t n = 0U; n < static_cast<uint32_t>(NUM_NODES); ++n) {
+        sum += l_nodes[n].m_hops;
+    }
+    return sum;
+}
+//............................................................................
+static uint32_t sumAbsorbed(void) {
+    uint32_t sum = 0U;
+    for (uint32_t n = 0U; n < static_cast<uint32_t>(NUM_NODES); ++n) {
+        sum += l_nodes[n].m_absorbed;
+    }
+    return sum;
+}
+//............................................................................
+static void runPhase(uint32_t nTokens) {
+    struct timespec ts = { 0, 1000000L };
+    struct timespec t0;
+    struct timespec t1;
+
+    uint32_t const absorbed0 = sumAbsorbed();
+    l_isCirculating = true;
+
+    // inject the tokens evenly spaced around the ring
+    for (uint32_t i = 0U; i < nTokens; ++i) {
+        l_nodes[(i * NUM_NODES) / nTokens].POST(&l_tokenEvt,
+                                                 static_cast<void *>(0));
+    }
+
+    uint32_t const hops0 = sumHops();
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    double sec;
+    do {
+        nanosleep(&ts, static_cast<struct timespec *>(0));
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        sec = elapsed(&t0, &t1);
+    } while (sec * 1000.0 < static_cast<double>(l_durationMs));
+    uint32_t const nHops = sumHops() - hops0;
+
+    // stop the circulation and wait until all tokens are absorbed
+    l_isCirculating = false;
+    while (sumAbsorbed() - absorbed0 < nTokens) {
+        nanosleep(&ts, static_cast<struct timespec *>(0));
+    }
+
+    printf("%6u   %12.2f   %13.1f\n",
+           static_cast<unsigned>(nTokens),
+           static_cast<double>(nHops) / sec * 1e-6,
+           sec * 1e9 / static_cast<double>(nHops));
+}
+//............................................................................
+static void *controller(void * /*arg*/) {
+    struct timespec ts = { 0, 100000000L };
+    nanosleep(&ts, static_cast<struct timespec *>(0)); // let the QF start
+
+#ifdef QF_WS_MAX_WORKERS
+    printf("executor: M:N work-stealing (posix-ws), batch %u\n",
+           static_cast<unsigned>(QF_WS_BATCH));
+#else
+    printf("executor: p-thread per active object (posix)\n");
+#endif
+    printf("%u active objects, %u ms per measurement\n\n",
+           static_cast<unsigned>(NUM_NODES),
+           static_cast<unsigned>(l_durationMs));
+    printf("tokens   hops [M/sec]   hop cost [ns]\n");
+
+    for (uint32_t n = 1U; n <= static_cast<uint32_t>(MAX_TOKENS); n *= 8U) {
+        runPhase(n);
+    }
+
+    QF::stop(); // stop the QF::run() in main()
+    return static_cast<void *>(0);
+}
+
+//............................................................................
+int main(int argc, char *argv[]) {
+    l_durationMs = (argc > 1)
+                   ? static_cast<uint32_t>(atoi(argv[1]))
+                   : static_cast<uint32_t>(DURATION_MS);
+
+    QF::init(); // initialize the framework
+
+#ifdef QF_WS_MAX_WORKERS
+    // the optional number of the worker threads (default one per core)
+    if (argc > 2) {
+        QF_setWorkers(static_cast<uint_fast8_t>(atoi(argv[2])));
+    }
+#endif
+
+    for (uint32_t n = 0U; n < static_cast<uint32_t>(NUM_NODES); ++n) {
+        l_nodes[n].m_next = &l_nodes[(n + 1U) % NUM_NODES];
+        l_nodes[n].start(static_cast<QPrio>(n + 1U), // priority
+                         l_nodeQueueSto[n], Q_DIM(l_nodeQueueSto[n]),
+                         static_cast<void *>(0), 0U); // no stack
+    }
+
+    pthread_t thread;
+    pthread_create(&thread, static_cast<pthread_attr_t *>(0),
+                   &controller, static_cast<void *>(0));
+
+    return QF::run(); // run the QF application until QF::stop()
+}
+
+//****************************************************************************
+extern "C" void Q_onAssert(char const * const module, int loc) {
+    fprintf(stderr, "Assertion failed in %s:%d\n", module, loc);
+    exit(-1);
+}
+//............................................................................
+void QF::onStartup(void) {
+    QF_setTickRate(100U, 50); // 100 ticks per second
+}
+//............................................................................
+void QF::onCleanup(void) {
+}
+//............................................................................
+void QP::QF_onClockTick(void) {
+    QF::TICK_X(0U, static_cast<void *>(0)); // QF clock tick processing
+}
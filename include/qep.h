@@ -65,6 +65,18 @@
     #define Q_SIGNAL_SIZE 2
 #endif
 
+#ifndef QF_EVT_REF_CTR_SIZE
+    //! The size (in bytes) of the reference counter of an event. Valid
+    //! values: 1, 2, or 4; default 1
+    /// @description
+    /// This macro can be defined in the QF port file (qf_port.h) to
+    /// configure the QP::QEvtRefCtr type. A wider reference counter is
+    /// useful mostly with the atomic reference counting of dynamic events
+    /// (#QF_EVT_REF_ATOMIC), which some multi-core QF ports can provide.
+    /// When the macro is not defined, the default of 1 byte is chosen.
+    #define QF_EVT_REF_CTR_SIZE 1
+#endif
+
 //****************************************************************************
 // typedefs for basic numerical types; MISRA-C++ 2008 rule 3-9-2(req).
 
@@ -152,6 +164,21 @@ extern char_t const versionStr[6];
     #error "Q_SIGNAL_SIZE defined incorrectly, expected 1, 2, or 4"
 #endif
 
+#if (QF_EVT_REF_CTR_SIZE == 1)
+    //! QEvtRefCtr represents the reference counter of a dynamic event.
+    /// @description
+    /// The dynamic range of this data type determines the maximum number
+    /// of outstanding references to a single dynamic event (e.g., the
+    /// number of event queues the event can be posted to at the same time).
+    typedef uint8_t QEvtRefCtr;
+#elif (QF_EVT_REF_CTR_SIZE == 2)
+    typedef uint16_t QEvtRefCtr;
+#elif (QF_EVT_REF_CTR_SIZE == 4)
+    typedef uint32_t QEvtRefCtr;
+#else
+    #error "QF_EVT_REF_CTR_SIZE defined incorrectly, expected 1, 2, or 4"
+#endif
+
 #ifdef Q_EVT_CTOR // Provide the constructor for the QEvt class?
 
     //************************************************************************
@@ -167,7 +194,7 @@ extern char_t const versionStr[6];
         QEvt(QSignal const s, StaticEvt /*dummy*/)
           : sig(s),
             poolId_(static_cast<uint8_t>(0)),
-            refCtr_(static_cast<uint8_t>(0))
+            refCtr_(static_cast<QEvtRefCtr>(0))
         {}
 
 #ifdef Q_EVT_VIRTUAL
@@ -180,7 +207,7 @@ extern char_t const versionStr[6];
 
     private:
         uint8_t poolId_;          //!< pool ID (0 for static event)
-        uint8_t volatile refCtr_; //!< reference counter
+        QEvtRefCtr volatile refCtr_; //!< reference counter
 
         friend class QF;
         friend class QActive;
@@ -188,8 +215,10 @@ extern char_t const versionStr[6];
         friend class QTimeEvt;
         friend class QEQueue;
         friend class QTicker;
+        friend class QInlineEvt;
+        friend class QBroadcast;
         friend uint8_t QF_EVT_POOL_ID_ (QEvt const * const e);
-        friend uint8_t QF_EVT_REF_CTR_ (QEvt const * const e);
+        friend QEvtRefCtr QF_EVT_REF_CTR_ (QEvt const * const e);
         friend void QF_EVT_REF_CTR_INC_(QEvt const * const e);
         friend void QF_EVT_REF_CTR_DEC_(QEvt const * const e);
     };
@@ -209,7 +238,7 @@ extern char_t const versionStr[6];
     struct QEvt {
         QSignal sig;              //!< signal of the event instance
         uint8_t poolId_;          //!< pool ID (0 for static event)
-        uint8_t volatile refCtr_; //!< reference counter
+        QEvtRefCtr volatile refCtr_; //!< reference counter
     };
 
 #endif // Q_EVT_CTOR
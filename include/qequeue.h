@@ -79,6 +79,107 @@ namespace QP {
 #endif
 
 
+#ifdef QF_EVT_INLINE
+
+#if (Q_SIGNAL_SIZE < 2)
+    #error "QF_EVT_INLINE requires Q_SIGNAL_SIZE of at least 2"
+#endif
+#if (Q_SIGNAL_SIZE == 4) && (defined UINTPTR_MAX) \
+    && (UINTPTR_MAX <= 0xFFFFFFFFU)
+    #error "QF_EVT_INLINE with 4-byte signals requires 64-bit pointers"
+#endif
+
+//****************************************************************************
+//! Small event passed by value through the native QF event queues
+/// @description
+/// When the macro #QF_EVT_INLINE is defined, the events of this class are
+/// not stored in the event queues by pointer, but by value: the signal and
+/// the parameter are packed directly into the ring-buffer slot (an odd
+/// value that cannot be confused with a pointer to an event). Such events
+/// are posted from a temporary with QP::QActive::postInline_() (see the
+/// macros POST_INLINE() and POST_INLINE_X()), so they need no event pool.
+/// When removed from the queue, the event is copied back into the instance
+/// of QP::QInlineEvt inside the queue, which remains valid until the next
+/// event is removed from the same queue.
+///
+/// @note
+/// The parameter can use at most (8*sizeof(void*) - 8*Q_SIGNAL_SIZE - 1)
+/// bits, that is 32 bits on 64-bit CPUs, but only 15 bits on 32-bit CPUs
+/// with the default 16-bit signals. The 4-byte signals (#Q_SIGNAL_SIZE)
+/// can be used only on 64-bit CPUs.
+///
+/// @note
+/// The inline events are supported only by the QF ports using the native
+/// QF event queues (or the lock-free queues of the POSIX port) for the
+/// active objects.
+///
+class QInlineEvt : public QEvt {
+public:
+#ifdef Q_EVT_CTOR
+    //! public constructor
+    QInlineEvt(QSignal const s = static_cast<QSignal>(0),
+               uint32_t const p = static_cast<uint32_t>(0))
+      : QEvt(s, QEvt::STATIC_EVT),
+        par(p)
+    {
+        refCtr_ = static_cast<QEvtRefCtr>(MARK_);
+    }
+#endif // Q_EVT_CTOR
+
+    uint32_t par; //!< the parameter of the event
+
+    //! marks the event @p e as an inline event
+    static void mark_(QInlineEvt * const e) {
+        e->poolId_ = static_cast<uint8_t>(0);
+        e->refCtr_ = static_cast<QEvtRefCtr>(MARK_);
+    }
+
+    //! checks whether the parameter @p p fits into a ring-buffer slot
+    static bool fits_(uint32_t const p) {
+        return static_cast<uint32_t>(
+                   (static_cast<uintptr_t>(p) << SHIFT_) >> SHIFT_) == p;
+    }
+
+    //! the ring-buffer slot for the event @p e
+    static QEvt const *toSlot_(QEvt const * const e) {
+        return ((e->poolId_ == static_cast<uint8_t>(0))
+                && (e->refCtr_ == static_cast<QEvtRefCtr>(MARK_)))
+            ? reinterpret_cast<QEvt const *>(
+                  (static_cast<uintptr_t>(
+                       static_cast<QInlineEvt const *>(e)->par) << SHIFT_)
+                  | (static_cast<uintptr_t>(e->sig) << 1)
+                  | static_cast<uintptr_t>(1))
+            : e;
+    }
+
+    //! the event in the ring-buffer slot @p s, copied to @p ie if inline
+    static QEvt const *fromSlot_(QEvt const * const s, QInlineEvt &ie) {
+        uintptr_t const bits = reinterpret_cast<uintptr_t>(s);
+        QEvt const *e = s;
+        if ((bits & static_cast<uintptr_t>(1)) != static_cast<uintptr_t>(0)) {
+            ie.sig = static_cast<QSignal>(bits >> 1);
+            ie.par = static_cast<uint32_t>(bits >> SHIFT_);
+            mark_(&ie);
+            e = &ie;
+        }
+        return e;
+    }
+
+private:
+    enum {
+        MARK_  = 0xFF, //!< reference counter of the inline events
+        SHIFT_ = (8 * Q_SIGNAL_SIZE) + 1 //!< bit position of the parameter
+    };
+
+    //! compile-time check that the signal and the mark bit leave room for
+    //! the parameter in the ring-buffer slot (the shifts by SHIFT_ in
+    //! fits_(), toSlot_() and fromSlot_() would be undefined otherwise)
+    typedef char ShiftCheck_[
+        (static_cast<unsigned>(SHIFT_) < (8U * sizeof(uintptr_t))) ? 1 : -1];
+};
+
+#endif // QF_EVT_INLINE
+
 //****************************************************************************
 //! Native QF Event Queue class
 /// @description
@@ -156,6 +257,18 @@ private:
     /// @sa QP::QF::getQueueMin().
     QEQueueCtr m_nMin;
 
+#ifdef QF_OBJ_LOCK_TYPE
+    //! per-queue lock (used instead of the global QF critical section)
+    /// @sa #QF_OBJ_LOCK_TYPE
+    QF_OBJ_LOCK_TYPE m_lock;
+#endif // QF_OBJ_LOCK_TYPE
+
+#ifdef QF_EVT_INLINE
+    //! the last inline event removed from the queue
+    /// @sa QP::QInlineEvt
+    QInlineEvt m_inlineEvt;
+#endif // QF_EVT_INLINE
+
 public:
     //! public default constructor
     QEQueue(void);
@@ -186,6 +299,17 @@ public:
     /// @sa QP::QEQueue::postLIFO(), QP::QEQueue::get()
     bool post(QEvt const * const e, uint_fast16_t const margin);
 
+    //! Posts (FIFO) a batch of events to the "raw" thread-safe QF event
+    //! queue
+    /// @description
+    /// Posts all @p n events from the array @p evts[] in a single critical
+    /// section, or none of them if the queue cannot accept all of them
+    /// with the given @p margin.
+    ///
+    /// @sa QP::QEQueue::post()
+    bool postBatch(QEvt const * const evts[], uint_fast16_t const n,
+                   uint_fast16_t const margin);
+
     //! "raw" thread-safe QF event queue implementation for the
     //! First-In-First-Out (FIFO) event posting. You can call this function
     //! from any task context or ISR context. Please note that this function
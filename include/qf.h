@@ -58,7 +58,10 @@
 
 #ifndef QF_MAX_EPOOL
     //! Default value of the macro configurable value in qf_port.h
+    //! Valid values: [1..255]; default 3
     #define QF_MAX_EPOOL         3
+#elif (QF_MAX_EPOOL > 255)
+    #error "QF_MAX_EPOOL exceeds the maximum of 255"
 #endif
 
 #ifndef QF_MAX_TICK_RATE
@@ -113,6 +116,24 @@ namespace QP {
     #error "QF_TIMEEVT_CTR_SIZE defined incorrectly, expected 1, 2, or 4"
 #endif
 
+//! type of the monotonic clock tick counters of the tick rates
+/// @description
+/// Unlike QP::QTimeEvtCtr, the tick counters do not wrap around in any
+/// practical lifetime of the system, so the absolute ticks can be used as
+/// deadlines (see QP::QTimeEvt::armAt() and QP::QF::getTickCtr()).
+typedef uint64_t QTickCtr;
+
+#ifdef QF_PS_FILTERS
+//! Pointer to the content filter of a subscription
+/// @description
+/// The filter is called by QP::QF::publish_() (outside of any critical
+/// section) with the published event @p e and the argument @p arg given
+/// to QP::QActive::subscribe(). The event is posted to the subscriber
+/// only if the filter returns 'true'. The filter must be fast and must not
+/// block, because it runs in the context of the publisher.
+typedef bool (*QEvtFilter)(QEvt const * const e, void const * const arg);
+#endif // QF_PS_FILTERS
+
 class QEQueue; // forward declaration
 
 //****************************************************************************
@@ -177,13 +198,25 @@ public: // for access from extern "C" functions
 #endif
 
     //! QF priority (1..#QF_MAX_ACTIVE) of this active object.
-    uint8_t m_prio;
+    QPrioStore m_prio;
 
 #ifdef qxk_h // QXK kernel used?
     //! QF start priority (1..#QF_MAX_ACTIVE) of this active object.
-    uint8_t m_startPrio;
+    QPrioStore m_startPrio;
 #endif
 
+#ifdef QF_DRAIN_MAX
+    //! number of events posted to this active object with the LIFO policy
+    //! since the last QActive::getBatch_()
+    /// @description
+    /// The events posted LIFO after a batch has been taken are at the front
+    /// of the queue. The thread draining the event queue in batches (see
+    /// #QF_DRAIN_MAX) dispatches them before the remaining events of the
+    /// batch. QActive::getBatch_() clears this counter and QActive::get_()
+    /// decrements it, both together with removing the events.
+    uint_fast16_t volatile m_lifoCtr;
+#endif // QF_DRAIN_MAX
+
 protected:
     //! protected constructor (abstract class)
     QActive(QStateHandler const initial);
@@ -191,13 +224,13 @@ protected:
 public:
     //! Starts execution of an active object and registers the object
     //! with the framework.
-    virtual void start(uint_fast8_t const prio,
+    virtual void start(QPrio const prio,
                        QEvt const *qSto[], uint_fast16_t const qLen,
                        void * const stkSto, uint_fast16_t const stkSize,
                        QEvt const * const ie);
 
     //! Overloaded start function (no initialization event)
-    virtual void start(uint_fast8_t const prio,
+    virtual void start(QPrio const prio,
                        QEvt const *qSto[], uint_fast16_t const qLen,
                        void * const stkSto, uint_fast16_t const stkSize)
     {
@@ -218,6 +251,35 @@ public:
     //! using the Last-In-First-Out (LIFO) policy.
     virtual void postLIFO(QEvt const * const e);
 
+#ifndef QF_NO_POST_BATCH
+#ifndef Q_SPY
+    //! Posts @p n events from the array @p evts[] directly to the event
+    //! queue of the active object (FIFO) in a single critical section.
+    //! Not available in the QF ports that define QF_NO_POST_BATCH.
+    virtual bool postBatch_(QEvt const * const evts[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin);
+#else
+    virtual bool postBatch_(QEvt const * const evts[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin,
+                            void const * const sender);
+#endif
+#endif // QF_NO_POST_BATCH
+
+#ifdef QF_EVT_INLINE
+#ifndef Q_SPY
+    //! Posts a small event with signal @p sig and parameter @p par by
+    //! value (without an event pool) to the event queue of the active
+    //! object using the FIFO policy, see QP::QInlineEvt.
+    bool postInline_(QSignal const sig, uint32_t const par,
+                     uint_fast16_t const margin);
+#else
+    bool postInline_(QSignal const sig, uint32_t const par,
+                     uint_fast16_t const margin, void const * const sender);
+#endif
+#endif // QF_EVT_INLINE
+
     //! Un-subscribes from the delivery of all signals to the active object.
     void unsubscribeAll(void) const;
 
@@ -228,9 +290,33 @@ public:
     //! Subscribes for delivery of signal @p sig to the active object
     void subscribe(enum_t const sig) const;
 
+#ifdef QF_PS_FILTERS
+    //! Subscribes for delivery of the events with signal @p sig, which
+    //! pass the content filter @p filter, to the active object
+    void subscribe(enum_t const sig, QEvtFilter const filter,
+                   void const * const arg) const;
+#endif // QF_PS_FILTERS
+
     //! Un-subscribes from the delivery of signal @p sig to the active object.
     void unsubscribe(enum_t const sig) const;
 
+#ifdef QF_PS_RANGES
+    //! Subscribes for delivery of all signals in the range @p lo..@p hi
+    //! to the active object.
+    void subscribeRange(enum_t const lo, enum_t const hi) const;
+
+    //! Un-subscribes from the delivery of the signals in the range
+    //! @p lo..@p hi subscribed with QP::QActive::subscribeRange().
+    void unsubscribeRange(enum_t const lo, enum_t const hi) const;
+#endif // QF_PS_RANGES
+
+#ifdef QF_PS_REVERSE
+    //! Copies up to @p n signals subscribed by the active object
+    //! to @p sigs[] and returns the number of the subscribed signals.
+    uint_fast16_t getSubscriptions(enum_t sigs[],
+                                   uint_fast16_t const n) const;
+#endif // QF_PS_REVERSE
+
     //! Defer an event to a given separate event queue.
     bool defer(QEQueue * const eq, QEvt const * const e) const;
 
@@ -241,13 +327,13 @@ public:
     uint_fast16_t flushDeferred(QEQueue * const eq) const;
 
     //! Get the priority of the active object.
-    uint_fast8_t getPrio(void) const {
-        return static_cast<uint_fast8_t>(m_prio);
+    QPrio getPrio(void) const {
+        return static_cast<QPrio>(m_prio);
     }
 
     //! Set the priority of the active object.
-    void setPrio(uint_fast8_t const prio) {
-        m_prio = static_cast<uint8_t>(prio);
+    void setPrio(QPrio const prio) {
+        m_prio = static_cast<QPrioStore>(prio);
     }
 
     //! Generic setting of additional attributes (useful in QP ports)
@@ -268,6 +354,12 @@ public:
     //! Get an event from the event queue of an active object.
     QEvt const *get_(void);
 
+#ifdef QF_DRAIN_MAX
+    //! Get up to @p n events from the event queue of an active object
+    //! at once, see #QF_DRAIN_MAX.
+    uint_fast16_t getBatch_(QEvt const *evts[], uint_fast16_t const n);
+#endif // QF_DRAIN_MAX
+
 // duplicated API to be used exclusively inside ISRs (useful in some QP ports)
 #ifdef QF_ISR_API
 #ifdef Q_SPY
@@ -418,6 +510,33 @@ private:
     /// keeps timing out periodically.
     QTimeEvtCtr m_interval;
 
+#ifdef QF_TIMEEVT_WHEEL
+    //! link to the pointer to this time event in the list of the slot
+    //! of the timing wheel (the previous m_next or the slot itself).
+    /// @description
+    /// With the timing wheels (see #QF_TIMEEVT_WHEEL) the armed time
+    /// events are kept in the doubly-linked lists of the wheel slots, so
+    /// that they can be removed in constant time when disarmed or rearmed.
+    QTimeEvt * volatile *m_pprev;
+
+    //! the value of the tick counter at which the time event expires.
+    /// @description
+    /// With the timing wheels the m_ctr attribute is not decremented in
+    /// every TICK_X(), but holds the number of ticks of the last arming,
+    /// so that it is not zero as long as the time event is armed.
+    QTimeEvtCtr m_expire;
+#endif // QF_TIMEEVT_WHEEL
+
+#ifdef QF_TIMEEVT_SLACK
+    //! the number of ticks, by which the expiration may be delayed.
+    /// @description
+    /// With #QF_TIMEEVT_SLACK the expiration of the time event is aligned
+    /// to the boundary of the largest power of two not exceeding
+    /// (m_slack + 1) ticks, so that the time events of similar timeouts
+    /// expire together (see QP::QTimeEvt::setSlack()).
+    QTimeEvtCtr m_slack;
+#endif // QF_TIMEEVT_SLACK
+
 public:
 
     //! The Time Event constructor.
@@ -428,6 +547,19 @@ public:
     void armX(QTimeEvtCtr const nTicks,
               QTimeEvtCtr const interval = static_cast<QTimeEvtCtr>(0));
 
+    //! Arm a time event (one shot or periodic) to expire at the given
+    //! absolute tick of its tick rate.
+    void armAt(QTickCtr const absTick,
+               QTimeEvtCtr const interval = static_cast<QTimeEvtCtr>(0));
+
+#ifdef QF_TIMEEVT_SLACK
+    //! Set the number of clock ticks, by which the subsequent expirations
+    //! of the time event may be delayed to coincide with other ones.
+    void setSlack(QTimeEvtCtr const slack) {
+        m_slack = slack;
+    }
+#endif // QF_TIMEEVT_SLACK
+
     //! Disarm a time event.
     bool disarm(void);
 
@@ -452,6 +584,13 @@ public:
         m_act(static_cast<void *>(0)),
         m_ctr(static_cast<QTimeEvtCtr>(0)),
         m_interval(static_cast<QTimeEvtCtr >(0))
+#ifdef QF_TIMEEVT_WHEEL
+        , m_pprev(static_cast<QTimeEvt * volatile *>(0)),
+        m_expire(static_cast<QTimeEvtCtr>(0))
+#endif // QF_TIMEEVT_WHEEL
+#ifdef QF_TIMEEVT_SLACK
+        , m_slack(static_cast<QTimeEvtCtr>(0))
+#endif // QF_TIMEEVT_SLACK
     {
 #ifndef Q_EVT_CTOR
         sig = static_cast<QSignal>(sgnl); // set QEvt::sig of this time event
@@ -490,6 +629,34 @@ private:
     //! encapsulate the cast the m_act attribute to QTimeEvt*
     QTimeEvt *toTimeEvt(void) { return static_cast<QTimeEvt *>(m_act); }
 
+    //! link the armed time event (inside the critical section) and
+    //! return the number of ticks, for which it was actually armed
+    QTimeEvtCtr arm_(uint_fast8_t const tickRate, QTimeEvtCtr const nTicks,
+                     QTimeEvtCtr const interval);
+
+#ifdef QF_TIMEEVT_SLACK
+    //! the number of ticks @p nTicks extended by the slack of the time
+    //! event to an aligned expiration (inside the critical section)
+    QTimeEvtCtr align_(uint_fast8_t const tickRate,
+                       QTimeEvtCtr const nTicks) const;
+#endif // QF_TIMEEVT_SLACK
+
+#ifdef QF_TICKLESS
+    //! the number of ticks @p nTicks extended by the lag of the tick
+    //! counter behind the current tick @p now (inside the critical section)
+    static QTimeEvtCtr lag_(uint_fast8_t const tickRate,
+                            QTimeEvtCtr const nTicks, QTickCtr const now);
+#endif // QF_TICKLESS
+
+#ifdef QF_TIMEEVT_WHEEL
+    //! insert the time event into the slot of the timing wheel of
+    //! @p tickRate, which corresponds to the m_expire tick.
+    void wheelInsert_(uint_fast8_t const tickRate);
+
+    //! remove the time event from the slot of the timing wheel
+    void wheelRemove_(uint_fast8_t const tickRate);
+#endif // QF_TIMEEVT_WHEEL
+
     friend class QF;
     friend class QS;
 #ifdef qxk_h
@@ -500,6 +667,9 @@ private:
 
 
 //****************************************************************************
+#if !defined(QF_SUBSCR_DENSE) && !defined(QF_PS_SPARSE) \
+    && !defined(QF_PS_BROADCAST)
+
 //! Subscriber List
 /// @description
 /// This data type represents a set of active objects that subscribe to
@@ -507,6 +677,206 @@ private:
 /// bit corresponds to the unique priority of an active object.
 typedef QPSet QSubscrList;
 
+#else // dense subscriber arrays, sparse signals and/or broadcast channels
+
+class QBroadcast; // forward declaration
+
+//! Subscriber List with the dense array of subscribers and/or the signal
+/// @description
+/// With #QF_SUBSCR_DENSE the subscriber list keeps, besides the
+/// priority-set of the subscribers, also the array of their priorities
+/// sorted from the highest to the lowest. The array is maintained by
+/// QP::QActive::subscribe() and QP::QActive::unsubscribe(), so that
+/// QP::QF::publish_() can simply iterate over it (see NOTE1 in qf_ps.cpp).
+///
+/// With #QF_PS_SPARSE the subscriber lists form a hash table keyed by
+/// the signal, which is stored in every subscriber list (see NOTE2 in
+/// qf_ps.cpp).
+///
+/// With #QF_PS_BROADCAST the subscriber list of a signal can refer to
+/// the broadcast channel of the signal (see NOTE5 in qf_ps.cpp).
+class QSubscrList {
+public:
+#ifdef QF_PS_SPARSE
+    QSignal m_sig;      //!< the signal of the list (0 for a free list)
+#endif
+#ifdef QF_PS_BROADCAST
+    QBroadcast *m_bcast; //!< the broadcast channel of the signal or NULL
+#endif
+    QPSet m_set;        //!< priority-set of the subscribers
+#ifdef QF_SUBSCR_DENSE
+    QPrioStore m_nSubscr; //!< number of the subscribers
+    QPrioStore m_prio[QF_MAX_ACTIVE]; //!< subscriber priorities, descending
+#endif
+
+    //! the function evaluates to TRUE if the list has the subscriber @p p
+    bool hasElement(QPrio const p) const {
+        return m_set.hasElement(p);
+    }
+
+#ifdef QF_SUBSCR_DENSE
+    //! Evaluates to true if the list has any subscribers
+    bool notEmpty(void) const {
+        return (m_nSubscr != static_cast<QPrioStore>(0));
+    }
+
+    //! insert the subscriber of priority @p p into the list
+    void insert(QPrio const p);
+
+    //! remove the subscriber of priority @p p from the list
+    void remove(QPrio const p);
+#else
+    //! Evaluates to true if the list has any subscribers
+    bool notEmpty(void) const {
+        return m_set.notEmpty();
+    }
+
+    //! insert the subscriber of priority @p p into the list
+    void insert(QPrio const p) {
+        m_set.insert(p);
+    }
+
+    //! remove the subscriber of priority @p p from the list
+    void remove(QPrio const p) {
+        m_set.remove(p);
+    }
+#endif // QF_SUBSCR_DENSE
+};
+
+#endif // QF_SUBSCR_DENSE || QF_PS_SPARSE || QF_PS_BROADCAST
+
+#ifdef QF_PS_BROADCAST
+//****************************************************************************
+//! Broadcast channel of a published signal
+/// @description
+/// QP::QBroadcast is a ring buffer, into which QP::QF::publish_() writes
+/// the events of a single signal only once, no matter how many active
+/// objects subscribe to the signal. Every subscriber reads the ring with
+/// its own cursor. Instead of the event itself, the subscriber gets only
+/// a "doorbell" (the channel object, which is a static event) and only
+/// if it has no doorbell of the channel pending already. QP::QActive::get_()
+/// replaces the doorbell with the next event from the ring, so the state
+/// machines of the subscribers see no difference (see NOTE5 in qf_ps.cpp).
+///
+/// @note
+/// The channel is attached to the signal with QP::QF::psBroadcast().
+///
+class QBroadcast : public QEvt {
+public:
+    //! public default constructor
+    QBroadcast(void);
+
+private:
+    //! Internal QF implementation of replacing the doorbell of the channel
+    //! with the next event for the active object @p act.
+    QEvt const *take_(QActive * const act);
+
+    //! Internal QF implementation of writing the event into the ring.
+    bool write_(QEvt const * const e, QPSet * const bells,
+                QEvt const ** const old);
+
+    QEvt const **m_ring;    //!< the ring buffer of the published events
+    uint32_t m_mask;        //!< the length of the ring buffer minus one
+    uint32_t m_head;        //!< the sequence number of the next event
+    uint32_t m_tail;        //!< no subscriber lags behind this number
+    QSubscrList const *m_list; //!< the subscribers of the signal
+
+    //! the sequence numbers of the next event of the subscribers
+    uint32_t m_cursor[QF_MAX_ACTIVE + 1];
+
+    QPSet m_rung;           //!< the subscribers with a pending doorbell
+
+    friend class QF;
+    friend class QActive;
+};
+#endif // QF_PS_BROADCAST
+
+
+//****************************************************************************
+//! Reference-counted buffer for large event payloads
+/// @description
+/// QP::QBuf is a dynamically allocated block of memory, which holds a large
+/// payload (e.g., a sensor frame or a network packet) outside of the events
+/// that carry it. The buffers are allocated from the QF event pools with
+/// the macros Q_NEW_BUF() and Q_NEW_BUF_X(), so they can be kept in event
+/// pools of their own by the block size. The reference counter of a buffer
+/// counts the events (see QP::QBufEvt) that carry the buffer, and the buffer
+/// is recycled when the last of these events is recycled.
+///
+/// @note
+/// A buffer that has not been attached to any event must be recycled
+/// explicitly with QP::QF::gc().
+///
+class QBuf : public QEvt {
+public:
+    //! the size of the payload in bytes
+    uint_fast16_t getSize(void) const {
+        return static_cast<uint_fast16_t>(m_size);
+    }
+
+    //! pointer to the payload
+    void *getData(void) {
+        return &m_data[0];
+    }
+
+    //! pointer to the payload (const version)
+    void const *getData(void) const {
+        return &m_data[0];
+    }
+
+private:
+    uint16_t m_size;  //!< the size of the payload in bytes
+    void *m_data[1];  //!< the payload (extends beyond the QBuf object)
+
+    friend class QF;
+};
+
+//****************************************************************************
+//! Event carrying a reference-counted buffer
+/// @description
+/// QP::QBufEvt is the base class for events that carry a large payload in
+/// a QP::QBuf instead of embedding it. Such events are allocated from an
+/// event pool dedicated to the event type (see QP::QEvtPool), which lets
+/// QP::QF::gc() release the attached buffer when the event is recycled.
+/// Because all the holders of a dynamic event share the same instance, the
+/// buffer reaches all subscribers of a published event, or all recipients
+/// of an event reference (see Q_NEW_REF()), without copying, and is
+/// recycled exactly once.
+///
+/// @usage
+/// @code
+/// struct FrameEvt : public QP::QBufEvt {
+///     uint8_t camera;
+/// };
+/// static QP::QEvtPool<FrameEvt, 10> l_frameEvtPool; // dedicated pool
+/// . . .
+/// QP::QBuf *buf = Q_NEW_BUF(640U*4U); // from a pool for large blocks
+/// fill(buf->getData(), buf->getSize());
+/// FrameEvt *fe = Q_NEW(FrameEvt, FRAME_SIG);
+/// Q_BUF_ATTACH(fe, buf); // the event now holds the buffer
+/// QP::QF::PUBLISH(fe, me);
+/// @endcode
+///
+#ifdef Q_EVT_CTOR
+class QBufEvt : public QEvt {
+public:
+    //! public constructor (dynamic event)
+    QBufEvt(QSignal const s)
+      : QEvt(s),
+        buf(static_cast<QBuf const *>(0))
+    {}
+#else
+struct QBufEvt : public QEvt {
+#endif // Q_EVT_CTOR
+    QBuf const *buf; //!< the attached buffer or NULL
+
+    //! helper to detect the event types derived from QP::QBufEvt
+    static bool isBufEvt_(QBufEvt const * const /*e*/) { return true; }
+
+    //! helper to detect the event types not derived from QP::QBufEvt
+    static bool isBufEvt_(void const * const /*e*/) { return false; }
+};
+
 
 //****************************************************************************
 //! QF services.
@@ -528,6 +898,20 @@ public:
     static void psInit(QSubscrList * const subscrSto,
                        enum_t const maxSignal);
 
+#ifdef QF_PS_BROADCAST
+    //! Attaches the broadcast channel to the published signal.
+    static void psBroadcast(enum_t const sig, QBroadcast * const bc,
+                            QEvt const *ringSto[],
+                            uint_fast16_t const ringLen);
+#endif // QF_PS_BROADCAST
+
+#ifdef QF_PRIO_BANDS
+    //! Initializes a band of priorities, whose active objects share
+    //! a single scheduling level and are serviced round-robin.
+    static void bandInit(QPrio const lo, QPrio const hi,
+                         uint_fast16_t const quantum);
+#endif // QF_PRIO_BANDS
+
     //! Event pool initialization for dynamic allocation of events.
     static void poolInit(void * const poolSto, uint_fast32_t const poolSize,
                          uint_fast16_t const evtSize);
@@ -535,6 +919,13 @@ public:
     //! Obtain the block size of any registered event pools
     static uint_fast16_t poolGetMaxBlockSize(void);
 
+    //! Internal QF implementation of the initialization of an event pool
+    //! dedicated to a single event type (see QP::QEvtPool).
+    static uint_fast8_t typedPoolInit_(void * const poolSto,
+                                       uint_fast32_t const poolSize,
+                                       uint_fast16_t const evtSize,
+                                       bool const bufEvt);
+
 
     //! Transfers control to QF to run the application.
     static int_t run(void);
@@ -565,21 +956,48 @@ public:
     //! any time event is active.
     static bool noTimeEvtsActiveX(uint_fast8_t const tickRate);
 
+#ifdef QF_TICKLESS
+    //! Returns the number of ticks until the next clock tick, in which
+    //! any time events of the given tick rate need processing.
+    static QTimeEvtCtr ticksToNextX(uint_fast8_t const tickRate);
+
+    //! Advances the time events of the given tick rate over the clock
+    //! ticks, in which no time events need processing (QF ports only).
+    static QTimeEvtCtr skipTicksX_(uint_fast8_t const tickRate,
+                                   QTimeEvtCtr const nTicks);
+#endif // QF_TICKLESS
+
     //! This function returns the minimum of free entries of the given
     //! event pool.
     static uint_fast16_t getPoolMin(uint_fast8_t const poolId);
 
     //! This function returns the minimum of free entries of the given
     //! event queue.
-    static uint_fast16_t getQueueMin(uint_fast8_t const prio);
+    static uint_fast16_t getQueueMin(QPrio const prio);
+
+    //! This function returns the number of clock ticks processed at the
+    //! given tick rate since the start of the application.
+    static QTickCtr getTickCtr(uint_fast8_t const tickRate);
 
     //! Internal QF implementation of creating new dynamic event.
     static QEvt *newX_(uint_fast16_t const evtSize,
                        uint_fast16_t const margin, enum_t const sig);
 
+    //! Internal QF implementation of creating new dynamic event from
+    //! the event pool dedicated to the event type (see QP::QEvtPool).
+    static QEvt *newTypedX_(uint_fast8_t const poolId,
+                            uint_fast16_t const evtSize,
+                            uint_fast16_t const margin, enum_t const sig);
+
     //! Recycle a dynamic event.
     static void gc(QEvt const *e);
 
+#ifdef QF_DRAIN_MAX
+    //! Recycle @p n events dispatched by an active object at once,
+    //! see #QF_DRAIN_MAX.
+    static void gcBatch_(QEvt const * const evts[], uint_fast16_t const n);
+#endif // QF_DRAIN_MAX
+
     //! Internal QF implementation of creating new event reference.
     static QEvt const *newRef_(QEvt const * const e,
                                QEvt const * const evtRef);
@@ -587,6 +1005,13 @@ public:
     //! Internal QF implementation of deleting event reference.
     static void deleteRef_(QEvt const * const evtRef);
 
+    //! Internal QF implementation of creating new reference-counted buffer.
+    static QBuf *newBuf_(uint_fast16_t const size,
+                         uint_fast16_t const margin);
+
+    //! Internal QF implementation of attaching a buffer to an event.
+    static void attachBuf_(QBufEvt * const e, QBuf const * const buf);
+
     //! Remove the active object from the framework.
     static void remove_(QActive * const a);
 
@@ -599,6 +1024,18 @@ public:
     //! Register an active object to be managed by the framework
     static void add_(QActive * const a);
 
+#ifdef QF_PRIO_BANDS
+    //! The highest priority of the band of the priority @p p (QF ports)
+    static QPrio bandTop_(QPrio const p);
+
+    //! The event quantum of the band of the priority @p p (QF ports)
+    static uint_fast16_t bandQuantum_(QPrio const p);
+
+    //! Selects the next active object to run in the band of the
+    //! ready priority @p p (QF schedulers)
+    static QPrio bandNext_(QPrio const p, QPSet const &ready);
+#endif // QF_PRIO_BANDS
+
     //! Clear a specified region of memory to zero.
     static void bzero(void * const start, uint_fast16_t len);
 
@@ -625,6 +1062,15 @@ private:
     //! heads of linked lists of time events, one for every clock tick rate
     static QTimeEvt timeEvtHead_[QF_MAX_TICK_RATE];
 
+    //! monotonic clock tick counters, one for every clock tick rate
+    static QTickCtr tickCtr_[QF_MAX_TICK_RATE];
+
+#ifdef QF_TICKLESS
+    //! the number of ticks until the next tick with any work, which must
+    //! be called inside the critical section of the tick rate
+    static QTimeEvtCtr nextTick_(uint_fast8_t const tickRate);
+#endif // QF_TICKLESS
+
     friend class QActive;
     friend class QTimeEvt;
     friend class QS;
@@ -638,6 +1084,74 @@ private:
 uint_fast16_t const QF_NO_MARGIN = static_cast<uint_fast16_t>(0xFFFF);
 
 
+//****************************************************************************
+//! Event pool ID of the event pool dedicated to the event type @p evtT_
+/// @description
+/// The pool ID is assigned by QP::QEvtPool::init() and remains zero for
+/// the event types without a dedicated event pool, which are allocated from
+/// the event pools shared by all event types.
+///
+/// @tparam evtT_ event type (class name)
+///
+template<class evtT_>
+class QEvtPoolId {
+public:
+    static uint_fast8_t id; //!< the event pool ID or 0 if not dedicated
+};
+
+template<class evtT_>
+uint_fast8_t QEvtPoolId<evtT_>::id = static_cast<uint_fast8_t>(0);
+
+//****************************************************************************
+//! Event pool dedicated to a single event type
+/// @description
+/// QP::QEvtPool provides the storage for @p N_ events of type @p evtT_ and
+/// registers it with QF as an event pool with the block size of exactly
+/// sizeof(@p evtT_) (rounded up to the size of a pointer). Once the pool is
+/// initialized, the Q_NEW() and Q_NEW_X() macros for the event type
+/// @p evtT_ allocate from this pool directly by its event pool ID, without
+/// searching the event pools shared by all event types.
+///
+/// @tparam evtT_ event type (class name) allocated from the pool
+/// @tparam N_    number of events in the pool
+///
+/// @note
+/// Every dedicated event pool takes one of the #QF_MAX_EPOOL event pools.
+/// The dedicated pools can be initialized in any order relative to each
+/// other and to the shared event pools initialized with QP::QF::poolInit().
+///
+/// @usage
+/// @code
+/// static QP::QEvtPool<TableEvt, 20> l_tableEvtPool; // dedicated pool
+/// . . .
+/// QP::QF::init();
+/// l_tableEvtPool.init(); // register the pool with QF
+/// . . .
+/// TableEvt *te = Q_NEW(TableEvt, HUNGRY_SIG); // from l_tableEvtPool
+/// @endcode
+///
+template<class evtT_, uint_fast16_t N_>
+class QEvtPool {
+public:
+    //! Initializes the dedicated event pool and registers it with QF.
+    void init(void) {
+        QEvtPoolId<evtT_>::id = QF::typedPoolInit_(&m_sto[0],
+            static_cast<uint_fast32_t>(sizeof(m_sto)),
+            static_cast<uint_fast16_t>(sizeof(evtT_)),
+            QBufEvt::isBufEvt_(static_cast<evtT_ const *>(0)));
+    }
+
+    //! Obtain the event pool ID, e.g., for QP::QF::getPoolMin().
+    static uint_fast8_t getId(void) {
+        return QEvtPoolId<evtT_>::id;
+    }
+
+private:
+    //! storage for N_ events of type evtT_ aligned at pointers
+    void *m_sto[N_ * (((sizeof(evtT_) - 1U) / sizeof(void *)) + 1U)];
+};
+
+
 //****************************************************************************
 //! Ticker Active Object class
 /// @description
@@ -662,6 +1176,18 @@ public:
                        void const * const sender);
 #endif
     virtual void postLIFO(QEvt const * const e);
+#ifndef QF_NO_POST_BATCH
+#ifndef Q_SPY
+    virtual bool postBatch_(QEvt const * const evts[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin);
+#else
+    virtual bool postBatch_(QEvt const * const evts[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin,
+                            void const * const sender);
+#endif
+#endif // QF_NO_POST_BATCH
 };
 
 } // namespace QP
@@ -685,13 +1211,16 @@ public:
 #ifdef Q_EVT_CTOR
 
     #define Q_NEW(evtT_, sig_, ...) \
-        (new(QP::QF::newX_(static_cast<uint_fast16_t>(sizeof(evtT_)), \
+        (new(QP::QF::newTypedX_(QP::QEvtPoolId<evtT_>::id, \
+                     static_cast<uint_fast16_t>(sizeof(evtT_)), \
                      QP::QF_NO_MARGIN, static_cast<enum_t>(0))) \
             evtT_((sig_),  ##__VA_ARGS__))
 
     #define Q_NEW_X(e_, evtT_, margin_, sig_, ...) do { \
-        (e_) = static_cast<evtT_ *>(QP::QF::newX_(static_cast<uint_fast16_t>(\
-                  sizeof(evtT_)), (margin_), static_cast<enum_t>(0))); \
+        (e_) = static_cast<evtT_ *>(QP::QF::newTypedX_( \
+                  QP::QEvtPoolId<evtT_>::id, \
+                  static_cast<uint_fast16_t>(sizeof(evtT_)), \
+                  (margin_), static_cast<enum_t>(0))); \
         if ((e_) != static_cast<evtT_ *>(0)) { \
             new((e_)) evtT_((sig_),  ##__VA_ARGS__); \
         } \
@@ -701,9 +1230,11 @@ public:
 
     //! Allocate a dynamic event.
     /// @description
-    /// The macro calls the internal QF function QP::QF::newX_() with
+    /// The macro calls the internal QF function QP::QF::newTypedX_() with
     /// margin == QP::QF_NO_MARGIN, which causes an assertion when the event
-    /// cannot be successfully allocated.
+    /// cannot be successfully allocated. The event is allocated from the
+    /// event pool dedicated to the type @p evtT_ (see QP::QEvtPool), if
+    /// any, or otherwise from the event pools shared by all event types.
     ///
     /// @param[in] evtT_ event type (class name) of the event to allocate
     /// @param[in] sig_  signal to assign to the newly allocated event
@@ -720,7 +1251,8 @@ public:
     /// The following example illustrates dynamic allocation of an event:
     /// @include qf_post.cpp
     #define Q_NEW(evtT_, sig_) \
-        (static_cast<evtT_ *>(QP::QF::newX_( \
+        (static_cast<evtT_ *>(QP::QF::newTypedX_( \
+                QP::QEvtPoolId<evtT_>::id, \
                 static_cast<uint_fast16_t>(sizeof(evtT_)), \
                 QP::QF_NO_MARGIN, (sig_))))
 
@@ -749,8 +1281,9 @@ public:
     /// The following example illustrates dynamic allocation of an event:
     /// @include qf_postx.cpp
     #define Q_NEW_X(e_, evtT_, margin_, sig_)  ((e_) = static_cast<evtT_ *>(\
-        QP::QF::newX_(static_cast<uint_fast16_t>(sizeof(evtT_)),\
-                      (margin_), (sig_))))
+        QP::QF::newTypedX_(QP::QEvtPoolId<evtT_>::id, \
+                           static_cast<uint_fast16_t>(sizeof(evtT_)),\
+                           (margin_), (sig_))))
 #endif
 
 //! Create a new reference of the current event `e` */
@@ -794,6 +1327,47 @@ public:
     (evtRef_) = 0; \
 } while (false)
 
+//! Allocate a reference-counted buffer for a large event payload
+/// @description
+/// The macro calls the internal QF function QP::QF::newBuf_() with
+/// margin == QP::QF_NO_MARGIN, which causes an assertion when the buffer
+/// cannot be successfully allocated.
+///
+/// @param[in] size_  the size of the payload in bytes
+///
+/// @returns a valid pointer to the allocated QP::QBuf.
+///
+/// @sa QP::QBufEvt
+///
+#define Q_NEW_BUF(size_) \
+    (QP::QF::newBuf_(static_cast<uint_fast16_t>(size_), QP::QF_NO_MARGIN))
+
+//! Allocate a reference-counted buffer (non-asserting version)
+/// @description
+/// This macro allocates a new buffer and sets the pointer @p buf_, while
+/// leaving at least @p margin_ of blocks still available in the pool
+///
+/// @param[out] buf_    pointer to the allocated QP::QBuf or NULL
+/// @param[in]  size_   the size of the payload in bytes
+/// @param[in]  margin_ number of blocks that must remain available
+///                     in the given pool after this allocation.
+///
+#define Q_NEW_BUF_X(buf_, size_, margin_) ((buf_) = \
+    QP::QF::newBuf_(static_cast<uint_fast16_t>(size_), (margin_)))
+
+//! Attach a reference-counted buffer to an event
+/// @description
+/// The macro adds a reference to the buffer @p buf_ and stores it in the
+/// event @p e_, which must be a dynamic event derived from QP::QBufEvt and
+/// allocated from an event pool dedicated to its type (QP::QEvtPool). The
+/// buffer is released automatically when the event is recycled.
+///
+/// @param[in,out] e_    pointer to the event carrying the buffer
+/// @param[in]     buf_  pointer to the buffer to attach
+///
+#define Q_BUF_ATTACH(e_, buf_) \
+    (QP::QF::attachBuf_((e_), (buf_)))
+
 
 //****************************************************************************
 // QS software tracing integration, only if enabled
@@ -905,11 +1479,85 @@ public:
     #define POST_X(e_, margin_, sender_) \
         post_((e_), (margin_), (sender_))
 
+    //! Invoke the direct posting of a batch of events
+    //! QP::QActive::postBatch_().
+    /// @description
+    /// This macro asserts if the queue cannot accept all the events.
+    ///
+    /// @param[in] evts_   array of pointers to the events to post
+    /// @param[in] n_      number of the events in the array
+    /// @param[in] sender_ pointer to the sender object.
+    ///
+    /// @sa POST()
+    #define POST_BATCH(evts_, n_, sender_) \
+        postBatch_((evts_), static_cast<uint_fast16_t>(n_), \
+                   QP::QF_NO_MARGIN, (sender_))
+
+    //! Invoke the direct posting of a batch of events
+    //! QP::QActive::postBatch_() without delivery guarantee.
+    /// @description
+    /// This macro does not assert if the queue cannot accept all the
+    /// events with the specified margin of free slots remaining. In that
+    /// case none of the events is posted.
+    ///
+    /// @param[in] evts_   array of pointers to the events to post
+    /// @param[in] n_      number of the events in the array
+    /// @param[in] margin_ the minimum free slots in the queue, which
+    ///                    must still be available after posting the events.
+    /// @param[in] sender_ pointer to the sender object.
+    ///
+    /// @sa POST_X()
+    #define POST_BATCH_X(evts_, n_, margin_, sender_) \
+        postBatch_((evts_), static_cast<uint_fast16_t>(n_), \
+                   (margin_), (sender_))
+
+    //! Invoke the direct posting of a small event by value
+    //! QP::QActive::postInline_().
+    /// @description
+    /// This macro asserts if the queue overflows and cannot accept the event.
+    ///
+    /// @param[in] sig_    signal of the event to post
+    /// @param[in] par_    parameter of the event to post
+    /// @param[in] sender_ pointer to the sender object.
+    ///
+    /// @sa QP::QInlineEvt, POST()
+    #define POST_INLINE(sig_, par_, sender_) \
+        postInline_(static_cast<QP::QSignal>(sig_), \
+                    static_cast<uint32_t>(par_), QP::QF_NO_MARGIN, (sender_))
+
+    //! Invoke the direct posting of a small event by value
+    //! QP::QActive::postInline_() without delivery guarantee.
+    /// @description
+    /// This macro does not assert if the queue overflows and cannot accept
+    /// the event with the specified margin of free slots remaining.
+    ///
+    /// @param[in] sig_    signal of the event to post
+    /// @param[in] par_    parameter of the event to post
+    /// @param[in] margin_ the minimum free slots in the queue, which
+    ///                    must still be available after posting the event.
+    /// @param[in] sender_ pointer to the sender object.
+    ///
+    /// @sa QP::QInlineEvt, POST_X()
+    #define POST_INLINE_X(sig_, par_, margin_, sender_) \
+        postInline_(static_cast<QP::QSignal>(sig_), \
+                    static_cast<uint32_t>(par_), (margin_), (sender_))
+
 #else
 
     #define PUBLISH(e_, dummy_)  publish_((e_))
     #define POST(e_, dummy_)     post_((e_), QP::QF_NO_MARGIN)
     #define POST_X(e_, margin_, dummy_) post_((e_), (margin_))
+    #define POST_BATCH(evts_, n_, dummy_) \
+        postBatch_((evts_), static_cast<uint_fast16_t>(n_), \
+                   QP::QF_NO_MARGIN)
+    #define POST_BATCH_X(evts_, n_, margin_, dummy_) \
+        postBatch_((evts_), static_cast<uint_fast16_t>(n_), (margin_))
+    #define POST_INLINE(sig_, par_, dummy_) \
+        postInline_(static_cast<QP::QSignal>(sig_), \
+                    static_cast<uint32_t>(par_), QP::QF_NO_MARGIN)
+    #define POST_INLINE_X(sig_, par_, margin_, dummy_) \
+        postInline_(static_cast<QP::QSignal>(sig_), \
+                    static_cast<uint32_t>(par_), (margin_))
     #define TICK_X(tickRate_, dummy_)   tickX_((tickRate_))
 
 #endif // Q_SPY
@@ -70,19 +70,19 @@ namespace QP {
 extern "C" {
 
 struct QK_Attr {
-    uint8_t volatile actPrio;    //!< prio of the active AO
-    uint8_t volatile nextPrio;   //!< prio of the next AO to execute
-    uint8_t volatile lockPrio;   //!< lock prio (0 == no-lock)
-    uint8_t volatile lockHolder; //!< prio of the lock holder
-    uint8_t volatile intNest;    //!< ISR nesting level
-    QP::QPSet readySet;          //!< QK ready-set of AOs and "naked" threads
+    QP::QPrioStore volatile actPrio;    //!< prio of the active AO
+    QP::QPrioStore volatile nextPrio;   //!< prio of the next AO to execute
+    QP::QPrioStore volatile lockPrio;   //!< lock prio (0 == no-lock)
+    QP::QPrioStore volatile lockHolder; //!< prio of the lock holder
+    uint8_t volatile intNest;           //!< ISR nesting level
+    QP::QPSet readySet; //!< QK ready-set of AOs and "naked" threads
 };
 
 //! global attributes of the QK kernel
 extern QK_Attr QK_attr_;
 
 //! QK scheduler finds the highest-priority thread ready to run
-uint_fast8_t QK_sched_(void);
+QP::QPrio QK_sched_(void);
 
 //! QK activator activates the next active object. The activated AO preempts
 // the currently executing AOs.
@@ -121,7 +121,14 @@ void QK_activate_(void);
 namespace QP {
 
 //! The scheduler lock status
+/// @description
+/// The status packs the previous lock priority and the previous lock
+/// holder, each of them #QK_PRIO_BITS_ wide.
+#if (QF_MAX_ACTIVE <= 64)
 typedef uint_fast16_t QSchedStatus;
+#else
+typedef uint32_t QSchedStatus;
+#endif
 
 //****************************************************************************
 //! QK services.
@@ -138,7 +145,7 @@ class QK {
 public:
     // QK scheduler locking...
     //! QK selective scheduler lock
-    static QSchedStatus schedLock(uint_fast8_t const ceiling);
+    static QSchedStatus schedLock(QPrio const ceiling);
 
     //! QK selective scheduler unlock
     static void schedUnlock(QSchedStatus const stat);
@@ -179,6 +186,15 @@ public:
             (QK_attr_.intNest != static_cast<uint8_t>(0))
     #endif // QK_ISR_CONTEXT_
 
+    //! Internal macro for the number of bits of a single priority
+    // packed in the scheduler lock status
+    #define QK_PRIO_BITS_ (sizeof(QPrioStore) * 8U)
+
+    //! Internal macro for the scheduler lock status of a lock, which
+    // has not been taken (all ones in the lock holder bits)
+    #define QK_NO_LOCK_ \
+        (static_cast<QSchedStatus>(static_cast<QPrioStore>(~0U)))
+
     // QK-specific scheduler locking
     //! Internal macro to represent the scheduler lock status
     // that needs to be preserved to allow nesting of locks.
@@ -188,7 +204,7 @@ public:
     //! Internal macro for selective scheduler locking.
     #define QF_SCHED_LOCK_(prio_) do { \
         if (QK_ISR_CONTEXT_()) { \
-            lockStat_ = static_cast<QSchedStatus>(0xFF); \
+            lockStat_ = QK_NO_LOCK_; \
         } else { \
             lockStat_ = QK::schedLock((prio_)); \
         } \
@@ -196,7 +212,7 @@ public:
 
     //! Internal macro for selective scheduler unlocking.
     #define QF_SCHED_UNLOCK_() do { \
-        if (lockStat_ != static_cast<QSchedStatus>(0xFF)) { \
+        if (lockStat_ != QK_NO_LOCK_) { \
             QK::schedUnlock(lockStat_); \
         } \
     } while (false)
@@ -206,9 +222,9 @@ public:
         Q_ASSERT_ID(110, (me_)->m_eQueue.m_frontEvt != static_cast<QEvt *>(0))
 
     #define QACTIVE_EQUEUE_SIGNAL_(me_) do { \
-        QK_attr_.readySet.insert(static_cast<uint_fast8_t>((me_)->m_prio)); \
+        QK_attr_.readySet.insert(static_cast<QPrio>((me_)->m_prio)); \
         if (!QK_ISR_CONTEXT_()) { \
-            if (QK_sched_() != static_cast<uint_fast8_t>(0)) { \
+            if (QK_sched_() != static_cast<QPrio>(0)) { \
                 QK_activate_(); \
             } \
         } \
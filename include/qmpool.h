@@ -132,6 +132,12 @@ private:
     /// @sa QP::QF::getPoolMin().
     QMPoolCtr m_nMin;
 
+#ifdef QF_OBJ_LOCK_TYPE
+    //! per-pool lock (used instead of the global QF critical section)
+    /// @sa #QF_OBJ_LOCK_TYPE
+    QF_OBJ_LOCK_TYPE m_lock;
+#endif // QF_OBJ_LOCK_TYPE
+
 public:
     QMPool(void); //!< public default constructor
 
@@ -150,6 +156,14 @@ public:
         return m_blockSize;
     }
 
+#if (defined QF_MAGAZINE_SIZE) || (defined QF_DRAIN_MAX)
+    //! Obtains up to @p n memory blocks at once (no margin).
+    uint_fast16_t getMany(void *blk[], uint_fast16_t const n);
+
+    //! Returns @p n memory blocks back to the pool at once.
+    void putMany(void * const blk[], uint_fast16_t const n);
+#endif // QF_MAGAZINE_SIZE || QF_DRAIN_MAX
+
 // duplicated API to be used exclusively inside ISRs (useful in some QP ports)
 #ifdef QF_ISR_API
     void *getFromISR(uint_fast16_t const margin);
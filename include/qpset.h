@@ -1,5 +1,6 @@
 /// @file
-/// @brief platform-independent priority sets of 8 or 64 elements.
+/// @brief platform-independent priority sets of up to 32, 64 or 4096
+/// elements.
 /// @ingroup qf
 /// @cond
 ///***************************************************************************
@@ -39,12 +40,23 @@
 #ifndef qpset_h
 #define qpset_h
 
-#if (QF_MAX_ACTIVE < 1) || (64 < QF_MAX_ACTIVE)
-    #error "QF_MAX_ACTIVE not defined or out of range. Valid range is 1..64"
+#if (QF_MAX_ACTIVE < 1) || (4096 < QF_MAX_ACTIVE)
+    #error "QF_MAX_ACTIVE not defined or out of range. Valid range is 1..4096"
 #endif
 
 namespace QP {
 
+#if (QF_MAX_ACTIVE <= 64)
+    //! the type of the priority of an active object in computations
+    typedef uint_fast8_t QPrio;
+
+    //! the type of the priority of an active object stored in objects
+    typedef uint8_t QPrioStore;
+#else
+    typedef uint_fast16_t QPrio;
+    typedef uint16_t QPrioStore;
+#endif // QF_MAX_ACTIVE
+
 //****************************************************************************
 #if (QF_MAX_ACTIVE <= 32)
 //! Priority Set of up to 32 elements */
@@ -75,20 +87,20 @@ public:
     }
 
     //! the function evaluates to TRUE if the priority set has the element n.
-    bool hasElement(uint_fast8_t const n) const {
+    bool hasElement(QPrio const n) const {
         return (m_bits & (static_cast<uint32_t>(1)
                           << (n - static_cast<uint_fast8_t>(1))))
                != static_cast<uint32_t>(0);
     }
 
     //! insert element @p n into the set, n = 1..8
-    void insert(uint_fast8_t const n) {
+    void insert(QPrio const n) {
         m_bits |= static_cast<uint32_t>(
             static_cast<uint32_t>(1) << (n - static_cast<uint_fast8_t>(1)));
     }
 
     //! remove element @p n from the set, n = 1..8
-    void remove(uint_fast8_t const n) {
+    void remove(QPrio const n) {
         m_bits &= static_cast<uint32_t>(
            ~(static_cast<uint32_t>(1) << (n - static_cast<uint_fast8_t>(1))));
     }
@@ -96,16 +108,75 @@ public:
 #ifdef QF_LOG2
     //! find the maximum element in the set, returns zero if the set is empty
     //! inline definition
-    uint_fast8_t findMax(void) const {
+    QPrio findMax(void) const {
         return QF_LOG2(m_bits);
     }
 #else
     //! find the maximum element in the set, returns zero if the set is empty
-    uint_fast8_t findMax(void) const;
+    QPrio findMax(void) const;
 #endif
 };
 
-#else // QF_MAX_ACTIVE > 32
+#elif (QF_MAX_ACTIVE <= 64) && (defined QF_LOG2) && (defined QF_LOG2_64)
+
+//! Priority Set of up to 64 elements in a single 64-bit bitmask
+///
+/// The priority set represents the set of active objects that are ready to
+/// run and need to be considered by the scheduling algorithm. The set is
+/// capable of storing up to 64 priority levels. This variant is used when
+/// the QP port defines QF_LOG2_64() (e.g., on the 64-bit hosts), so that
+/// finding the maximum element needs no branching across two words.
+///
+class QPSet {
+
+    uint64_t volatile m_bits; //!< bitmask with a bit for each element
+
+public:
+
+    //! Makes the priority set @p me_ empty.
+    void setEmpty(void) {
+        m_bits = static_cast<uint64_t>(0);
+    }
+
+    //! Evaluates to true if the priority set is empty
+    bool isEmpty(void) const {
+        return (m_bits == static_cast<uint64_t>(0));
+    }
+
+    //! Evaluates to true if the priority set is not empty
+    bool notEmpty(void) const {
+        return (m_bits != static_cast<uint64_t>(0));
+    }
+
+    //! the function evaluates to TRUE if the priority set has the element n.
+    bool hasElement(QPrio const n) const {
+        return (m_bits & (static_cast<uint64_t>(1)
+                          << (n - static_cast<uint_fast8_t>(1))))
+               != static_cast<uint64_t>(0);
+    }
+
+    //! insert element @p n into the set, n = 1..64
+    void insert(QPrio const n) {
+        m_bits |= (static_cast<uint64_t>(1)
+                   << (n - static_cast<uint_fast8_t>(1)));
+    }
+
+    //! remove element @p n from the set, n = 1..64
+    void remove(QPrio const n) {
+        m_bits &= ~(static_cast<uint64_t>(1)
+                    << (n - static_cast<uint_fast8_t>(1)));
+    }
+
+    //! find the maximum element in the set, returns zero if the set is empty
+    QPrio findMax(void) const {
+        uint64_t const bits = m_bits; // read the volatile bitmask only once
+        return (bits != static_cast<uint64_t>(0))
+               ? static_cast<QPrio>(QF_LOG2_64(bits))
+               : static_cast<QPrio>(0);
+    }
+};
+
+#elif (QF_MAX_ACTIVE <= 64)
 
 //! Priority Set of up to 64 elements
 ///
@@ -142,7 +213,7 @@ public:
     }
 
     //! the function evaluates to TRUE if the priority set has the element n.
-    bool hasElement(uint_fast8_t const n) const {
+    bool hasElement(QPrio const n) const {
         return (n <= static_cast<uint_fast8_t>(32))
             ? ((m_bits[0] & (static_cast<uint32_t>(1)
                              << (n - static_cast<uint_fast8_t>(1))))
@@ -153,7 +224,7 @@ public:
     }
 
     //! insert element @p n into the set, n = 1..64
-    void insert(uint_fast8_t const n) {
+    void insert(QPrio const n) {
         if (n <= static_cast<uint_fast8_t>(32)) {
             m_bits[0] |= (static_cast<uint32_t>(1)
                           << (n - static_cast<uint_fast8_t>(1)));
@@ -165,7 +236,7 @@ public:
     }
 
     //! remove element @p n from the set, n = 1..64
-    void remove(uint_fast8_t const n) {
+    void remove(QPrio const n) {
         if (n <= static_cast<uint_fast8_t>(32)) {
             (m_bits[0] &= ~(static_cast<uint32_t>(1)
                             << (n - static_cast<uint_fast8_t>(1))));
@@ -178,14 +249,112 @@ public:
 
 #ifdef QF_LOG2
     //! find the maximum element in the set, returns zero if the set is empty
-    uint_fast8_t findMax(void) const {
+    QPrio findMax(void) const {
         return (m_bits[1] != static_cast<uint32_t>(0))
             ? (QF_LOG2(m_bits[1]) + static_cast<uint_fast8_t>(32)) \
             : (QF_LOG2(m_bits[0]));
     }
 #else
     //! find the maximum element in the set, returns zero if the set is empty
-    uint_fast8_t findMax(void) const;
+    QPrio findMax(void) const;
+#endif
+};
+
+#else // QF_MAX_ACTIVE > 64
+
+//! Hierarchical Priority Set of up to 4096 elements
+///
+/// The priority set represents the set of active objects that are ready to
+/// run and need to be considered by the scheduling algorithm. The set is
+/// capable of storing up to 4096 priority levels in the leaf bitmasks with
+/// a bit for each element. Every summary bitmask has a bit for each
+/// non-empty leaf bitmask and the single top bitmask has a bit for each
+/// non-empty summary bitmask, so that inserting, removing and finding the
+/// maximum element takes a constant time, independent of the number of
+/// the elements (three QF_LOG2() for findMax()).
+///
+/// @note
+/// Making the set empty and copying the set take the time proportional to
+/// #QF_MAX_ACTIVE.
+///
+class QPSet {
+
+    //! the number of the leaf and summary bitmasks
+    enum {
+        LEAVES = (QF_MAX_ACTIVE + 31) / 32,
+        SUMS   = (LEAVES + 31) / 32
+    };
+
+    uint32_t volatile m_top;          //!< bit for each non-empty summary
+    uint32_t volatile m_sum[SUMS];    //!< bit for each non-empty leaf
+    uint32_t volatile m_leaf[LEAVES]; //!< bit for each element
+
+public:
+
+    //! Makes the priority set @p me_ empty.
+    void setEmpty(void) {
+        uint_fast16_t i;
+        m_top = static_cast<uint32_t>(0);
+        for (i = static_cast<uint_fast16_t>(0); i < SUMS; ++i) {
+            m_sum[i] = static_cast<uint32_t>(0);
+        }
+        for (i = static_cast<uint_fast16_t>(0); i < LEAVES; ++i) {
+            m_leaf[i] = static_cast<uint32_t>(0);
+        }
+    }
+
+    //! Evaluates to true if the priority set is empty
+    bool isEmpty(void) const {
+        return (m_top == static_cast<uint32_t>(0));
+    }
+
+    //! Evaluates to true if the priority set is not empty
+    bool notEmpty(void) const {
+        return (m_top != static_cast<uint32_t>(0));
+    }
+
+    //! the function evaluates to TRUE if the priority set has the element n.
+    bool hasElement(QPrio const n) const {
+        QPrio const i = n - static_cast<QPrio>(1);
+        return (m_leaf[i >> 5] & (static_cast<uint32_t>(1) << (i & 31U)))
+               != static_cast<uint32_t>(0);
+    }
+
+    //! insert element @p n into the set, n = 1..4096
+    void insert(QPrio const n) {
+        QPrio const i = n - static_cast<QPrio>(1);
+        m_leaf[i >> 5]  |= (static_cast<uint32_t>(1) << (i & 31U));
+        m_sum[i >> 10]  |= (static_cast<uint32_t>(1) << ((i >> 5) & 31U));
+        m_top           |= (static_cast<uint32_t>(1) << (i >> 10));
+    }
+
+    //! remove element @p n from the set, n = 1..4096
+    void remove(QPrio const n) {
+        QPrio const i = n - static_cast<QPrio>(1);
+        m_leaf[i >> 5] &= ~(static_cast<uint32_t>(1) << (i & 31U));
+        if (m_leaf[i >> 5] == static_cast<uint32_t>(0)) { // leaf empty?
+            m_sum[i >> 10] &= ~(static_cast<uint32_t>(1) << ((i >> 5) & 31U));
+            if (m_sum[i >> 10] == static_cast<uint32_t>(0)) { // sum empty?
+                m_top &= ~(static_cast<uint32_t>(1) << (i >> 10));
+            }
+        }
+    }
+
+#ifdef QF_LOG2
+    //! find the maximum element in the set, returns zero if the set is empty
+    QPrio findMax(void) const {
+        QPrio n = static_cast<QPrio>(0);
+        if (m_top != static_cast<uint32_t>(0)) {
+            QPrio const s = static_cast<QPrio>(QF_LOG2(m_top)) - 1U;
+            QPrio const l = (s << 5)
+                + static_cast<QPrio>(QF_LOG2(m_sum[s])) - 1U;
+            n = (l << 5) + static_cast<QPrio>(QF_LOG2(m_leaf[l]));
+        }
+        return n;
+    }
+#else
+    //! find the maximum element in the set, returns zero if the set is empty
+    QPrio findMax(void) const;
 #endif
 };
 
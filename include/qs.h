@@ -103,7 +103,7 @@ enum QSpyRecords {
     QS_QF_EQUEUE_GET,     //!< get an event and queue still not empty
     QS_QF_EQUEUE_GET_LAST,//!< get the last event from the queue
 
-    QS_QF_RESERVED2,
+    QS_QF_POST_BATCH,     //!< a batch of events was posted to AO/raw queue
 
     // [24] MP records
     QS_QF_MPOOL_GET,      //!< a memory block was removed from memory pool
@@ -524,7 +524,7 @@ class QActiveDummy : public QActive {
 public:
     QActiveDummy(void); // ctor
 
-    virtual void start(uint_fast8_t const prio,
+    virtual void start(QPrio const prio,
                        QEvt const *qSto[], uint_fast16_t const qLen,
                        void * const stkSto, uint_fast16_t const stkSize,
                        QEvt const * const ie);
@@ -534,6 +534,10 @@ public:
     virtual bool post_(QEvt const * const e, uint_fast16_t const margin,
                        void const * const sender);
     virtual void postLIFO(QEvt const * const e);
+    virtual bool postBatch_(QEvt const * const evts[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin,
+                            void const * const sender);
 };
 
 enum QUTestUserRecords {
@@ -622,8 +626,8 @@ enum QUTestUserRecords {
 /// The active object filter affects the following QS records:
 /// ::QS_QF_ACTIVE_DEFER, ::QS_QF_ACTIVE_RECALL, ::QS_QF_ACTIVE_SUBSCRIBE,
 /// ::QS_QF_ACTIVE_UNSUBSCRIBE, ::QS_QF_ACTIVE_POST, ::QS_QF_ACTIVE_POST_LIFO,
-/// ::QS_QF_ACTIVE_GET, ::QS_QF_ACTIVE_GET_LAST, and
-/// ::QS_QF_ACTIVE_RECALL_ATTEMPT.
+/// ::QS_QF_ACTIVE_GET, ::QS_QF_ACTIVE_GET_LAST,
+/// ::QS_QF_ACTIVE_RECALL_ATTEMPT, and ::QS_QF_POST_BATCH.
 ///
 /// @sa Example of using QS filters in #QS_FILTER_ON documentation
 #define QS_FILTER_AO_OBJ(obj_) \
@@ -661,7 +665,8 @@ enum QUTestUserRecords {
 /// @n
 /// The event queue filter affects the following QS records:
 /// QP::QS_QF_EQUEUE_POST_FIFO, QP::QS_QF_EQUEUE_POST_LIFO,
-/// QP::QS_QF_EQUEUE_GET, and QP::QS_QF_EQUEUE_GET_LAST.
+/// QP::QS_QF_EQUEUE_GET, QP::QS_QF_EQUEUE_GET_LAST, and
+/// QP::QS_QF_POST_BATCH.
 ///
 /// @sa Example of using QS filters in #QS_FILTER_ON documentation
 #define QS_FILTER_EQ_OBJ(obj_) \
@@ -839,6 +844,8 @@ enum QUTestUserRecords {
         QS_CRIT_EXIT_(); \
     }
 
+#ifndef QF_OBJ_LOCK_TYPE // single QF critical section?
+
 //! Internal QS macro to begin a QS record without entering critical section.
 /// @note
 /// This macro is intended to use only inside QP components and NOT
@@ -858,6 +865,28 @@ enum QUTestUserRecords {
         QP::QS::endRec(); \
     }
 
+#else // per-object QF critical sections
+
+// NOTE: with per-object locks (see #QF_OBJ_LOCK_TYPE), the QF critical
+// sections protect only the individual QF objects, but not the QS trace
+// buffer. Therefore, the QS records produced inside such critical sections
+// must still enter the QS critical section (which is always nested last).
+#define QS_BEGIN_NOCRIT_(rec_, objFilter_, obj_) \
+    if (QS_GLB_FILTER_(rec_) \
+        && (((objFilter_) == static_cast<void *>(0)) \
+            || ((objFilter_) == (obj_)))) \
+    { \
+        QS_CRIT_STAT_ \
+        QS_CRIT_ENTRY_(); \
+        QP::QS::beginRec(static_cast<uint_fast8_t>(rec_));
+
+#define QS_END_NOCRIT_() \
+        QP::QS::endRec(); \
+        QS_CRIT_EXIT_(); \
+    }
+
+#endif // QF_OBJ_LOCK_TYPE
+
 #if (Q_SIGNAL_SIZE == 1)
     //! Internal QS macro to output an unformatted event signal data element
     /// @note
@@ -105,11 +105,14 @@ extern "C" {
     #define QF_SCHED_LOCK_(dummy) ((void)0)
     #define QF_SCHED_UNLOCK_()    ((void)0)
 
+    // QV-specific round-robin servicing of the priority bands
+    #define QF_BAND_SCHED_
+
     // QV-specific native event queue operations...
     #define QACTIVE_EQUEUE_WAIT_(me_) \
         Q_ASSERT_ID(110, (me_)->m_eQueue.m_frontEvt != static_cast<QEvt *>(0))
     #define QACTIVE_EQUEUE_SIGNAL_(me_) \
-        (QV_readySet_.insert(static_cast<uint_fast8_t>((me_)->m_prio)))
+        (QV_readySet_.insert(static_cast<QPrio>((me_)->m_prio)))
 
     // QV-specific native QF event pool operations...
     #define QF_EPOOL_TYPE_  QMPool
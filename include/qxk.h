@@ -44,6 +44,10 @@
 #include "qmpool.h"   // QXK kernel uses the native QF memory pool
 #include "qpset.h"    // QXK kernel uses the native QF priority set
 
+#if (QF_MAX_ACTIVE > 64)
+    #error "QXK supports at most 64 active objects and threads"
+#endif
+
 //****************************************************************************
 // QF configuration for QXK -- data members of the QActive class...
 
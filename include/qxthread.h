@@ -95,13 +95,13 @@ public:
 
     //! Starts execution of an extended thread and registers the thread
     //! with the framework.
-    virtual void start(uint_fast8_t const prio,
+    virtual void start(QPrio const prio,
                        QEvt const *qSto[], uint_fast16_t const qLen,
                        void * const stkSto, uint_fast16_t const stkSize,
                        QEvt const * const ie);
 
     //! Overloaded start function (no initialization event)
-    virtual void start(uint_fast8_t const prio,
+    virtual void start(QPrio const prio,
                        QEvt const *qSto[], uint_fast16_t const qLen,
                        void * const stkSto, uint_fast16_t const stkSize)
     {
@@ -122,6 +122,19 @@ public:
     //! using the Last-In-First-Out (LIFO) policy.
     virtual void postLIFO(QEvt const * const e);
 
+#ifndef Q_SPY
+    //! Posts a batch of events to the extended thread one by one,
+    //! only with the delivery guarantee (POST_BATCH()).
+    virtual bool postBatch_(QEvt const * const evts[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin);
+#else
+    virtual bool postBatch_(QEvt const * const evts[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin,
+                            void const * const sender);
+#endif
+
     //! get the blocking object for this thread (NULL if not blocked)
     bool isBlockedOn(void const * const obj
                      = static_cast<void const *>(0)) const
@@ -85,7 +85,7 @@ extern uint8_t volatile QF_intNest;
     #define QACTIVE_EQUEUE_WAIT_(me_) \
         Q_ASSERT_ID(110, (me_)->m_eQueue.m_frontEvt != static_cast<QEvt *>(0))
     #define QACTIVE_EQUEUE_SIGNAL_(me_) \
-        (QS::rxPriv_.readySet.insert(static_cast<uint_fast8_t>((me_)->m_prio)))
+        (QS::rxPriv_.readySet.insert(static_cast<QPrio>((me_)->m_prio)))
 
     // native QF event pool operations
     #define QF_EPOOL_TYPE_  QMPool
@@ -110,7 +110,7 @@ static void thread_function(void *pVoid) { // embOS signature
     OS_TerminateTask(&act->getThread());
 }
 //............................................................................
-void QActive::start(uint_fast8_t prio,
+void QActive::start(QPrio prio,
                      QEvt const *qSto[], uint_fast16_t qLen,
                      void *stkSto, uint_fast16_t stkSize,
                      QEvt const *ie)
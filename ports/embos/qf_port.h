@@ -43,6 +43,9 @@
 #define QF_THREAD_TYPE       OS_TASK
 #define QF_OS_OBJECT_TYPE    uint32_t
 
+// the native OS queues cannot post a batch of events atomically
+#define QF_NO_POST_BATCH
+
 // The maximum number of active objects in the application, see NOTE1
 #define QF_MAX_ACTIVE        32
 
@@ -59,6 +62,19 @@
 #define QF_TASK_USES_FPU     (static_cast<uint32_t>(1))
 
 #include "RTOS.h"      // embOS API
+// this port stores the events posted to active objects by pointer only
+#ifdef QF_EVT_INLINE
+    #error "QF_EVT_INLINE is not supported in this QF port"
+#endif
+// this port does not post the events to active objects in batches
+#ifdef QF_TIMEEVT_SLACK
+    #error "QF_TIMEEVT_SLACK is not supported in this QF port"
+#endif
+// this port gets the events from the native queues of the RTOS
+#ifdef QF_PS_BROADCAST
+    #error "QF_PS_BROADCAST is not supported in this QF port"
+#endif
+
 #include "qep_port.h"  // QEP port
 #include "qequeue.h"   // used for event deferral
 #include "qpset.h"     // this QP port uses the native QP priority set
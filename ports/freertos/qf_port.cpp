@@ -74,7 +74,7 @@ void QF::stop(void) {
 }
 
 //............................................................................
-void QActive::start(uint_fast8_t prio,
+void QActive::start(QPrio prio,
                     QEvt const *qSto[], uint_fast16_t qLen,
                     void *stkSto, uint_fast16_t stkSize,
                     QEvt const *ie)
@@ -273,7 +273,11 @@ void QF::publishFromISR_(QEvt const *e, void *par)
     }
 
     // make a local, modifiable copy of the subscriber list
+#ifndef QF_SUBSCR_DENSE
     QPSet subscrList = QF_PTR_AT_(QF_subscrList_, e->sig);
+#else
+    QPSet subscrList = QF_PTR_AT_(QF_subscrList_, e->sig).m_set;
+#endif // QF_SUBSCR_DENSE
     taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptState);
 
     if (subscrList.notEmpty()) {
@@ -314,6 +318,8 @@ void QF::tickXfromISR_(uint_fast8_t const tickRate, void *par)
     QTimeEvt *prev = &timeEvtHead_[tickRate];
     UBaseType_t uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
 
+    ++tickCtr_[tickRate]; // monotonic tick counter
+
     QS_BEGIN_NOCRIT_(QS_QF_TICK, static_cast<void*>(0), static_cast<void*>(0))
         QS_TEC_(static_cast<QTimeEvtCtr>(++prev->m_ctr)); // tick ctr
         QS_U8_(static_cast<uint8_t>(tickRate));           // tick rate
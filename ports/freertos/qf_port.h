@@ -61,6 +61,26 @@
 #include "FreeRTOS.h"  // FreeRTOS master include file, see NOTE4/
 #include "task.h"      // FreeRTOS task  management
 
+// this port stores the events posted to active objects by pointer only
+#ifdef QF_EVT_INLINE
+    #error "QF_EVT_INLINE is not supported in this QF port"
+#endif
+#ifdef QF_TIMEEVT_WHEEL
+    #error "QF_TIMEEVT_WHEEL is not supported in this QF port"
+#endif
+#ifdef QF_PS_SPARSE
+    #error "QF_PS_SPARSE is not supported in this QF port"
+#endif
+#ifdef QF_PS_RANGES
+    #error "QF_PS_RANGES is not supported in this QF port"
+#endif
+#ifdef QF_PS_FILTERS
+    #error "QF_PS_FILTERS is not supported in this QF port"
+#endif
+#ifdef QF_PS_BROADCAST
+    #error "QF_PS_BROADCAST is not supported in this QF port"
+#endif
+
 #include "qep_port.h"  // QEP port
 #include "qequeue.h"   // this QP port uses the native QF event queue
 #include "qmpool.h"    // this QP port uses the native QF memory pool
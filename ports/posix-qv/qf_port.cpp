@@ -93,6 +93,8 @@ void QF::init(void) {
     QF_maxPool_ = static_cast<uint_fast8_t>(0);
     bzero(&QF::timeEvtHead_[0],
           static_cast<uint_fast16_t>(sizeof(QF::timeEvtHead_)));
+    bzero(&QF::tickCtr_[0],
+          static_cast<uint_fast16_t>(sizeof(QF::tickCtr_)));
     bzero(&active_[0], static_cast<uint_fast16_t>(sizeof(active_)));
 
     l_tick.tv_sec = 0;
@@ -169,7 +171,10 @@ int_t QF::run(void) {
     while (l_isRunning) {
 
         if (QV_readySet_.notEmpty()) {
-            uint_fast8_t p = QV_readySet_.findMax();
+            QPrio p = QV_readySet_.findMax();
+#ifdef QF_PRIO_BANDS
+            p = bandNext_(p, QV_readySet_); // round-robin in the band
+#endif
             QActive *a = active_[p];
             QF_CRIT_EXIT_();
 
@@ -184,8 +189,10 @@ int_t QF::run(void) {
             // 3. determine if event is garbage and collect it if so
             //
             QEvt const *e = a->get_();
-            a->dispatch(e);
-            gc(e);
+            if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+                a->dispatch(e);
+                gc(e);
+            }
 
             QF_CRIT_ENTRY_();
 
@@ -261,18 +268,18 @@ int QF_consoleWaitForKey(void) {
 }
 
 //****************************************************************************
-void QActive::start(uint_fast8_t prio,
+void QActive::start(QPrio prio,
                     QEvt const *qSto[], uint_fast16_t qLen,
                     void *stkSto, uint_fast16_t /*stkSize*/,
                     QEvt const *ie)
 {
-    Q_REQUIRE_ID(600, (static_cast<uint_fast8_t>(0) < prio) /* priority...*/
-        && (prio <= static_cast<uint_fast8_t>(QF_MAX_ACTIVE)) /*.. in range */
+    Q_REQUIRE_ID(600, (static_cast<QPrio>(0) < prio) /* priority...*/
+        && (prio <= static_cast<QPrio>(QF_MAX_ACTIVE)) /*.. in range */
         && (stkSto == static_cast<void *>(0))); // statck storage must NOT...
                                                   // ... be provided
 
     m_eQueue.init(qSto, qLen);
-    m_prio = static_cast<uint8_t>(prio); // set the QF priority of this AO
+    m_prio = static_cast<QPrioStore>(prio); // set the QF priority of this AO
     QF::add_(this); // make QF aware of this AO
     this->init(ie); // execute initial transition (virtual call)
 }
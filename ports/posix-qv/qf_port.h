@@ -43,8 +43,11 @@
 //#define QF_OS_OBJECT_TYPE  // not used
 //#define QF_THREAD_TYPE     // not used
 
-// The maximum number of active objects in the application
-#define QF_MAX_ACTIVE        64
+// The maximum number of active objects in the application,
+// which can be raised up to 4096 (see qpset.h)
+#ifndef QF_MAX_ACTIVE
+    #define QF_MAX_ACTIVE    64
+#endif
 
 // The number of system clock tick rates
 #define QF_MAX_TICK_RATE     2
@@ -61,7 +64,20 @@
 #define QF_CRIT_ENTRY(dummy) QP::QF_enterCriticalSection_()
 #define QF_CRIT_EXIT(dummy)  QP::QF_leaveCriticalSection_()
 
-// QF_LOG2 not defined -- use the internal LOG2() implementation
+// QF_LOG2 with the count-leading-zeros builtin of GCC/Clang (the argument
+// extended with a low 1-bit makes QF_LOG2(0) == 0 without a branch) and
+// the 64-bit variant for the single-word priority set on 64-bit hosts,
+// unless QF_LOG2_PORTABLE selects the internal LOG2() implementation
+#if (defined __GNUC__) && (!defined QF_LOG2_PORTABLE)
+    #define QF_LOG2(n_) (static_cast<uint_fast8_t>(63 \
+        - __builtin_clzll((static_cast<uint64_t>(n_) << 1) | 1U)))
+    #if (defined __LP64__) || (defined _WIN64)
+        #define QF_LOG2_64(n_) \
+            (static_cast<uint_fast8_t>(64 - __builtin_clzll((n_))))
+    #endif
+#else
+    // QF_LOG2 not defined -- use the internal LOG2() implementation
+#endif
 
 #include "qep_port.h"  // QEP port
 #include "qequeue.h"   // POSIX-QV needs event-queue
@@ -99,6 +115,9 @@ int  QF_consoleWaitForKey(void);
     #define QF_SCHED_LOCK_(dummy) ((void)0)
     #define QF_SCHED_UNLOCK_()    ((void)0)
 
+    // round-robin servicing of the priority bands (in the event loop)
+    #define QF_BAND_SCHED_
+
     // event queue operations...
     #define QACTIVE_EQUEUE_WAIT_(me_) \
         Q_ASSERT((me_)->m_eQueue.m_frontEvt != static_cast<QEvt const *>(0))
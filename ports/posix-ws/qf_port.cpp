@@ -0,0 +1,505 @@
+/// @file
+/// @brief QF/C++ port to POSIX API with M:N work-stealing executor
+/// @cond
+///***************************************************************************
+/// Last updated for version 6.3.7
+/// Last updated on  2018-11-09
+///
+///                    Q u a n t u m  L e a P s
+///                    ------------------------
+///                    Modern Embedded Software
+///
+/// Copyright (C) 2005-2018 Quantum Leaps, LLC. All rights reserved.
+///
+/// This program is open source software: you can redistribute it and/or
+/// modify it under the terms of the GNU General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// Alternatively, this program may be distributed and modified under the
+/// terms of Quantum Leaps commercial licenses, which expressly supersede
+/// the GNU General Public License and are specifically designed for
+/// licensees interested in retaining the proprietary status of their code.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program. If not, see <http://www.gnu.org/licenses/>.
+///
+/// Contact information:
+/// https://www.state-machine.com
+/// mailto:info@state-machine.com
+///***************************************************************************
+/// @endcond
+
+#define QP_IMPL           // this is QP implementation
+#include "qf_port.h"      // QF port
+#include "qf_pkg.h"       // QF package-scope interface
+#include "qassert.h"      // QP embedded systems-friendly assertions
+#ifdef Q_SPY              // QS software tracing enabled?
+    #include "qs_port.h"  // include QS port
+#else
+    #include "qs_dummy.h" // disable the QS software tracing
+#endif // Q_SPY
+
+#include <limits.h>       // for PTHREAD_STACK_MIN
+#include <sys/mman.h>     // for mlockall()
+#include <sys/select.h>
+#include <sys/ioctl.h>
+#include <string.h>       // for memcpy() and memset()
+#include <stdlib.h>
+#include <stdio.h>
+#include <termios.h>
+#include <unistd.h>
+#include <signal.h>
+
+namespace QP {
+
+Q_DEFINE_THIS_MODULE("qf_port")
+
+// Local objects *************************************************************
+//! worker thread with its run queue of the scheduled active objects
+struct QWsWorker {
+    pthread_mutex_t lock;      //!< mutex protecting the run queue
+    pthread_t thread;          //!< the p-thread of the worker
+    uint_fast16_t head;        //!< index of the front of the run queue
+    uint_fast16_t nUsed;       //!< number of AOs in the run queue
+    QActive *ring[QF_MAX_ACTIVE]; //!< ring buffer of the run queue, NOTE02
+};
+
+static pthread_mutex_t l_pThreadMutex; // POSIX mutex for the QF crit. section
+static pthread_cond_t l_idleCond; // cond. var. of the idle workers, NOTE03
+static QWsWorker l_worker[QF_WS_MAX_WORKERS]; // the worker threads
+static uint_fast8_t l_nWorkers; // number of the worker threads
+static uint_fast8_t l_nIdle;    // number of the idle workers, NOTE03
+static bool l_isRunning;    // flag indicating when QF is running
+static struct termios l_tsav; // structure with saved terminal attributes
+static struct timespec l_tick;
+static int_t l_tickPrio;
+enum { NANOSLEEP_NSEC_PER_SEC = 1000000000 }; // see NOTE04
+
+static void *worker_thread(void *arg);
+static void runQueuePut(QWsWorker * const w, QActive * const act);
+static QActive *runQueueGet(QWsWorker * const w, bool const front);
+static void sigIntHandler(int /* dummy */);
+
+//****************************************************************************
+void QF::init(void) {
+    // lock memory so we're never swapped out to disk
+    //mlockall(MCL_CURRENT | MCL_FUTURE); // uncomment when supported
+
+    // init the global mutex with the default non-recursive initializer
+    pthread_mutex_init(&l_pThreadMutex, NULL);
+
+    // init the condition variable of the idle workers
+    pthread_cond_init(&l_idleCond, NULL);
+
+    // clear the internal QF variables, so that the framework can (re)start
+    // correctly even if the startup code is not called to clear the
+    // uninitialized data (as is required by the C++ Standard).
+    extern uint_fast8_t QF_maxPool_;
+    QF_maxPool_ = static_cast<uint_fast8_t>(0);
+    bzero(&QF::timeEvtHead_[0],
+          static_cast<uint_fast16_t>(sizeof(QF::timeEvtHead_)));
+    bzero(&QF::tickCtr_[0],
+          static_cast<uint_fast16_t>(sizeof(QF::tickCtr_)));
+    bzero(&active_[0], static_cast<uint_fast16_t>(sizeof(active_)));
+
+    // by default one worker thread per online CPU core
+    long nCores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nCores < 1L) {
+        nCores = 1L;
+    }
+    else if (nCores > static_cast<long>(QF_WS_MAX_WORKERS)) {
+        nCores = static_cast<long>(QF_WS_MAX_WORKERS);
+    }
+    l_nWorkers = static_cast<uint_fast8_t>(nCores);
+    l_nIdle    = static_cast<uint_fast8_t>(0);
+    for (uint_fast8_t i = 0U; i < static_cast<uint_fast8_t>(QF_WS_MAX_WORKERS);
+         ++i)
+    {
+        pthread_mutex_init(&l_worker[i].lock, NULL);
+        l_worker[i].head  = static_cast<uint_fast16_t>(0);
+        l_worker[i].nUsed = static_cast<uint_fast16_t>(0);
+    }
+
+    l_tick.tv_sec = 0;
+    l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC/100L; // default clock tick
+    l_tickPrio = sched_get_priority_min(SCHED_FIFO); // default tick prio
+
+    // install the SIGINT (Ctrl-C) signal handler
+    struct sigaction sig_act;
+    sig_act.sa_handler = &sigIntHandler;
+    sigaction(SIGINT, &sig_act, NULL);
+}
+
+//****************************************************************************
+void QF_enterCriticalSection_(void) {
+    pthread_mutex_lock(&l_pThreadMutex);
+}
+//****************************************************************************
+void QF_leaveCriticalSection_(void) {
+    pthread_mutex_unlock(&l_pThreadMutex);
+}
+
+//****************************************************************************
+int_t QF::run(void) {
+
+    onStartup(); // application-specific startup callback
+
+    // try to set the priority of the ticker thread, see NOTE01
+    struct sched_param sparam;
+    sparam.sched_priority = l_tickPrio;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &sparam) == 0) {
+        // success, this application has sufficient privileges
+    }
+    else {
+        // setting priority failed, probably due to insufficient privieges
+    }
+
+    l_isRunning = true; // QF is running
+
+    // start the worker threads with the default scheduling policy,
+    // which execute all active objects, see NOTE02
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+
+    // don't inherit SCHED_FIFO of the ticker (main) thread
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    pthread_attr_setschedpolicy(&attr, SCHED_OTHER);
+    sparam.sched_priority = 0; // the only priority of SCHED_OTHER
+    pthread_attr_setschedparam(&attr, &sparam);
+    pthread_attr_setstacksize(&attr, static_cast<size_t>(PTHREAD_STACK_MIN
+                                                         + 0x10000));
+    for (uint_fast8_t i = 0U; i < l_nWorkers; ++i) {
+        int err = pthread_create(&l_worker[i].thread, &attr, &worker_thread,
+                                 &l_worker[i]);
+        Q_ASSERT_ID(310, err == 0); // the worker must be created
+    }
+    pthread_attr_destroy(&attr);
+
+    // the main thread becomes the ticker thread, if the clock tick
+    // is configured
+    if ((l_tick.tv_sec != 0) || (l_tick.tv_nsec != 0)) {
+        while (l_isRunning) { // the clock tick loop...
+            QF_onClockTick(); // clock tick callback (must call QF_TICK_X())
+
+            nanosleep(&l_tick, NULL); // sleep for the number of ticks, NOTE04
+        }
+    }
+
+    // wait for all worker threads to terminate after QF::stop()
+    for (uint_fast8_t i = 0U; i < l_nWorkers; ++i) {
+        pthread_join(l_worker[i].thread, static_cast<void **>(0));
+    }
+
+    onCleanup();  // cleanup callback
+    QS_EXIT();    // cleanup the QSPY connection
+
+    for (uint_fast8_t i = 0U; i < static_cast<uint_fast8_t>(QF_WS_MAX_WORKERS);
+         ++i)
+    {
+        pthread_mutex_destroy(&l_worker[i].lock);
+    }
+    pthread_cond_destroy(&l_idleCond);      // cleanup the condition variable
+    pthread_mutex_destroy(&l_pThreadMutex); // cleanup the global mutex
+
+    return static_cast<int_t>(0);
+}
+//****************************************************************************
+void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio) {
+    if (ticksPerSec != static_cast<uint32_t>(0)) {
+        l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC / ticksPerSec;
+    }
+    else {
+        l_tick.tv_nsec = 0; /* means NO system clock tick */
+    }
+    l_tickPrio = tickPrio;
+}
+//****************************************************************************
+void QF_setWorkers(uint_fast8_t nWorkers) {
+    /// @pre the number of workers must not exceed QF_WS_MAX_WORKERS
+    /// and QF must not be running yet
+    Q_REQUIRE_ID(100,
+        (nWorkers <= static_cast<uint_fast8_t>(QF_WS_MAX_WORKERS))
+        && (!l_isRunning));
+
+    /// @pre no active object can be started yet, because its run queue
+    /// depends on the number of workers
+    for (QPrio p = 1U; p <= static_cast<QPrio>(QF_MAX_ACTIVE); ++p) {
+        Q_REQUIRE_ID(110, QF::active_[p] == static_cast<QActive *>(0));
+    }
+
+    if (nWorkers != static_cast<uint_fast8_t>(0)) {
+        l_nWorkers = nWorkers;
+    }
+}
+//............................................................................
+void QF::stop(void) {
+    QF_CRIT_STAT_
+    QF_CRIT_ENTRY_();
+    l_isRunning = false; // terminate the clock tick and the worker threads
+    pthread_cond_broadcast(&l_idleCond); // unblock all idle workers
+    QF_CRIT_EXIT_();
+}
+//............................................................................
+void QF_consoleSetup(void) {
+    struct termios tio;   // modified terminal attributes
+
+    tcgetattr(0, &l_tsav); // save the current terminal attributes
+    tcgetattr(0, &tio);    // obtain the current terminal attributes
+    tio.c_lflag &= ~(ICANON | ECHO); // disable the canonical mode & echo
+    tcsetattr(0, TCSANOW, &tio);     // set the new attributes
+}
+//............................................................................
+void QF_consoleCleanup(void) {
+    tcsetattr(0, TCSANOW, &l_tsav); // restore the saved attributes
+}
+//............................................................................
+int QF_consoleGetKey(void) {
+    int byteswaiting;
+    ioctl(0, FIONREAD, &byteswaiting);
+    if (byteswaiting > 0) {
+        char ch;
+        read(0, &ch, 1);
+        return (int)ch;
+    }
+    return 0; // no input at this time
+}
+/*..........................................................................*/
+int QF_consoleWaitForKey(void) {
+    return getchar();
+}
+
+//****************************************************************************
+void QActive::start(QPrio prio,
+                    QEvt const *qSto[], uint_fast16_t qLen,
+                    void *stkSto, uint_fast16_t /*stkSize*/,
+                    QEvt const *ie)
+{
+    Q_REQUIRE_ID(600, (static_cast<QPrio>(0) < prio) /* priority...*/
+        && (prio <= static_cast<QPrio>(QF_MAX_ACTIVE)) /*.. in range */
+        && (stkSto == static_cast<void *>(0))); // statck storage must NOT...
+                                                  // ... be provided
+
+    m_eQueue.init(qSto, qLen);
+    m_osObject = static_cast<uint8_t>(0); // not scheduled yet
+    // spread the active objects over the run queues of the workers
+    m_thread = static_cast<uint8_t>((prio - static_cast<QPrio>(1))
+                                    % static_cast<QPrio>(l_nWorkers));
+    m_prio = static_cast<QPrioStore>(prio); // set the QF priority of this AO
+    QF::add_(this); // make QF aware of this AO
+    this->init(ie); // execute initial transition (virtual call)
+}
+//****************************************************************************
+void QActive::stop(void) {
+    unsubscribeAll();
+    QF::remove_(this);
+}
+
+//****************************************************************************
+// NOTE: called inside the QF critical section
+void QF_wsSchedule_(QActive * const act) {
+    if (act->m_osObject == static_cast<uint8_t>(0)) { // not scheduled yet?
+        act->m_osObject = static_cast<uint8_t>(1);
+
+        // the run queue of the worker, which executed the AO last
+        runQueuePut(&l_worker[act->m_thread], act);
+
+        if (l_nIdle != static_cast<uint_fast8_t>(0)) { // any idle workers?
+            pthread_cond_signal(&l_idleCond); // wake one up, see NOTE03
+        }
+    }
+}
+
+//****************************************************************************
+/// @description
+/// In this port QF::thread_() executes the run-to-completion steps of the
+/// scheduled active object @p act in the worker thread, which has taken
+/// the active object from a run queue (see NOTE02). The active object is
+/// executed until its event queue gets empty, but at most #QF_WS_BATCH
+/// events, after which it is scheduled again at the back of the run queue
+/// of the worker.
+///
+void QF::thread_(QActive *act) {
+    QF_CRIT_STAT_
+    uint_fast16_t nEvts = static_cast<uint_fast16_t>(QF_WS_BATCH);
+    bool isScheduled = true;
+    do {
+        // the active object 'act' must still be registered in QF
+        // (e.g., it must not be stopped)
+        Q_ASSERT_ID(320, active_[act->m_prio] == act);
+
+        // perform the run-to-completion (RTC) step...
+        // 1. retrieve the event from the AO's event queue, which by this
+        //    time must be non-empty and the port asserts it.
+        // 2. dispatch the event to the AO's state machine.
+        // 3. determine if event is garbage and collect it if so
+        //
+        QEvt const *e = act->get_();
+        if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+            act->dispatch(e);
+            gc(e);
+        }
+        --nEvts;
+
+        QF_CRIT_ENTRY_();
+        if (act->m_eQueue.isEmpty()       // no more events?
+            || (active_[act->m_prio] != act)) // or stopped in the RTC step?
+        {
+            act->m_osObject = static_cast<uint8_t>(0); // not scheduled
+            isScheduled = false;
+        }
+        else if (nEvts == static_cast<uint_fast16_t>(0)) { // batch used up?
+            act->m_osObject = static_cast<uint8_t>(0);
+            QF_wsSchedule_(act); // give the other AOs a turn
+            isScheduled = false;
+        }
+        else {
+            // continue with the next event of the same AO
+        }
+        QF_CRIT_EXIT_();
+    } while (isScheduled);
+}
+
+//****************************************************************************
+static void *worker_thread(void *arg) { // for pthread_create()
+    QWsWorker * const me = static_cast<QWsWorker *>(arg);
+    uint8_t const myIdx = static_cast<uint8_t>(me - &l_worker[0]);
+    QF_CRIT_STAT_
+
+    while (l_isRunning) {
+        // the front of the own run queue first...
+        QActive *act = runQueueGet(me, true);
+
+        // ... and steal from the back of the others, see NOTE02
+        for (uint_fast8_t i = 1U;
+             (act == static_cast<QActive *>(0)) && (i < l_nWorkers);
+             ++i)
+        {
+            uint_fast8_t victim = static_cast<uint_fast8_t>(myIdx) + i;
+            if (victim >= l_nWorkers) {
+                victim -= l_nWorkers;
+            }
+            act = runQueueGet(&l_worker[victim], false);
+        }
+
+        if (act != static_cast<QActive *>(0)) {
+            act->m_thread = myIdx; // this worker executes the AO now
+            QF::thread_(act);
+        }
+        else { // nothing to do, see NOTE03
+            QF_CRIT_ENTRY_();
+            bool isIdle = l_isRunning;
+            for (uint_fast8_t i = 0U; isIdle && (i < l_nWorkers); ++i) {
+                pthread_mutex_lock(&l_worker[i].lock);
+                isIdle = (l_worker[i].nUsed == static_cast<uint_fast16_t>(0));
+                pthread_mutex_unlock(&l_worker[i].lock);
+            }
+            if (isIdle) {
+                ++l_nIdle;
+                pthread_cond_wait(&l_idleCond, &l_pThreadMutex);
+                --l_nIdle;
+            }
+            QF_CRIT_EXIT_();
+        }
+    }
+    return static_cast<void *>(0); // return success
+}
+
+//****************************************************************************
+// NOTE: called inside the QF critical section
+static void runQueuePut(QWsWorker * const w, QActive * const act) {
+    pthread_mutex_lock(&w->lock);
+
+    // an AO can be only once in all run queues, see NOTE02
+    Q_ASSERT_ID(410, w->nUsed < static_cast<uint_fast16_t>(QF_MAX_ACTIVE));
+
+    uint_fast16_t i = w->head + w->nUsed;
+    if (i >= static_cast<uint_fast16_t>(QF_MAX_ACTIVE)) {
+        i -= static_cast<uint_fast16_t>(QF_MAX_ACTIVE);
+    }
+    w->ring[i] = act;
+    ++w->nUsed;
+
+    pthread_mutex_unlock(&w->lock);
+}
+//............................................................................
+// takes the AO from the front or from the back of the run queue
+static QActive *runQueueGet(QWsWorker * const w, bool const front) {
+    QActive *act = static_cast<QActive *>(0);
+
+    pthread_mutex_lock(&w->lock);
+    if (w->nUsed != static_cast<uint_fast16_t>(0)) {
+        --w->nUsed;
+        if (front) {
+            act = w->ring[w->head];
+            ++w->head;
+            if (w->head == static_cast<uint_fast16_t>(QF_MAX_ACTIVE)) {
+                w->head = static_cast<uint_fast16_t>(0);
+            }
+        }
+        else {
+            uint_fast16_t i = w->head + w->nUsed;
+            if (i >= static_cast<uint_fast16_t>(QF_MAX_ACTIVE)) {
+                i -= static_cast<uint_fast16_t>(QF_MAX_ACTIVE);
+            }
+            act = w->ring[i];
+        }
+    }
+    pthread_mutex_unlock(&w->lock);
+
+    return act;
+}
+
+//****************************************************************************
+static void sigIntHandler(int /* dummy */) {
+    QF::onCleanup();
+    exit(-1);
+}
+
+} // namespace QP
+
+//****************************************************************************
+// NOTE01:
+// In Linux, the scheduler policy closest to real-time is the SCHED_FIFO
+// policy, available only with superuser privileges. QF::run() attempts to set
+// this policy as well as to maximize its priority, so that the ticking
+// occurrs in the most timely manner (as close to an interrupt as possible).
+// However, setting the SCHED_FIFO policy might fail, most probably due to
+// insufficient privileges.
+//
+// NOTE02:
+// The run queue of every worker can hold all active objects, because every
+// active object is at most once in all run queues (see NOTE2 in qf_port.h).
+// The run queues are protected by the mutexes of the workers, so that the
+// workers can take the active objects in parallel. The active objects are
+// put to the run queues only inside the QF critical section, so the lock
+// of a run queue is always taken after (never before) the QF critical
+// section mutex, which avoids deadlocks.
+//
+// The owner takes the active objects from the front of its run queue
+// (round-robin), while the thieves take them from the back, where the most
+// recently scheduled active objects are, and so the owner and the thieves
+// collide only when the run queue is nearly empty. A stolen active object
+// migrates to the thief, because its later events are scheduled to the run
+// queue of the worker, which executed the active object last.
+//
+// NOTE03:
+// A worker without any active object to execute blocks on the condition
+// variable l_idleCond. Before that, it checks all run queues once more,
+// inside the QF critical section. Because the active objects are scheduled
+// only inside the QF critical section, no active object can be scheduled
+// between this check and the blocking (pthread_cond_wait() releases the
+// critical section mutex atomically), so no wake-up can be lost. An active
+// object scheduled while any worker is idle wakes up one idle worker, which
+// then steals the active object, unless its own worker gets to it first.
+//
+// NOTE04:
+// In some (older) Linux kernels, the POSIX nanosleep() system call might
+// deliver only 2*actual-system-tick granularity. To compensate for this,
+// you would need to reduce (by 2) the constant NANOSLEEP_NSEC_PER_SEC.
+//
@@ -0,0 +1,209 @@
+/// @file
+/// @brief QF/C++ port to POSIX API with M:N work-stealing executor (posix-ws)
+/// @cond
+///***************************************************************************
+/// Last updated for version 6.3.7
+/// Last updated on  2018-11-09
+///
+///                    Q u a n t u m  L e a P s
+///                    ------------------------
+///                    Modern Embedded Software
+///
+/// Copyright (C) 2005-2018 Quantum Leaps, LLC. All rights reserved.
+///
+/// This program is open source software: you can redistribute it and/or
+/// modify it under the terms of the GNU General Public License as published
+/// by the Free Software Foundation, either version 3 of the License, or
+/// (at your option) any later version.
+///
+/// Alternatively, this program may be distributed and modified under the
+/// terms of Quantum Leaps commercial licenses, which expressly supersede
+/// the GNU General Public License and are specifically designed for
+/// licensees interested in retaining the proprietary status of their code.
+///
+/// This program is distributed in the hope that it will be useful,
+/// but WITHOUT ANY WARRANTY; without even the implied warranty of
+/// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+/// GNU General Public License for more details.
+///
+/// You should have received a copy of the GNU General Public License
+/// along with this program. If not, see <http://www.gnu.org/licenses/>.
+///
+/// Contact information:
+/// https://www.state-machine.com
+/// mailto:info@state-machine.com
+///***************************************************************************
+/// @endcond
+
+#ifndef qf_port_h
+#define qf_port_h
+
+// event queue and thread types, see NOTE2
+#define QF_EQUEUE_TYPE       QEQueue
+#define QF_OS_OBJECT_TYPE    uint8_t
+#define QF_THREAD_TYPE       uint8_t
+
+// The maximum number of active objects in the application,
+// which can be raised up to 4096 (see qpset.h)
+#ifndef QF_MAX_ACTIVE
+    #define QF_MAX_ACTIVE    64
+#endif
+
+// The maximum number of the worker threads (1..255)
+#ifndef QF_WS_MAX_WORKERS
+    #define QF_WS_MAX_WORKERS 16
+#endif
+
+// The maximum number of events an active object can process in one go,
+// before the worker thread gives the other scheduled active objects a turn
+#ifndef QF_WS_BATCH
+    #define QF_WS_BATCH      8
+#endif
+
+// The number of system clock tick rates
+#define QF_MAX_TICK_RATE     2
+
+// various QF object sizes configuration for this port
+#define QF_EVENT_SIZ_SIZE    4
+#define QF_EQUEUE_CTR_SIZE   4
+#define QF_MPOOL_SIZ_SIZE    4
+#define QF_MPOOL_CTR_SIZE    4
+#define QF_TIMEEVT_CTR_SIZE  4
+
+// QF critical section entry/exit for POSIX, see NOTE1
+// QF_CRIT_STAT_TYPE not defined
+#define QF_CRIT_ENTRY(dummy) QP::QF_enterCriticalSection_()
+#define QF_CRIT_EXIT(dummy)  QP::QF_leaveCriticalSection_()
+
+// QF_LOG2 with the count-leading-zeros builtin of GCC/Clang (the argument
+// extended with a low 1-bit makes QF_LOG2(0) == 0 without a branch) and
+// the 64-bit variant for the single-word priority set on 64-bit hosts,
+// unless QF_LOG2_PORTABLE selects the internal LOG2() implementation
+#if (defined __GNUC__) && (!defined QF_LOG2_PORTABLE)
+    #define QF_LOG2(n_) (static_cast<uint_fast8_t>(63 \
+        - __builtin_clzll((static_cast<uint64_t>(n_) << 1) | 1U)))
+    #if (defined __LP64__) || (defined _WIN64)
+        #define QF_LOG2_64(n_) \
+            (static_cast<uint_fast8_t>(64 - __builtin_clzll((n_))))
+    #endif
+#else
+    // QF_LOG2 not defined -- use the internal LOG2() implementation
+#endif
+
+#include "qep_port.h"  // QEP port
+#include "qequeue.h"   // POSIX-WS needs event-queue
+#include "qmpool.h"    // POSIX-WS needs memory-pool
+#include "qpset.h"     // POSIX-WS needs priority-set
+#include "qf.h"        // QF platform-independent public interface
+
+namespace QP {
+
+void QF_enterCriticalSection_(void);
+void QF_leaveCriticalSection_(void);
+
+// set clock tick rate and p-thread priority
+// (NOTE: ticksPerSec==0 disables the clock tick processing)
+void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio);
+
+// set the number of the worker threads (0 means one per online CPU core)
+// (NOTE: must be called before starting any active object)
+void QF_setWorkers(uint_fast8_t nWorkers);
+
+// clock tick callback (NOTE not called when the clock tick is disabled)
+void QF_onClockTick(void);
+
+// abstractions for console access...
+void QF_consoleSetup(void);
+void QF_consoleCleanup(void);
+int  QF_consoleGetKey(void);
+int  QF_consoleWaitForKey(void);
+
+} // namespace QP
+
+//****************************************************************************
+// interface used only inside QF implementation, but not in applications
+//
+#ifdef QP_IMPL
+
+    // scheduler locking (not needed, the AOs are not preempted in the
+    // middle of their RTC steps)
+    #define QF_SCHED_STAT_
+    #define QF_SCHED_LOCK_(dummy) ((void)0)
+    #define QF_SCHED_UNLOCK_()    ((void)0)
+
+    // event queue operations, see NOTE2...
+    #define QACTIVE_EQUEUE_WAIT_(me_) \
+        Q_ASSERT((me_)->m_eQueue.m_frontEvt != static_cast<QEvt const *>(0))
+
+    #define QACTIVE_EQUEUE_SIGNAL_(me_) (QF_wsSchedule_((me_)))
+
+    // event pool operations...
+    #define QF_EPOOL_TYPE_  QMPool
+
+    #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
+        (p_).init((poolSto_), (poolSize_), (evtSize_))
+
+    #define QF_EPOOL_EVENT_SIZE_(p_)  ((p_).getBlockSize())
+    #define QF_EPOOL_GET_(p_, e_, m_) \
+        ((e_) = static_cast<QEvt *>((p_).get((m_))))
+    #define QF_EPOOL_PUT_(p_, e_)     ((p_).put(e_))
+
+    #include <pthread.h>   // POSIX-thread API
+
+    namespace QP {
+        // puts the AO with a newly non-empty queue in a run queue
+        // (called inside the QF critical section)
+        void QF_wsSchedule_(QActive * const act);
+    } // namespace QP
+
+#endif // QP_IMPL
+
+// NOTES: ====================================================================
+//
+// NOTE1:
+// QF, like all real-time frameworks, needs to execute certain sections of
+// code exclusively, meaning that only one thread can execute the code at
+// the time. Such sections of code are called "critical sections"
+//
+// This port uses a pair of functions QF_enterCriticalSection_() /
+// QF_leaveCriticalSection_() to enter/leave the cirtical section,
+// respectively.
+//
+// These functions are implemented in the qf_port.c module, where they
+// manipulate the file-scope POSIX mutex object l_pThreadMutex
+// to protect all critical sections. Using the single mutex for all crtical
+// section guarantees that only one thread at a time can execute inside a
+// critical section. This prevents race conditions and data corruption.
+//
+// The critical sections are short (posting an event, allocating an event,
+// scheduling an active object), while the run-to-completion steps of the
+// active objects execute outside of the critical section, in parallel on
+// all worker threads.
+//
+// NOTE2:
+// This port does not create a p-thread per active object. Instead, the
+// active objects are executed by a fixed pool of worker threads (by default
+// one per online CPU core). Every worker has its own run queue of active
+// objects, which have events to process. A worker takes the active objects
+// from the front of its own run queue and, when the run queue is empty,
+// steals an active object from the back of the run queue of another worker.
+//
+// When an event is posted to an empty event queue of an active object,
+// QACTIVE_EQUEUE_SIGNAL_() puts the active object to the back of the run
+// queue of the worker, which has executed it last (so that it tends to stay
+// on the same CPU core), unless the active object is already scheduled or
+// running. The flag of the scheduled active object is kept in m_osObject
+// and the index of its last worker in m_thread. Because an active object
+// is present at most once in all run queues and is executed by one worker
+// at a time, its run-to-completion steps never overlap and its events are
+// processed in the order of its event queue (FIFO, except postLIFO()).
+//
+// After at most QF_WS_BATCH events the worker puts the still scheduled
+// active object to the back of its run queue, so that the active objects
+// are serviced fairly. Please note that the priorities of the active
+// objects serve only as their unique identifiers in this port (e.g., for
+// the publish-subscribe). The executor does not preempt the active objects
+// and does not order them by their priorities.
+//
+
+#endif // qf_port_h
@@ -55,6 +55,13 @@
 #include <termios.h>
 #include <unistd.h>
 #include <signal.h>
+#if defined(QF_MPSC_EQUEUE) && defined(__linux__)
+    #include <sys/syscall.h>
+    #include <linux/futex.h> // for futex in the QMPSCQueue, see NOTE07
+#endif
+#ifdef QF_TICKLESS
+    #include <time.h>     // for clock_gettime(), see NOTE08
+#endif
 
 
 namespace QP {
@@ -74,6 +81,22 @@ enum { NANOSLEEP_NSEC_PER_SEC = 1000000000 }; // see NOTE05
 
 static void sigIntHandler(int /* dummy */);
 static void *ao_thread(void *arg); // thread routine for all AOs
+#ifdef QF_MAGAZINE_SIZE
+static pthread_key_t l_magazineKey; // see NOTE6 in qf_port.h
+static __thread QFMagazine *l_magazines; // magazines of the calling thread
+static void magazineCleanup(void *mags); // flush magazines at thread exit
+#endif // QF_MAGAZINE_SIZE
+#ifdef QF_TICKLESS
+static pthread_mutex_t l_tickMutex; // protects the tickless state below
+static pthread_cond_t  l_tickCond;  // the ticker thread waits on it
+static struct timespec l_tickStart; // the time of the tick number 0
+static uint64_t l_tickNsec;  // the tick period in nanoseconds
+static uint64_t l_tickCtr;   // the number of ticks processed so far
+static uint64_t l_tickWake;  // the tick the ticker thread waits for
+static uint64_t ticklessTicks(void);
+static uint64_t ticklessAdvance(uint64_t const done);
+static uint64_t ticklessNext(void);
+#endif // QF_TICKLESS
 
 
 // QF functions ==============================================================
@@ -84,6 +107,21 @@ void QF::init(void) {
     // init the global mutex with the default non-recursive initializer
     pthread_mutex_init(&QF_pThreadMutex_, NULL);
 
+#ifdef QF_FINE_LOCKS
+    // init the per-tick-rate mutexes of time events, see NOTE06
+    for (uint_fast8_t tickRate = static_cast<uint_fast8_t>(0);
+         tickRate < static_cast<uint_fast8_t>(QF_MAX_TICK_RATE);
+         ++tickRate)
+    {
+        QF_OBJ_LOCK_INIT(&QF_timeEvtLock_[tickRate]);
+    }
+#endif // QF_FINE_LOCKS
+
+#ifdef QF_MAGAZINE_SIZE
+    // the magazines of terminating threads are flushed, see qf_port.h
+    pthread_key_create(&l_magazineKey, &magazineCleanup);
+#endif // QF_MAGAZINE_SIZE
+
     // init the startup mutex with the default non-recursive initializer
     pthread_mutex_init(&l_startupMutex, NULL);
 
@@ -98,12 +136,27 @@ void QF::init(void) {
     QF_maxPool_ = static_cast<uint_fast8_t>(0);
     bzero(&QF::timeEvtHead_[0],
           static_cast<uint_fast16_t>(sizeof(QF::timeEvtHead_)));
+    bzero(&QF::tickCtr_[0],
+          static_cast<uint_fast16_t>(sizeof(QF::tickCtr_)));
     bzero(&active_[0], static_cast<uint_fast16_t>(sizeof(active_)));
 
     l_tick.tv_sec = 0;
     l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC/100L; // default clock tick
     l_tickPrio = sched_get_priority_min(SCHED_FIFO); // default tick prio
 
+#ifdef QF_TICKLESS
+    // the ticker waits with absolute CLOCK_MONOTONIC deadlines, see NOTE08
+    pthread_condattr_t cattr;
+    pthread_condattr_init(&cattr);
+    pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+    pthread_cond_init(&l_tickCond, &cattr);
+    pthread_condattr_destroy(&cattr);
+    pthread_mutex_init(&l_tickMutex, NULL);
+    l_tickNsec = static_cast<uint64_t>(l_tick.tv_nsec);
+    l_tickCtr  = static_cast<uint64_t>(0);
+    l_tickWake = ~static_cast<uint64_t>(0);
+#endif // QF_TICKLESS
+
     // install the SIGINT (Ctrl-C) signal handler
     struct sigaction sig_act;
     sig_act.sa_handler = &sigIntHandler;
@@ -133,6 +186,7 @@ int_t QF::run(void) {
         // setting priority failed, probably due to insufficient privieges
     }
 
+#ifndef QF_TICKLESS
     // unlock the startup mutex to unblock any active objects started before
     // calling QF::run()
     pthread_mutex_unlock(&l_startupMutex);
@@ -143,6 +197,60 @@ int_t QF::run(void) {
 
         nanosleep(&l_tick, NULL); // sleep for the number of ticks, NOTE05
     }
+#else // tickless processing of time events, see NOTE08
+    pthread_mutex_lock(&l_tickMutex);
+    clock_gettime(CLOCK_MONOTONIC, &l_tickStart); // the tick number 0
+    l_isRunning = true;
+
+    // unlock the startup mutex to unblock any active objects started before
+    // calling QF::run()
+    pthread_mutex_unlock(&l_startupMutex);
+
+    while (l_isRunning) { // the tickless loop...
+        // process all ticks until now without blocking the threads arming
+        // time events, see NOTE08
+        uint64_t const done = l_tickCtr; // changed only by this thread
+        pthread_mutex_unlock(&l_tickMutex);
+        uint64_t const ticks = ticklessAdvance(done);
+        pthread_mutex_lock(&l_tickMutex);
+        l_tickCtr = ticks;
+
+        // overloaded? let the ticks stretch instead of catching up
+        uint64_t const behind = ticklessTicks() - ticks;
+        if (behind > static_cast<uint64_t>(1)) {
+            uint64_t const ns = static_cast<uint64_t>(l_tickStart.tv_nsec)
+                                + (behind * l_tickNsec);
+            l_tickStart.tv_sec += static_cast<time_t>(
+                                      ns / NANOSLEEP_NSEC_PER_SEC);
+            l_tickStart.tv_nsec = static_cast<long>(
+                                      ns % NANOSLEEP_NSEC_PER_SEC);
+        }
+
+        uint64_t const next = ticklessNext();
+        if (next == static_cast<uint64_t>(0)) { // no time events armed?
+            l_tickWake = ~static_cast<uint64_t>(0);
+            pthread_cond_wait(&l_tickCond, &l_tickMutex);
+        }
+        else {
+            l_tickWake = l_tickCtr + next;
+
+            uint64_t const ns = static_cast<uint64_t>(l_tickStart.tv_nsec)
+                                + (l_tickWake * l_tickNsec);
+            struct timespec deadline;
+            deadline.tv_sec  = l_tickStart.tv_sec
+                + static_cast<time_t>(ns / NANOSLEEP_NSEC_PER_SEC);
+            deadline.tv_nsec = static_cast<long>(ns % NANOSLEEP_NSEC_PER_SEC);
+            pthread_cond_timedwait(&l_tickCond, &l_tickMutex, &deadline);
+        }
+    }
+    pthread_mutex_unlock(&l_tickMutex);
+#endif // QF_TICKLESS
+#ifdef QF_MAGAZINE_SIZE
+    // flush the magazines of this thread, see NOTE6 in qf_port.h
+    if (l_magazines != static_cast<QFMagazine *>(0)) {
+        QF_magazineFlush_(l_magazines);
+    }
+#endif // QF_MAGAZINE_SIZE
     onCleanup(); // invoke cleanup callback
     pthread_mutex_destroy(&l_startupMutex);
     pthread_mutex_destroy(&QF_pThreadMutex_);
@@ -153,10 +261,20 @@ void QF_setTickRate(uint32_t ticksPerSec, int_t tickPrio) {
     Q_REQUIRE_ID(300, ticksPerSec != static_cast<uint32_t>(0));
     l_tick.tv_nsec = NANOSLEEP_NSEC_PER_SEC / ticksPerSec;
     l_tickPrio = tickPrio;
+#ifdef QF_TICKLESS
+    l_tickNsec = static_cast<uint64_t>(l_tick.tv_nsec);
+#endif // QF_TICKLESS
 }
 //****************************************************************************
 void QF::stop(void) {
+#ifndef QF_TICKLESS
+    l_isRunning = false; // stop the loop in QF::run()
+#else
+    pthread_mutex_lock(&l_tickMutex);
     l_isRunning = false; // stop the loop in QF::run()
+    pthread_cond_signal(&l_tickCond); // wake up the ticker thread
+    pthread_mutex_unlock(&l_tickMutex);
+#endif // QF_TICKLESS
 }
 //............................................................................
 void QF::thread_(QActive *act) {
@@ -164,12 +282,77 @@ void QF::thread_(QActive *act) {
     pthread_mutex_lock(&l_startupMutex);
     pthread_mutex_unlock(&l_startupMutex);
 
+#ifdef QF_PRIO_BANDS
+    // round-robin among the active objects of a band, see NOTE9 in qf_port.h
+    uint_fast16_t const quantum = bandQuantum_(act->getPrio());
+    uint_fast16_t nEvts = static_cast<uint_fast16_t>(0);
+#endif // QF_PRIO_BANDS
+
+#ifndef QF_DRAIN_MAX
     // loop until m_thread is cleared in QActive::stop()
     do {
         QEvt const *e = act->get_(); // wait for event
-        act->dispatch(e); // dispatch to the active object's state machine
-        gc(e); // check if the event is garbage, and collect it if so
+        if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+            act->dispatch(e); // dispatch to the active object's state machine
+            gc(e); // check if the event is garbage, and collect it if so
+        }
+#ifdef QF_PRIO_BANDS
+        ++nEvts;
+        if ((quantum != static_cast<uint_fast16_t>(0))
+            && (nEvts >= quantum))
+        {
+            nEvts = static_cast<uint_fast16_t>(0);
+            sched_yield(); // let the next active object of the band run
+        }
+#endif // QF_PRIO_BANDS
+    } while (act->m_thread != static_cast<uint8_t>(0));
+#else // drain the event queue in batches, see NOTE7 in qf_port.h
+#ifdef QF_EVT_INLINE
+    QInlineEvt inlineEvt; // copy of the inline event ending a batch
+#endif
+
+    // loop until m_thread is cleared in QActive::stop()
+    do {
+        QEvt const *evts[QF_DRAIN_MAX];
+        uint_fast16_t const n = act->getBatch_(&evts[0],
+                                    static_cast<uint_fast16_t>(QF_DRAIN_MAX));
+#ifdef QF_EVT_INLINE
+        // the buffer of the queue is overwritten by the next get_()
+        if ((n != static_cast<uint_fast16_t>(0))
+            && (evts[n - 1U] == &act->m_eQueue.m_inlineEvt))
+        {
+            inlineEvt = act->m_eQueue.m_inlineEvt;
+            evts[n - 1U] = &inlineEvt;
+        }
+#endif
+        for (uint_fast16_t i = static_cast<uint_fast16_t>(0);
+             (i < n) && (act->m_thread != static_cast<uint8_t>(0));
+             ++i)
+        {
+            act->dispatch(evts[i]); // dispatch the next event of the batch
+
+            // the events posted LIFO since the batch was taken are at the
+            // front of the queue and must be dispatched before the rest
+            while ((act->m_lifoCtr != static_cast<uint_fast16_t>(0))
+                   && (act->m_thread != static_cast<uint8_t>(0)))
+            {
+                QEvt const *e = act->get_(); // the last event posted LIFO
+                act->dispatch(e);
+                gc(e);
+            }
+        }
+        gcBatch_(&evts[0], n); // collect the garbage of the whole batch
+#ifdef QF_PRIO_BANDS
+        nEvts += n;
+        if ((quantum != static_cast<uint_fast16_t>(0))
+            && (nEvts >= quantum))
+        {
+            nEvts = static_cast<uint_fast16_t>(0);
+            sched_yield(); // let the next active object of the band run
+        }
+#endif // QF_PRIO_BANDS
     } while (act->m_thread != static_cast<uint8_t>(0));
+#endif // QF_DRAIN_MAX
 
     QF::remove_(act); // remove this object from the framework
     pthread_cond_destroy(&act->m_osObject); // cleanup the condition variable
@@ -205,7 +388,7 @@ int QF_consoleWaitForKey(void) {
 }
 
 //............................................................................
-void QActive::start(uint_fast8_t prio,
+void QActive::start(QPrio prio,
                     QEvt const *qSto[], uint_fast16_t qLen,
                     void *stkSto, uint_fast16_t stkSize,
                     QEvt const *ie)
@@ -216,7 +399,7 @@ void QActive::start(uint_fast8_t prio,
     pthread_cond_init(&m_osObject, 0);
 
     m_eQueue.init(qSto, qLen);
-    m_prio = static_cast<uint8_t>(prio); // set the QF priority of this AO
+    m_prio = static_cast<QPrioStore>(prio); // set the QF priority of this AO
     QF::add_(this); // make QF aware of this AO
     this->init(ie); // execute initial transition (virtual call)
 
@@ -225,13 +408,27 @@ void QActive::start(uint_fast8_t prio,
 
     // SCHED_FIFO corresponds to real-time preemptive priority-based scheduler
     // NOTE: This scheduling policy requires the superuser privileges
+    pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
     pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
 
     // see NOTE04
     struct sched_param param;
-    param.sched_priority = prio
-                           + (sched_get_priority_max(SCHED_FIFO)
-                              - QF_MAX_ACTIVE - 3);
+    int const fifoMin = sched_get_priority_min(SCHED_FIFO);
+    int const fifoLevels = sched_get_priority_max(SCHED_FIFO) - 3
+                           - fifoMin + 1;
+#ifdef QF_PRIO_BANDS
+    // all active objects in a band share one priority, see NOTE9 in qf_port.h
+    prio = QF::bandTop_(prio);
+#endif
+    if (fifoLevels >= static_cast<int>(QF_MAX_ACTIVE)) {
+        param.sched_priority = static_cast<int>(prio)
+                               + (fifoMin + fifoLevels - 1
+                                  - static_cast<int>(QF_MAX_ACTIVE));
+    }
+    else { // more active objects than p-thread priorities
+        param.sched_priority = fifoMin
+            + static_cast<int>(((prio - 1U) * fifoLevels) / QF_MAX_ACTIVE);
+    }
 
     pthread_attr_setschedparam(&attr, &param);
     pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
@@ -264,12 +461,941 @@ void QActive::stop(void) {
     m_thread = static_cast<uint8_t>(0); // stop the QF::thread_() loop
 }
 
+#ifdef QF_MPSC_EQUEUE
+//****************************************************************************
+// Lock-free multiple-producer single-consumer event queue, see NOTE07
+
+//............................................................................
+static void mpscWait(int volatile * const waiting, pthread_cond_t * const cv) {
+#ifdef __linux__
+    (void)cv; // unused parameter
+    syscall(SYS_futex, const_cast<int *>(waiting), FUTEX_WAIT_PRIVATE, 1,
+            static_cast<struct timespec *>(0), static_cast<int *>(0), 0);
+#else // no futex--fall back to the condition variable of the AO
+    pthread_mutex_lock(&QF_pThreadMutex_);
+    while (*waiting != 0) {
+        pthread_cond_wait(cv, &QF_pThreadMutex_);
+    }
+    pthread_mutex_unlock(&QF_pThreadMutex_);
+#endif // __linux__
+}
+//............................................................................
+static void mpscWake(int volatile * const waiting, pthread_cond_t * const cv) {
+#ifdef __linux__
+    (void)cv; // unused parameter
+    syscall(SYS_futex, const_cast<int *>(waiting), FUTEX_WAKE_PRIVATE, 1,
+            static_cast<struct timespec *>(0), static_cast<int *>(0), 0);
+#else // no futex--fall back to the condition variable of the AO
+    (void)waiting; // unused parameter
+    pthread_mutex_lock(&QF_pThreadMutex_);
+    pthread_cond_signal(cv);
+    pthread_mutex_unlock(&QF_pThreadMutex_);
+#endif // __linux__
+}
+
+//............................................................................
+static void mpscRefInc(QEvt const * const e) {
+#ifndef QF_EVT_REF_ATOMIC
+    QF_CRIT_STAT_
+    QF_OBJ_CRIT_ENTRY_(QF_EVT_LOCK_(e));
+    QF_EVT_REF_CTR_INC_(e);
+    QF_OBJ_CRIT_EXIT_(QF_EVT_LOCK_(e));
+#else
+    QF_EVT_REF_CTR_INC_(e); // atomic, no critical section needed
+#endif // QF_EVT_REF_ATOMIC
+}
+
+//............................................................................
+QMPSCQueue::QMPSCQueue(void)
+  : m_ring(static_cast<QEvt const * volatile *>(0)),
+    m_extra(static_cast<QEvt const *>(0)),
+    m_end(static_cast<QEQueueCtr>(0)),
+    m_head(static_cast<QEQueueCtr>(0)),
+    m_tail(static_cast<QEQueueCtr>(0)),
+    m_nFree(static_cast<QEQueueCtr>(0)),
+    m_nMin(static_cast<QEQueueCtr>(0)),
+    m_waiting(0),
+    m_aux(static_cast<QEQueueCtr>(0))
+{}
+//............................................................................
+void QMPSCQueue::init(QEvt const *qSto[], uint_fast16_t const qLen) {
+    m_ring  = &qSto[0];
+    m_extra = static_cast<QEvt const *>(0);
+    m_end   = static_cast<QEQueueCtr>(qLen);
+    for (uint_fast16_t i = static_cast<uint_fast16_t>(0); i < qLen; ++i) {
+        m_ring[i] = static_cast<QEvt const *>(0); // all slots are free
+    }
+    m_head  = static_cast<QEQueueCtr>(0);
+    m_tail  = static_cast<QEQueueCtr>(0);
+    m_nFree = static_cast<QEQueueCtr>(
+                  qLen + static_cast<uint_fast16_t>(1)); // +1 for m_extra
+    m_nMin  = m_nFree;
+    m_waiting = 0;
+}
+
+//............................................................................
+#ifndef Q_SPY
+bool QActive::post_(QEvt const * const e, uint_fast16_t const margin)
+#else
+bool QActive::post_(QEvt const * const e, uint_fast16_t const margin,
+                    void const * const sender)
+#endif
+{
+    /// @pre event pointer must be valid
+    Q_REQUIRE_ID(100, e != static_cast<QEvt const *>(0));
+
+    // reserve one free slot (if available with the requested margin)
+    QEQueueCtr nFree = __atomic_load_n(&m_eQueue.m_nFree, __ATOMIC_RELAXED);
+    bool status;
+    for (;;) {
+        if (margin == QF_NO_MARGIN) {
+            status = (nFree > static_cast<QEQueueCtr>(0));
+            Q_ASSERT_ID(110, status); // must be able to post the event
+        }
+        else {
+            status = (nFree > static_cast<QEQueueCtr>(margin));
+        }
+
+        if (!status) {
+            break; // cannot post, but don't assert
+        }
+        if (__atomic_compare_exchange_n(&m_eQueue.m_nFree, &nFree,
+                nFree - static_cast<QEQueueCtr>(1), false,
+                __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        {
+            break; // slot reserved
+        }
+    }
+
+    // is it a dynamic event?
+    if (e->poolId_ != static_cast<uint8_t>(0)) {
+        mpscRefInc(e); // increment the reference counter
+    }
+
+    if (status) { // can post the event?
+        QS_CRIT_STAT_
+
+        --nFree;  // one free slot just reserved
+
+        // update the low-watermark
+        QEQueueCtr nMin = __atomic_load_n(&m_eQueue.m_nMin, __ATOMIC_RELAXED);
+        while ((nMin > nFree)
+               && !__atomic_compare_exchange_n(&m_eQueue.m_nMin, &nMin, nFree,
+                       false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {}
+
+        QS_BEGIN_(QS_QF_ACTIVE_POST_FIFO,
+                  QS::priv_.locFilter[QS::AO_OBJ], this)
+            QS_TIME_();               // timestamp
+            QS_OBJ_(sender);          // the sender object
+            QS_SIG_(e->sig);          // the signal of the event
+            QS_OBJ_(this);            // this active object
+            QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr of the evt
+            QS_EQC_(nFree);           // number of free entries
+            QS_EQC_(m_eQueue.m_nMin); // min number of free entries
+        QS_END_()
+
+        // claim the tail slot (the ring is used counter-clockwise)
+        QEQueueCtr tail = __atomic_load_n(&m_eQueue.m_tail, __ATOMIC_RELAXED);
+        QEQueueCtr next;
+        do {
+            next = (tail == static_cast<QEQueueCtr>(0))
+                   ? m_eQueue.m_end
+                   : (tail - static_cast<QEQueueCtr>(1));
+        } while (!__atomic_compare_exchange_n(&m_eQueue.m_tail, &tail, next,
+                     false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+        // publish the event in the claimed slot
+        __atomic_store_n(m_eQueue.slot(tail), QF_EVT_TO_SLOT_(e),
+                         __ATOMIC_RELEASE);
+
+        // was the queue empty? (only then the consumer might be sleeping)
+        if (nFree == m_eQueue.m_end) {
+            if (__atomic_exchange_n(&m_eQueue.m_waiting, 0, __ATOMIC_SEQ_CST)
+                != 0)
+            {
+                mpscWake(&m_eQueue.m_waiting, &m_osObject);
+            }
+        }
+    }
+    else { // cannot post the event
+        QS_CRIT_STAT_
+        QS_BEGIN_(QS_QF_ACTIVE_POST_ATTEMPT,
+                  QS::priv_.locFilter[QS::AO_OBJ], this)
+            QS_TIME_();           // timestamp
+            QS_OBJ_(sender);      // the sender object
+            QS_SIG_(e->sig);      // the signal of the event
+            QS_OBJ_(this);        // this active object
+            QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr of the evt
+            QS_EQC_(nFree);       // number of free entries
+            QS_EQC_(static_cast<QEQueueCtr>(margin)); // margin requested
+        QS_END_()
+
+        QF::gc(e); // recycle the event to avoid a leak
+    }
+
+    return status;
+}
+//............................................................................
+#ifndef Q_SPY
+bool QActive::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                         uint_fast16_t const margin)
+#else
+bool QActive::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                         uint_fast16_t const margin,
+                         void const * const sender)
+#endif
+{
+    uint_fast16_t i;
+
+    /// @pre the array of events must be valid and not empty
+    Q_REQUIRE_ID(600, (evts != static_cast<QEvt const * const *>(0))
+                      && (n != static_cast<uint_fast16_t>(0)));
+
+    // reserve n free slots at once (all or nothing)
+    QEQueueCtr nFree = __atomic_load_n(&m_eQueue.m_nFree, __ATOMIC_RELAXED);
+    bool status;
+    for (;;) {
+        if (margin == QF_NO_MARGIN) {
+            status = (static_cast<uint_fast16_t>(nFree) >= n);
+            Q_ASSERT_ID(610, status); // must be able to post the events
+        }
+        else {
+            status = (static_cast<uint_fast32_t>(nFree)
+                      >= (static_cast<uint_fast32_t>(n)
+                          + static_cast<uint_fast32_t>(margin)));
+        }
+
+        if (!status) {
+            break; // cannot post, but don't assert
+        }
+        if (__atomic_compare_exchange_n(&m_eQueue.m_nFree, &nFree,
+                nFree - static_cast<QEQueueCtr>(n), false,
+                __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        {
+            break; // slots reserved
+        }
+    }
+
+    for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        // is it a dynamic event?
+        if (evts[i]->poolId_ != static_cast<uint8_t>(0)) {
+            mpscRefInc(evts[i]); // increment the reference counter
+        }
+    }
+
+    if (status) { // can post the events?
+        QS_CRIT_STAT_
+
+        // was the queue empty? (only then the consumer might be sleeping)
+        bool const wasEmpty =
+            (nFree == (m_eQueue.m_end + static_cast<QEQueueCtr>(1)));
+        nFree -= static_cast<QEQueueCtr>(n);  // n free slots just reserved
+
+        // update the low-watermark
+        QEQueueCtr nMin = __atomic_load_n(&m_eQueue.m_nMin, __ATOMIC_RELAXED);
+        while ((nMin > nFree)
+               && !__atomic_compare_exchange_n(&m_eQueue.m_nMin, &nMin, nFree,
+                       false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {}
+
+        QS_BEGIN_(QS_QF_POST_BATCH, QS::priv_.locFilter[QS::AO_OBJ], this)
+            QS_TIME_();               // timestamp
+            QS_OBJ_(sender);          // the sender object
+            QS_OBJ_(this);            // this active object
+            QS_EQC_(static_cast<QEQueueCtr>(n)); // number of events posted
+            QS_EQC_(nFree);           // number of free entries
+            QS_EQC_(m_eQueue.m_nMin); // min number of free entries
+        QS_END_()
+
+        // claim n consecutive tail slots (the ring is used counter-clockwise)
+        // at once, so that no other producer can interleave with the batch
+        QEQueueCtr const nTot = m_eQueue.m_end + static_cast<QEQueueCtr>(1);
+        QEQueueCtr tail = __atomic_load_n(&m_eQueue.m_tail, __ATOMIC_RELAXED);
+        QEQueueCtr next;
+        do {
+            next = (tail >= static_cast<QEQueueCtr>(n))
+                   ? static_cast<QEQueueCtr>(tail - n)
+                   : static_cast<QEQueueCtr>((tail + nTot) - n);
+        } while (!__atomic_compare_exchange_n(&m_eQueue.m_tail, &tail, next,
+                     false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+        // publish the events in the claimed slots, in order
+        for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+            __atomic_store_n(m_eQueue.slot(tail), QF_EVT_TO_SLOT_(evts[i]),
+                             __ATOMIC_RELEASE);
+            tail = (tail == static_cast<QEQueueCtr>(0))
+                   ? m_eQueue.m_end
+                   : (tail - static_cast<QEQueueCtr>(1));
+        }
+
+        if (wasEmpty) { // signal the consumer only once
+            if (__atomic_exchange_n(&m_eQueue.m_waiting, 0, __ATOMIC_SEQ_CST)
+                != 0)
+            {
+                mpscWake(&m_eQueue.m_waiting, &m_osObject);
+            }
+        }
+    }
+    else { // cannot post the events
+        QS_CRIT_STAT_
+        QS_BEGIN_(QS_QF_ACTIVE_POST_ATTEMPT,
+                  QS::priv_.locFilter[QS::AO_OBJ], this)
+            QS_TIME_();           // timestamp
+            QS_OBJ_(sender);      // the sender object
+            QS_SIG_(evts[0]->sig);// the signal of the first event
+            QS_OBJ_(this);        // this active object
+            QS_2U8_(evts[0]->poolId_, evts[0]->refCtr_); // of the first evt
+            QS_EQC_(nFree);       // number of free entries
+            QS_EQC_(static_cast<QEQueueCtr>(margin)); // margin requested
+        QS_END_()
+
+        for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+            QF::gc(evts[i]); // recycle the event to avoid a leak
+        }
+    }
+
+    return status;
+}
+//............................................................................
+// NOTE: must be called only from the thread of this active object
+void QActive::postLIFO(QEvt const * const e) {
+    QS_CRIT_STAT_
+
+    // reserve one free slot
+    QEQueueCtr nFree = __atomic_load_n(&m_eQueue.m_nFree, __ATOMIC_RELAXED);
+    do {
+        // the queue must be able to accept the event (cannot overflow)
+        Q_ASSERT_ID(210, nFree != static_cast<QEQueueCtr>(0));
+    } while (!__atomic_compare_exchange_n(&m_eQueue.m_nFree, &nFree,
+                 nFree - static_cast<QEQueueCtr>(1), false,
+                 __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+    --nFree;  // one free slot just reserved
+
+    // is it a dynamic event?
+    if (e->poolId_ != static_cast<uint8_t>(0)) {
+        mpscRefInc(e); // increment the reference counter
+    }
+
+    // update the low-watermark
+    QEQueueCtr nMin = __atomic_load_n(&m_eQueue.m_nMin, __ATOMIC_RELAXED);
+    while ((nMin > nFree)
+           && !__atomic_compare_exchange_n(&m_eQueue.m_nMin, &nMin, nFree,
+                   false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {}
+
+    QS_BEGIN_(QS_QF_ACTIVE_POST_LIFO, QS::priv_.locFilter[QS::AO_OBJ], this)
+        QS_TIME_();                      // timestamp
+        QS_SIG_(e->sig);                 // the signal of this event
+        QS_OBJ_(this);                   // this active object
+        QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr of the evt
+        QS_EQC_(nFree);                  // number of free entries
+        QS_EQC_(m_eQueue.m_nMin);        // min number of free entries
+    QS_END_()
+
+    // insert the event in front of the head slot (clockwise), which is
+    // free, because the slot has been reserved and only this thread
+    // (the consumer) moves the head
+    QEQueueCtr head = m_eQueue.m_head;
+    head = (head == m_eQueue.m_end)
+           ? static_cast<QEQueueCtr>(0)
+           : (head + static_cast<QEQueueCtr>(1));
+    __atomic_store_n(m_eQueue.slot(head), QF_EVT_TO_SLOT_(e),
+                     __ATOMIC_RELAXED);
+    m_eQueue.m_head = head;
+#ifdef QF_DRAIN_MAX
+    ++m_lifoCtr; // one more event at the front, see QF::thread_()
+#endif
+}
+//............................................................................
+QEvt const *QActive::get_(void) {
+    QEQueueCtr const nTot = m_eQueue.m_end + static_cast<QEQueueCtr>(1);
+    QEvt const *e;
+    QS_CRIT_STAT_
+
+    for (;;) { // wait for the head slot to be filled
+        e = __atomic_load_n(m_eQueue.slot(m_eQueue.m_head), __ATOMIC_ACQUIRE);
+        if (e != static_cast<QEvt const *>(0)) {
+            break;
+        }
+
+        // no slots reserved by the producers (the queue is truly empty)?
+        if (__atomic_load_n(&m_eQueue.m_nFree, __ATOMIC_SEQ_CST) == nTot) {
+            __atomic_store_n(&m_eQueue.m_waiting, 1, __ATOMIC_SEQ_CST);
+
+            // re-check after announcing the intention to sleep
+            if (__atomic_load_n(&m_eQueue.m_nFree, __ATOMIC_SEQ_CST) == nTot) {
+                mpscWait(&m_eQueue.m_waiting, &m_osObject);
+            }
+            __atomic_store_n(&m_eQueue.m_waiting, 0, __ATOMIC_RELAXED);
+        }
+        else { // a producer has reserved a slot, but not filled it yet
+            sched_yield();
+        }
+    }
+
+    // free the head slot and advance the head (counter-clockwise)
+    __atomic_store_n(m_eQueue.slot(m_eQueue.m_head),
+                     static_cast<QEvt const *>(0), __ATOMIC_RELAXED);
+    m_eQueue.m_head = (m_eQueue.m_head == static_cast<QEQueueCtr>(0))
+                      ? m_eQueue.m_end
+                      : (m_eQueue.m_head - static_cast<QEQueueCtr>(1));
+
+    // return the slot to the producers
+    QEQueueCtr nFree = __atomic_add_fetch(&m_eQueue.m_nFree,
+                           static_cast<QEQueueCtr>(1), __ATOMIC_SEQ_CST);
+
+    e = QF_EVT_FROM_SLOT_(e, m_eQueue.m_inlineEvt); // unpack inline event
+#ifdef QF_DRAIN_MAX
+    if (m_lifoCtr != static_cast<uint_fast16_t>(0)) { // event posted LIFO?
+        --m_lifoCtr; // one less event at the front, see QF::thread_()
+    }
+#endif
+
+    if (nFree < nTot) { // any more events in the queue?
+        QS_BEGIN_(QS_QF_ACTIVE_GET, QS::priv_.locFilter[QS::AO_OBJ], this)
+            QS_TIME_();                      // timestamp
+            QS_SIG_(e->sig);                 // the signal of this event
+            QS_OBJ_(this);                   // this active object
+            QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr of the evt
+            QS_EQC_(nFree);                  // number of free entries
+        QS_END_()
+    }
+    else {
+        QS_BEGIN_(QS_QF_ACTIVE_GET_LAST,
+                  QS::priv_.locFilter[QS::AO_OBJ], this)
+            QS_TIME_();                      // timestamp
+            QS_SIG_(e->sig);                 // the signal of this event
+            QS_OBJ_(this);                   // this active object
+            QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr of the evt
+        QS_END_()
+    }
+
+#ifdef QF_PS_BROADCAST
+    // the doorbell of a broadcast channel? see NOTE5 in qf_ps.cpp
+    if (e->sig == QF_BCAST_SIG_) {
+        e = static_cast<QBroadcast *>(QF_EVT_CONST_CAST_(e))->take_(this);
+    }
+#endif // QF_PS_BROADCAST
+    return e;
+}
+#ifdef QF_DRAIN_MAX
+//............................................................................
+// NOTE: the queue is lock-free, so only the sleeping is avoided for the
+// events that have been already published by the producers
+uint_fast16_t QActive::getBatch_(QEvt const *evts[], uint_fast16_t const n) {
+    uint_fast16_t i = static_cast<uint_fast16_t>(0);
+
+    /// @pre at least one event must be requested
+    Q_REQUIRE_ID(700, n != static_cast<uint_fast16_t>(0));
+
+    QEvt const *e;
+    do {
+        e = get_(); // only the first call can block
+        if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+            evts[i] = e;
+            ++i;
+        }
+    } while ((i < n)
+             && (!QF_EVT_IS_INLINE_(e, m_eQueue.m_inlineEvt))
+             && (__atomic_load_n(m_eQueue.slot(m_eQueue.m_head),
+                                 __ATOMIC_RELAXED)
+                 != static_cast<QEvt const *>(0)));
+
+    // postLIFO() is called only from this thread, see NOTE3 in qf_port.h
+    m_lifoCtr = static_cast<uint_fast16_t>(0); // no events posted LIFO yet
+    return i;
+}
+#endif // QF_DRAIN_MAX
+//............................................................................
+uint_fast16_t QF::getQueueMin(QPrio const prio) {
+    Q_REQUIRE_ID(400, (prio <= static_cast<QPrio>(QF_MAX_ACTIVE))
+                      && (active_[prio] != static_cast<QActive *>(0)));
+
+    return static_cast<uint_fast16_t>(__atomic_load_n(
+               &active_[prio]->m_eQueue.m_nMin, __ATOMIC_RELAXED));
+}
+
+//............................................................................
+// NOTE: the QTicker uses m_eQueue.m_aux for the tick rate and
+// m_eQueue.m_nMin for the number of ticks since the last dispatch
+QTicker::QTicker(uint_fast8_t const tickRate)
+  : QActive(Q_STATE_CAST(0))
+{
+    m_eQueue.m_aux = static_cast<QEQueueCtr>(tickRate);
+}
+//............................................................................
+void QTicker::init(QEvt const * const /*e*/) {
+    m_eQueue.m_nMin = static_cast<QEQueueCtr>(0);
+}
+//............................................................................
+void QTicker::dispatch(QEvt const * const /*e*/) {
+    // # ticks since the last call
+    QEQueueCtr n = __atomic_exchange_n(&m_eQueue.m_nMin,
+                       static_cast<QEQueueCtr>(0), __ATOMIC_ACQ_REL);
+
+    for (; n > static_cast<QEQueueCtr>(0); --n) {
+        QF::TICK_X(static_cast<uint_fast8_t>(m_eQueue.m_aux), this);
+    }
+}
+//............................................................................
+#ifndef Q_SPY
+bool QTicker::post_(QEvt const * const /*e*/, uint_fast16_t const /*margin*/)
+#else
+bool QTicker::post_(QEvt const * const /*e*/, uint_fast16_t const /*margin*/,
+                    void const * const sender)
+#endif
+{
+    QS_CRIT_STAT_
+
+    // account for one more tick; is it the first tick since the dispatch?
+    if (__atomic_fetch_add(&m_eQueue.m_nMin, static_cast<QEQueueCtr>(1),
+                           __ATOMIC_ACQ_REL) == static_cast<QEQueueCtr>(0))
+    {
+#ifdef Q_EVT_CTOR
+        static QEvt const tickEvt(static_cast<QSignal>(0),
+                                  QEvt::STATIC_EVT);
+#else
+        static QEvt const tickEvt = { static_cast<QSignal>(0),
+                                      static_cast<uint8_t>(0),
+                                      static_cast<uint8_t>(0) };
+#endif // Q_EVT_CTOR
+
+        // the tick event is the only event in the queue
+        QEQueueCtr nFree = __atomic_sub_fetch(&m_eQueue.m_nFree,
+                               static_cast<QEQueueCtr>(1), __ATOMIC_SEQ_CST);
+        Q_ASSERT_ID(910, nFree == m_eQueue.m_end);
+
+        QEQueueCtr tail = m_eQueue.m_tail;
+        m_eQueue.m_tail = (tail == static_cast<QEQueueCtr>(0))
+                          ? m_eQueue.m_end
+                          : (tail - static_cast<QEQueueCtr>(1));
+        __atomic_store_n(m_eQueue.slot(tail), &tickEvt, __ATOMIC_RELEASE);
+
+        if (__atomic_exchange_n(&m_eQueue.m_waiting, 0, __ATOMIC_SEQ_CST)
+            != 0)
+        {
+            mpscWake(&m_eQueue.m_waiting, &m_osObject);
+        }
+    }
+
+    QS_BEGIN_(QS_QF_ACTIVE_POST_FIFO, QS::priv_.locFilter[QS::AO_OBJ], this)
+        QS_TIME_();               // timestamp
+        QS_OBJ_(sender);          // the sender object
+        QS_SIG_(static_cast<QSignal>(0)); // the signal of the event
+        QS_OBJ_(this);            // this active object
+        QS_2U8_(static_cast<uint8_t>(0),
+                static_cast<uint8_t>(0)); // pool Id & refCtr of the evt
+        QS_EQC_(static_cast<uint8_t>(0)); // number of free entries
+        QS_EQC_(static_cast<uint8_t>(0)); // min number of free entries
+    QS_END_()
+
+    return true; // the event is always posted correctly
+}
+//............................................................................
+void QTicker::postLIFO(QEvt const * const /*e*/) {
+    Q_ERROR_ID(900); // operation not allowed
+}
+//............................................................................
+#ifndef Q_SPY
+bool QTicker::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                         uint_fast16_t const margin)
+#else
+bool QTicker::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                         uint_fast16_t const margin,
+                         void const * const sender)
+#endif
+{
+    uint_fast16_t i;
+    for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        (void)POST_X(evts[i], margin, sender); // each event is one tick
+    }
+    return true; // the events are always posted correctly
+}
+
+#endif // QF_MPSC_EQUEUE
+
+#ifdef QF_MAGAZINE_SIZE
+//****************************************************************************
+// Per-thread magazines of free event blocks, see NOTE6 in qf_port.h
+
+//............................................................................
+static void magazineCleanup(void *mags) {
+    QF_magazineFlush_(static_cast<QFMagazine *>(mags));
+    free(mags);
+}
+//............................................................................
+QFMagazine *QF_magazines_(void) {
+    if (l_magazines == static_cast<QFMagazine *>(0)) { // first use?
+        l_magazines = static_cast<QFMagazine *>(
+            calloc(static_cast<size_t>(QF_MAX_EPOOL), sizeof(QFMagazine)));
+        if (l_magazines != static_cast<QFMagazine *>(0)) {
+            pthread_setspecific(l_magazineKey, l_magazines);
+        }
+    }
+    return l_magazines; // NULL: allocate directly from the event pools
+}
+
+#endif // QF_MAGAZINE_SIZE
+
+#ifdef QF_LOCKFREE_EPOOL
+//****************************************************************************
+// Lock-free event pool, see NOTE5 in qf_port.h
+
+//............................................................................
+QLFPool::QLFPool(void)
+  : m_start(static_cast<void *>(0)),
+    m_end(static_cast<void *>(0)),
+    m_head(static_cast<uint64_t>(0)),
+    m_blockSize(static_cast<QMPoolSize>(0)),
+    m_nTot(static_cast<QMPoolCtr>(0)),
+    m_nFree(static_cast<QMPoolCtr>(0)),
+    m_nMin(static_cast<QMPoolCtr>(0))
+{}
+//............................................................................
+void QLFPool::init(void * const poolSto, uint_fast32_t poolSize,
+                   uint_fast16_t blockSize)
+{
+    /// @pre The memory block must be valid and
+    /// the poolSize must fit at least one free block
+    Q_REQUIRE_ID(700, (poolSto != static_cast<void *>(0))
+        && (poolSize >= static_cast<uint_fast32_t>(sizeof(QFreeBlock))));
+
+    // round up the blockSize to fit an integer number of pointers...
+    m_blockSize = static_cast<QMPoolSize>(sizeof(QFreeBlock));
+    while (m_blockSize < static_cast<QMPoolSize>(blockSize)) {
+        m_blockSize += static_cast<QMPoolSize>(sizeof(QFreeBlock));
+    }
+    blockSize = static_cast<uint_fast16_t>(m_blockSize);
+
+    // the whole pool buffer must fit at least one rounded-up block
+    Q_ASSERT_ID(710, poolSize >= static_cast<uint_fast32_t>(blockSize));
+
+    // chain all blocks together by their indices + 1 (0 terminates)...
+    uint8_t * const sto = static_cast<uint8_t *>(poolSto);
+    uint32_t n = static_cast<uint32_t>(0);
+    while (poolSize >= static_cast<uint_fast32_t>(blockSize)) {
+        ++n;
+        *link(&QF_PTR_AT_(sto, (n - 1U) * blockSize)) = n + 1U;
+        poolSize -= static_cast<uint_fast32_t>(blockSize);
+    }
+    *link(&QF_PTR_AT_(sto, (n - 1U) * blockSize)) = 0U; // the last link
+
+    m_start = poolSto;
+    m_end   = &QF_PTR_AT_(sto, (n - 1U) * blockSize); // the last block
+    m_head  = static_cast<uint64_t>(1); // tag 0, the first block on top
+    m_nTot  = static_cast<QMPoolCtr>(n);
+    m_nFree = m_nTot; // all blocks are free
+    m_nMin  = m_nTot; // the minimum number of free blocks
+}
+//............................................................................
+void *QLFPool::get(uint_fast16_t const margin) {
+    QS_CRIT_STAT_
+
+    // reserve one free block (if available with the requested margin)
+    QMPoolCtr nFree = __atomic_load_n(&m_nFree, __ATOMIC_RELAXED);
+    bool status;
+    for (;;) {
+        status = (nFree > static_cast<QMPoolCtr>(margin));
+        if (!status) {
+            break; // don't have enough free blocks at this point
+        }
+        if (__atomic_compare_exchange_n(&m_nFree, &nFree,
+                nFree - static_cast<QMPoolCtr>(1), false,
+                __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+        {
+            break; // block reserved
+        }
+    }
+
+    void *fb;
+    if (status) {
+        --nFree; // one free block less
+
+        // update the low-watermark
+        QMPoolCtr nMin = __atomic_load_n(&m_nMin, __ATOMIC_RELAXED);
+        while ((nMin > nFree)
+               && !__atomic_compare_exchange_n(&m_nMin, &nMin, nFree,
+                       false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {}
+
+        fb = pop(); // pop the reserved block from the free-block stack
+
+        QS_BEGIN_(QS_QF_MPOOL_GET, QS::priv_.locFilter[QS::MP_OBJ], this)
+            QS_TIME_();        // timestamp
+            QS_OBJ_(this);     // this memory pool
+            QS_MPC_(nFree);    // the number of free blocks in the pool
+            QS_MPC_(m_nMin);   // the mninimum # free blocks in the pool
+        QS_END_()
+    }
+    else {
+        fb = static_cast<void *>(0);
+
+        QS_BEGIN_(QS_QF_MPOOL_GET_ATTEMPT,
+                  QS::priv_.locFilter[QS::MP_OBJ], m_start)
+            QS_TIME_();        // timestamp
+            QS_OBJ_(m_start);  // the memory managed by this pool
+            QS_MPC_(nFree);    // the # free blocks in the pool
+            QS_MPC_(margin);   // the requested margin
+        QS_END_()
+    }
+
+    return fb; // return the block or NULL pointer to the caller
+}
+//............................................................................
+void *QLFPool::pop(void) {
+    uint64_t head = __atomic_load_n(&m_head, __ATOMIC_SEQ_CST);
+    uint64_t next;
+    void *fb;
+    do {
+        uint32_t const top = static_cast<uint32_t>(head);
+
+        // the reserved block must be in the stack
+        Q_ASSERT_ID(720, top != 0U);
+
+        fb = &QF_PTR_AT_(static_cast<uint8_t *>(m_start),
+                         (top - 1U) * m_blockSize);
+
+        // NOTE: the link might be already overwritten when the block
+        // has been popped by another thread, but then the tag of the
+        // head has changed and the compare-and-swap below fails
+        next = ((head & 0xFFFFFFFF00000000ULL) + 0x100000000ULL)
+               | static_cast<uint64_t>(
+                     __atomic_load_n(link(fb), __ATOMIC_RELAXED));
+    } while (!__atomic_compare_exchange_n(&m_head, &head, next, false,
+                 __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST));
+
+    // the next free block must be in range
+    //
+    // NOTE: the next free block index can fall out of range
+    // when the client code writes past the memory block, thus
+    // corrupting the next block.
+    Q_ASSERT_ID(730, static_cast<uint32_t>(next)
+                     <= static_cast<uint32_t>(m_nTot));
+
+    return fb;
+}
+//............................................................................
+void QLFPool::put(void * const b) {
+    /// @pre # free blocks cannot exceed the total # blocks and
+    /// the block pointer must be in range to come from this pool.
+    Q_REQUIRE_ID(740, (m_nFree < m_nTot)
+                      && QF_PTR_RANGE_(b, m_start, m_end));
+    QS_CRIT_STAT_
+
+    uint32_t const idx = static_cast<uint32_t>(
+        (static_cast<uint8_t *>(b) - static_cast<uint8_t *>(m_start))
+        / m_blockSize) + 1U;
+
+    // push the block onto the free-block stack...
+    uint64_t head = __atomic_load_n(&m_head, __ATOMIC_RELAXED);
+    uint64_t next;
+    do {
+        __atomic_store_n(link(b), static_cast<uint32_t>(head),
+                         __ATOMIC_RELAXED);
+        next = ((head & 0xFFFFFFFF00000000ULL) + 0x100000000ULL)
+               | static_cast<uint64_t>(idx);
+    } while (!__atomic_compare_exchange_n(&m_head, &head, next, false,
+                 __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+
+    // ... and only then make it available for reservation
+    (void)__atomic_add_fetch(&m_nFree, static_cast<QMPoolCtr>(1),
+                             __ATOMIC_SEQ_CST);
+
+    QS_BEGIN_(QS_QF_MPOOL_PUT, QS::priv_.locFilter[QS::MP_OBJ], this)
+        QS_TIME_();       // timestamp
+        QS_OBJ_(this);    // this memory pool
+        QS_MPC_(m_nFree); // the number of free blocks in the pool
+    QS_END_()
+}
+#if (defined QF_MAGAZINE_SIZE) || (defined QF_DRAIN_MAX)
+//............................................................................
+uint_fast16_t QLFPool::getMany(void *blk[], uint_fast16_t const n) {
+    QS_CRIT_STAT_
+
+    // reserve up to n free blocks at once
+    QMPoolCtr nFree = __atomic_load_n(&m_nFree, __ATOMIC_RELAXED);
+    QMPoolCtr k;
+    do {
+        k = (nFree < static_cast<QMPoolCtr>(n))
+            ? nFree
+            : static_cast<QMPoolCtr>(n);
+    } while ((k != static_cast<QMPoolCtr>(0))
+             && !__atomic_compare_exchange_n(&m_nFree, &nFree, nFree - k,
+                    false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+    nFree -= k;
+
+    // update the low-watermark
+    QMPoolCtr nMin = __atomic_load_n(&m_nMin, __ATOMIC_RELAXED);
+    while ((nMin > nFree)
+           && !__atomic_compare_exchange_n(&m_nMin, &nMin, nFree,
+                   false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {}
+
+    for (QMPoolCtr i = static_cast<QMPoolCtr>(0); i < k; ++i) {
+        blk[i] = pop(); // pop the reserved block from the free-block stack
+
+        QS_BEGIN_(QS_QF_MPOOL_GET, QS::priv_.locFilter[QS::MP_OBJ], this)
+            QS_TIME_();             // timestamp
+            QS_OBJ_(this);          // this memory pool
+            QS_MPC_(nFree + k - i - static_cast<QMPoolCtr>(1)); // # free
+            QS_MPC_(m_nMin);        // the mninimum # free blocks in the pool
+        QS_END_()
+    }
+    return static_cast<uint_fast16_t>(k);
+}
+//............................................................................
+void QLFPool::putMany(void * const blk[], uint_fast16_t const n) {
+    /// @pre at least one block must be recycled
+    Q_REQUIRE_ID(750, n != static_cast<uint_fast16_t>(0));
+    QS_CRIT_STAT_
+
+    // chain the blocks together by their indices + 1...
+    uint32_t first = 0U;
+    for (uint_fast16_t i = n; i > static_cast<uint_fast16_t>(0); --i) {
+        /// @pre the block pointers must be in range to come from this pool
+        Q_REQUIRE_ID(760, QF_PTR_RANGE_(blk[i - 1U], m_start, m_end));
+
+        *link(blk[i - 1U]) = first;
+        first = static_cast<uint32_t>(
+            (static_cast<uint8_t *>(blk[i - 1U])
+             - static_cast<uint8_t *>(m_start)) / m_blockSize) + 1U;
+    }
+
+    // ... and push the whole chain onto the free-block stack at once
+    uint64_t head = __atomic_load_n(&m_head, __ATOMIC_RELAXED);
+    uint64_t next;
+    do {
+        __atomic_store_n(link(blk[n - 1U]), static_cast<uint32_t>(head),
+                         __ATOMIC_RELAXED);
+        next = ((head & 0xFFFFFFFF00000000ULL) + 0x100000000ULL)
+               | static_cast<uint64_t>(first);
+    } while (!__atomic_compare_exchange_n(&m_head, &head, next, false,
+                 __ATOMIC_SEQ_CST, __ATOMIC_RELAXED));
+
+    // only then make the blocks available for reservation
+    QMPoolCtr nFree = __atomic_add_fetch(&m_nFree, static_cast<QMPoolCtr>(n),
+                                         __ATOMIC_SEQ_CST);
+    (void)nFree; // unused without Q_SPY
+
+    for (uint_fast16_t i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        QS_BEGIN_(QS_QF_MPOOL_PUT, QS::priv_.locFilter[QS::MP_OBJ], this)
+            QS_TIME_();    // timestamp
+            QS_OBJ_(this); // this memory pool
+            QS_MPC_(nFree - static_cast<QMPoolCtr>(n - 1U - i)); // # free
+        QS_END_()
+    }
+}
+#endif // QF_MAGAZINE_SIZE || QF_DRAIN_MAX
+//............................................................................
+uint_fast16_t QF::getPoolMin(uint_fast8_t const poolId) {
+    /// @pre the poolId must be in range
+    Q_REQUIRE_ID(770, (static_cast<uint_fast8_t>(1) <= poolId)
+                       && (poolId <= QF_maxPool_));
+
+    return static_cast<uint_fast16_t>(__atomic_load_n(
+        &QF_pool_[poolId - static_cast<uint_fast8_t>(1)].m_nMin,
+        __ATOMIC_RELAXED));
+}
+
+#endif // QF_LOCKFREE_EPOOL
+
 //............................................................................
 static void *ao_thread(void *arg) { // the expected POSIX signature
     QF::thread_(static_cast<QActive *>(arg));
     return static_cast<void *>(0); // return success
 }
 
+#ifdef QF_TICKLESS
+//****************************************************************************
+// the number of the current tick, counted from the start of QF::run()
+//
+static uint64_t ticklessTicks(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t const ns =
+        (static_cast<int64_t>(now.tv_sec - l_tickStart.tv_sec)
+         * static_cast<int64_t>(NANOSLEEP_NSEC_PER_SEC))
+        + static_cast<int64_t>(now.tv_nsec - l_tickStart.tv_nsec);
+    return static_cast<uint64_t>(ns) / l_tickNsec;
+}
+//............................................................................
+// process all clock ticks of all tick rates after the tick 'done' until the
+// current time, skipping the ticks without any work, and return the number
+// of the last processed tick, see NOTE08.
+// NOTE: called only from the ticker thread, without l_tickMutex locked.
+//
+static uint64_t ticklessAdvance(uint64_t const done) {
+    uint64_t ticks = ticklessTicks();
+
+    if (ticks > done) {
+        QTimeEvtCtr const maxSkip =
+            static_cast<QTimeEvtCtr>(~static_cast<QTimeEvtCtr>(0));
+        for (uint_fast8_t tickRate = static_cast<uint_fast8_t>(0);
+             tickRate < static_cast<uint_fast8_t>(QF_MAX_TICK_RATE);
+             ++tickRate)
+        {
+            uint64_t left = ticks - done;
+            while (left != static_cast<uint64_t>(0)) {
+                // skip the idle ticks, but process the last one and
+                // every tick with any work
+                QTimeEvtCtr skip = maxSkip;
+                if (left - 1U < static_cast<uint64_t>(maxSkip)) {
+                    skip = static_cast<QTimeEvtCtr>(left - 1U);
+                }
+                left -= QF::skipTicksX_(tickRate, skip);
+
+                QF::TICK_X(tickRate, static_cast<void *>(0));
+                --left;
+            }
+        }
+    }
+    else {
+        ticks = done;
+    }
+    return ticks;
+}
+//............................................................................
+// the number of ticks from l_tickCtr until the next tick with any work
+// at any tick rate, or 0 if no time events are armed.
+//
+static uint64_t ticklessNext(void) {
+    uint64_t next = static_cast<uint64_t>(0);
+    for (uint_fast8_t tickRate = static_cast<uint_fast8_t>(0);
+         tickRate < static_cast<uint_fast8_t>(QF_MAX_TICK_RATE);
+         ++tickRate)
+    {
+        uint64_t const n = static_cast<uint64_t>(QF::ticksToNextX(tickRate));
+        if ((n != static_cast<uint64_t>(0))
+            && ((next == static_cast<uint64_t>(0)) || (n < next)))
+        {
+            next = n;
+        }
+    }
+    return next;
+}
+//............................................................................
+QTickCtr QF_ticklessNow_(void) {
+    QTickCtr now = static_cast<QTickCtr>(0); // no ticks before QF::run()
+    pthread_mutex_lock(&l_tickMutex);
+    if (l_isRunning) {
+        now = static_cast<QTickCtr>(ticklessTicks());
+    }
+    pthread_mutex_unlock(&l_tickMutex);
+    return now;
+}
+//............................................................................
+void QF_ticklessArmed_(QTimeEvtCtr const nTicks) {
+    pthread_mutex_lock(&l_tickMutex);
+    uint64_t const expire = l_tickCtr + static_cast<uint64_t>(nTicks);
+    if (expire < l_tickWake) { // expires before the ticker wakes up?
+        l_tickWake = expire;
+        pthread_cond_signal(&l_tickCond); // the ticker must recalculate
+    }
+    pthread_mutex_unlock(&l_tickMutex);
+}
+#endif // QF_TICKLESS
+
 //****************************************************************************
 static void sigIntHandler(int /* dummy */) {
     QP::QF::onCleanup();
@@ -315,9 +1441,52 @@ static void sigIntHandler(int /* dummy */) {
 // three highest Linux priorities for the ISR-like threads (e.g., the ticker,
 // I/O), and the rest highest-priorities for the active objects.
 //
+// When QF_MAX_ACTIVE exceeds the number of the remaining SCHED_FIFO
+// priorities (e.g., 256 active objects, see qpset.h), the QF priorities are
+// mapped proportionally onto the SCHED_FIFO priorities, so that several
+// active objects share the same p-thread priority.
+//
 // NOTE05:
 // In some (older) Linux kernels, the POSIX nanosleep() system call might
 // deliver only 2*actual-system-tick granularity. To compensate for this,
 // you would need to reduce (by 2) the constant NANOSLEEP_NSEC_PER_SEC.
 //
+// NOTE06:
+// With QF_FINE_LOCKS the event queues, event pools and subscriber lists
+// initialize their own mutexes (in QEQueue::init(), QMPool::init(),
+// QF::poolInit() and QF::psInit(), respectively), but the time events have
+// no such initialization point, so their per-tick-rate mutexes are
+// initialized here. See also NOTE2 in qf_port.h.
+//
+// NOTE07:
+// With QF_MPSC_EQUEUE the event queues of active objects are lock-free
+// (see NOTE3 in qf_port.h). The dynamic events still need to increment
+// their reference counters inside the (per-pool or global) critical section,
+// unless the reference counters are atomic (see NOTE4 in qf_port.h).
+// The QActive::postLIFO() function inserts the event in front of the head
+// of the queue, which is owned by the consumer, so it can be called only
+// from the thread of the active object (self-posting and recalling events).
+// The consumer thread sleeps on a Linux futex only when the queue is truly
+// empty (no slots reserved), and otherwise yields the CPU while a producer
+// is about to fill the reserved head slot. On POSIX systems without futex,
+// the condition variable of the active object is used instead.
+//
+// NOTE08:
+// With QF_TICKLESS the ticker thread in QF::run() processes the time events
+// itself instead of calling QF_onClockTick() (see NOTE8 in qf_port.h). The
+// tick number N is due at the absolute time l_tickStart + N * l_tickNsec,
+// so the late wake-ups do not shift the subsequent ticks. Only the ticker
+// thread processes the ticks, and it does so with l_tickMutex unlocked, so
+// a thread arming a time event takes l_tickMutex only briefly to read the
+// current tick (QF_ticklessNow_()) and to wake up the ticker if needed
+// (QF_ticklessArmed_()), even when the ticker falls behind the real time.
+// The ticker updates l_tickCtr under l_tickMutex after processing the
+// ticks. This mutex is always taken before the critical sections of QF.
+// When the processing of the ticks takes longer than the ticks themselves
+// (more than one tick behind afterwards), the ticker moves the tick 0
+// (l_tickStart) forward instead of catching up, so that the ticks stretch
+// and the ticker still sleeps between them, just like the periodic ticker
+// with nanosleep(). Otherwise, the SCHED_FIFO ticker would never sleep and
+// would starve all other threads.
+//
 
@@ -39,12 +39,19 @@
 #define qf_port_h
 
 // event queue and thread types
-#define QF_EQUEUE_TYPE       QEQueue
+#ifndef QF_MPSC_EQUEUE
+    #define QF_EQUEUE_TYPE   QEQueue
+#else // lock-free multiple-producer single-consumer queue, see NOTE3
+    #define QF_EQUEUE_TYPE   QMPSCQueue
+#endif // QF_MPSC_EQUEUE
 #define QF_OS_OBJECT_TYPE    pthread_cond_t
 #define QF_THREAD_TYPE       uint8_t
 
-// The maximum number of active objects in the application
-#define QF_MAX_ACTIVE        64
+// The maximum number of active objects in the application,
+// which can be raised up to 4096 (see qpset.h)
+#ifndef QF_MAX_ACTIVE
+    #define QF_MAX_ACTIVE    64
+#endif
 
 // The number of system clock tick rates
 #define QF_MAX_TICK_RATE     2
@@ -61,11 +68,229 @@
 #define QF_CRIT_ENTRY(dummy) QP::QF_enterCriticalSection_()
 #define QF_CRIT_EXIT(dummy)  QP::QF_leaveCriticalSection_()
 
+// QF_LOG2 with the count-leading-zeros builtin of GCC/Clang (the argument
+// extended with a low 1-bit makes QF_LOG2(0) == 0 without a branch) and
+// the 64-bit variant for the single-word priority set on 64-bit hosts,
+// unless QF_LOG2_PORTABLE selects the internal LOG2() implementation
+#if (defined __GNUC__) && (!defined QF_LOG2_PORTABLE)
+    #define QF_LOG2(n_) (static_cast<uint_fast8_t>(63 \
+        - __builtin_clzll((static_cast<uint64_t>(n_) << 1) | 1U)))
+    #if (defined __LP64__) || (defined _WIN64)
+        #define QF_LOG2_64(n_) \
+            (static_cast<uint_fast8_t>(64 - __builtin_clzll((n_))))
+    #endif
+#else
+    // QF_LOG2 not defined -- use the internal LOG2() implementation
+#endif
+
+// QF per-object critical sections (optional), see NOTE2
+#ifdef QF_FINE_LOCKS
+    #define QF_OBJ_LOCK_TYPE     pthread_mutex_t
+    #define QF_OBJ_LOCK_INIT(l_) \
+        pthread_mutex_init((l_), static_cast<pthread_mutexattr_t *>(0))
+    #define QF_OBJ_LOCK(l_)      pthread_mutex_lock((l_))
+    #define QF_OBJ_UNLOCK(l_)    pthread_mutex_unlock((l_))
+#endif // QF_FINE_LOCKS
+
+// QF atomic reference counters of dynamic events (optional), see NOTE4
+#ifdef QF_EVT_REF_ATOMIC
+    #ifndef QF_EVT_REF_CTR_SIZE
+        #define QF_EVT_REF_CTR_SIZE  2
+    #endif
+    #define QF_EVT_REF_ATOMIC_INC(ctr_) \
+        ((void)__atomic_add_fetch((ctr_), 1U, __ATOMIC_RELAXED))
+    #define QF_EVT_REF_ATOMIC_DEC(ctr_) \
+        __atomic_sub_fetch((ctr_), 1U, __ATOMIC_ACQ_REL)
+    #define QF_EVT_REF_ATOMIC_LOAD(ctr_) \
+        __atomic_load_n((ctr_), __ATOMIC_ACQUIRE)
+#endif // QF_EVT_REF_ATOMIC
+
 #include <pthread.h>   // POSIX-thread API
 #include "qep_port.h"  // QEP port
 #include "qequeue.h"   // POSIX needs event-queue
 #include "qmpool.h"    // POSIX needs memory-pool
 #include "qpset.h"     // POSIX needs priority-set
+
+#ifdef QF_MPSC_EQUEUE
+namespace QP {
+
+//****************************************************************************
+//! Lock-free multiple-producer single-consumer event queue for the
+//! active objects in the POSIX port, see NOTE3
+/// @description
+/// The producers post events to this queue with atomic operations only,
+/// without entering any critical section. The consumer (the thread of the
+/// active object) sleeps on a futex only when the queue is empty and it is
+/// woken up only by the producer that makes the queue non-empty.
+///
+/// @note
+/// Just like QP::QEQueue, the capacity of the queue is qLen + 1 events,
+/// which preserves the meaning of the margin and the low-watermark
+/// reported by QP::QF::getQueueMin().
+class QMPSCQueue {
+private:
+    //! ring buffer of event pointers (NULL means a free slot)
+    QEvt const * volatile *m_ring;
+
+    //! the extra slot of the ring buffer (at index m_end)
+    QEvt const * volatile m_extra;
+
+    //! offset of the last slot in the ring buffer (qLen)
+    QEQueueCtr m_end;
+
+    //! offset of the slot to extract the next event from (consumer only)
+    QEQueueCtr m_head;
+
+    //! offset of the slot to insert the next event to (producers)
+    QEQueueCtr volatile m_tail;
+
+    //! number of free slots (producers reserve slots by decrementing it)
+    QEQueueCtr volatile m_nFree;
+
+    //! minimum number of free slots ever in the queue
+    QEQueueCtr volatile m_nMin;
+
+    //! futex word: non-zero when the consumer is (about to be) sleeping
+    int volatile m_waiting;
+
+    //! auxiliary value, which is not modified by init()
+    /// @note used by QP::QTicker to remember its tick rate
+    QEQueueCtr m_aux;
+
+#ifdef QF_EVT_INLINE
+    //! the last inline event removed from the queue (consumer only)
+    /// @sa QP::QInlineEvt
+    QInlineEvt m_inlineEvt;
+#endif // QF_EVT_INLINE
+
+public:
+    //! public default constructor
+    QMPSCQueue(void);
+
+    //! Initializes the queue with the ring buffer @p qSto[] of @p qLen
+    void init(QEvt const *qSto[], uint_fast16_t const qLen);
+
+    //! obtain the number of free entries still available in the queue
+    QEQueueCtr getNFree(void) const {
+        return m_nFree;
+    }
+
+    //! obtain the minimum number of free entries ever in the queue
+    QEQueueCtr getNMin(void) const {
+        return m_nMin;
+    }
+
+    //! find out if the queue is empty
+    bool isEmpty(void) const {
+        return m_nFree == (m_end + static_cast<QEQueueCtr>(1));
+    }
+
+private:
+    //! access the slot @p i of the ring buffer
+    QEvt const * volatile *slot(QEQueueCtr const i) {
+        return (i < m_end) ? &m_ring[i] : &m_extra;
+    }
+
+    //! disallow copying of QMPSCQueue
+    QMPSCQueue(QMPSCQueue const &);
+
+    //! disallow assignment of QMPSCQueue
+    QMPSCQueue & operator=(QMPSCQueue const &);
+
+    friend class QF;
+    friend class QActive;
+    friend class QTicker;
+#ifdef Q_UTEST
+    friend class QS;
+#endif // Q_UTEST
+};
+
+} // namespace QP
+#endif // QF_MPSC_EQUEUE
+
+#ifdef QF_LOCKFREE_EPOOL
+namespace QP {
+
+//****************************************************************************
+//! Lock-free fixed block-size memory pool for the event pools in the
+//! POSIX port, see NOTE5
+/// @description
+/// The free blocks are kept in a lock-free stack (Treiber stack), whose
+/// head combines the index of the top free block with a generation tag
+/// incremented by every successful update, which protects the stack from
+/// the ABA problem. Like QP::QMPool, the pool checks the requested margin
+/// and keeps the low-watermark of free blocks.
+class QLFPool {
+private:
+    //! start of the memory managed by this memory pool
+    void *m_start;
+
+    //! end of the memory managed by this memory pool (the last block)
+    void *m_end;
+
+    //! head of the free-block stack: generation tag in the upper 32 bits
+    //! and the index of the top free block + 1 in the lower 32 bits
+    uint64_t volatile m_head;
+
+    //! maximum block size (in bytes)
+    QMPoolSize m_blockSize;
+
+    //! total number of blocks
+    QMPoolCtr m_nTot;
+
+    //! number of free blocks remaining (reserved before popping a block)
+    QMPoolCtr volatile m_nFree;
+
+    //! minimum number of free blocks ever present in this pool
+    QMPoolCtr volatile m_nMin;
+
+public:
+    QLFPool(void); //!< public default constructor
+
+    //! Initializes the lock-free event pool
+    void init(void * const poolSto, uint_fast32_t poolSize,
+              uint_fast16_t blockSize);
+
+    //! Obtains a memory block from the pool
+    void *get(uint_fast16_t const margin);
+
+    //! Returns a memory block back to the pool
+    void put(void * const b);
+
+    //! return the fixed block-size of the blocks managed by this pool
+    QMPoolSize getBlockSize(void) const {
+        return m_blockSize;
+    }
+
+#if (defined QF_MAGAZINE_SIZE) || (defined QF_DRAIN_MAX)
+    //! Obtains up to @p n memory blocks at once (no margin).
+    uint_fast16_t getMany(void *blk[], uint_fast16_t const n);
+
+    //! Returns @p n memory blocks back to the pool at once.
+    void putMany(void * const blk[], uint_fast16_t const n);
+#endif // QF_MAGAZINE_SIZE || QF_DRAIN_MAX
+
+private:
+    //! pop one reserved block from the free-block stack
+    void *pop(void);
+
+    //! the link to the next free block stored in the free block @p b
+    static uint32_t volatile *link(void * const b) {
+        return static_cast<uint32_t volatile *>(b);
+    }
+
+    QLFPool(QLFPool const &);            //!< disallow copying of QLFPools
+    QLFPool &operator=(QLFPool const &); //!< disallow assigning of QLFPools
+
+    friend class QF;
+#ifdef Q_UTEST
+    friend class QS;
+#endif // Q_UTEST
+};
+
+} // namespace QP
+#endif // QF_LOCKFREE_EPOOL
+
 #include "qf.h"        // QF platform-independent public interface
 
 namespace QP {
@@ -100,9 +325,20 @@ extern pthread_mutex_t QF_pThreadMutex_; // mutex for QF critical section
     #define QF_SCHED_UNLOCK_()    ((void)0)
 
     // native event queue operations...
+#ifdef QF_MPSC_EQUEUE
+    // QActive::post_(), postLIFO(), get_(), QF::getQueueMin() and QTicker
+    // are implemented in this port (qf_port.cpp), see NOTE3. The same holds
+    // for QActive::postBatch_() and getBatch_().
+    #define QACTIVE_EQUEUE_PORT_
+#elif !defined QF_FINE_LOCKS
     #define QACTIVE_EQUEUE_WAIT_(me_) \
         while ((me_)->m_eQueue.m_frontEvt == static_cast<QEvt const *>(0)) \
             pthread_cond_wait(&(me_)->m_osObject, &QF_pThreadMutex_)
+#else // wait on the lock of the event queue, see NOTE2
+    #define QACTIVE_EQUEUE_WAIT_(me_) \
+        while ((me_)->m_eQueue.m_frontEvt == static_cast<QEvt const *>(0)) \
+            pthread_cond_wait(&(me_)->m_osObject, &(me_)->m_eQueue.m_lock)
+#endif // QF_MPSC_EQUEUE
 
     #define QACTIVE_EQUEUE_SIGNAL_(me_) \
         Q_ASSERT_ID(410, QF::active_[(me_)->m_prio] \
@@ -110,7 +346,14 @@ extern pthread_mutex_t QF_pThreadMutex_; // mutex for QF critical section
         pthread_cond_signal(&(me_)->m_osObject) \
 
     // event pool operations...
+#ifndef QF_LOCKFREE_EPOOL
     #define QF_EPOOL_TYPE_  QMPool
+#else // lock-free event pools, see NOTE5
+    #define QF_EPOOL_TYPE_  QLFPool
+
+    // QF::getPoolMin() is implemented in this port (qf_port.cpp)
+    #define QF_EPOOL_PORT_
+#endif // QF_LOCKFREE_EPOOL
 
     #define QF_EPOOL_INIT_(p_, poolSto_, poolSize_, evtSize_) \
         (p_).init((poolSto_), (poolSize_), (evtSize_))
@@ -120,6 +363,25 @@ extern pthread_mutex_t QF_pThreadMutex_; // mutex for QF critical section
         ((e_) = static_cast<QEvt *>((p_).get((m_))))
     #define QF_EPOOL_PUT_(p_, e_)     ((p_).put(e_))
 
+    // batch event pool operations for the per-thread magazines (NOTE6)
+    // and for the batched draining of the event queues (NOTE7)
+    #define QF_EPOOL_GET_MANY_(p_, blk_, n_) ((p_).getMany((blk_), (n_)))
+    #define QF_EPOOL_PUT_MANY_(p_, blk_, n_) ((p_).putMany((blk_), (n_)))
+
+#ifdef QF_TICKLESS
+    // tickless processing of time events, see NOTE8
+    #define QF_TIMEEVT_NOW_()           (QF_ticklessNow_())
+    #define QF_TIMEEVT_ARMED_(nTicks_)  (QF_ticklessArmed_((nTicks_)))
+
+namespace QP {
+    QTickCtr QF_ticklessNow_(void);
+    void QF_ticklessArmed_(QTimeEvtCtr const nTicks);
+} // namespace QP
+#endif // QF_TICKLESS
+
+    // round-robin servicing of the priority bands, see NOTE9
+    #define QF_BAND_SCHED_
+
 #endif // QP_IMPL
 
 // NOTES: ====================================================================
@@ -152,6 +414,146 @@ extern pthread_mutex_t QF_pThreadMutex_; // mutex for QF critical section
 // implementation, such as POSIX threads, should support the priority-
 // inheritance protocol.
 //
+// NOTE2:
+// When the application is compiled with the macro QF_FINE_LOCKS defined,
+// this port replaces the single global mutex with per-object mutexes
+// (see the macro QF_OBJ_LOCK_TYPE). Every event queue and event pool is
+// then protected by its own mutex, the reference counters of dynamic events
+// are protected by one mutex per event pool, the time events by one mutex
+// per tick rate, and the subscriber lists by one common mutex. This allows
+// threads operating on unrelated QF objects to run in parallel on multiple
+// CPU cores, instead of serializing on the global QF_pThreadMutex_.
+//
+// The global mutex is still used for registering active objects with the
+// framework and for the QS software tracing. To avoid deadlocks, the
+// mutexes are always nested in the same order: event queue, subscriber
+// lists or time events first; event reference counter next; and the
+// global (QS) mutex last. The condition variable of an active object waits
+// on the mutex of its event queue.
+//
+// NOTE3:
+// When the application is compiled with the macro QF_MPSC_EQUEUE defined,
+// the event queues of active objects are the lock-free QP::QMPSCQueue
+// instead of QP::QEQueue. A producer first reserves a free slot by
+// decrementing the number of free slots with compare-and-swap (which
+// checks the margin and lets the producer update the low-watermark), then
+// claims the next tail slot and stores the event pointer into it. The
+// consumer removes events from the head slot, clears the slot and only
+// then returns it to the pool of free slots. The FIFO order is preserved,
+// because the consumer always waits for the head slot to be filled, even
+// if some producers have already filled the subsequent slots. Only the
+// producer that posts into an empty queue checks whether the consumer
+// sleeps and wakes it up (futex on Linux).
+//
+// The LIFO posting (QActive::postLIFO()) inserts the event in front of the
+// head slot and therefore can be only called by the thread of the active
+// object itself (self-posting and QActive::recall()), which is the only
+// recommended use of LIFO posting anyway.
+//
+// NOTE4:
+// When the application is compiled with the macro QF_EVT_REF_ATOMIC defined,
+// the reference counters of dynamic events are incremented and decremented
+// with the atomic operations of the GCC/Clang compilers instead of inside
+// the QF critical section. QP::QF::gc() then costs a single atomic decrement
+// unless the event is actually recycled, in which case only the event pool
+// is locked. The reference counters are 2 bytes wide by default in this
+// mode, which can be changed by defining QF_EVT_REF_CTR_SIZE (1, 2, or 4).
+// The increment can be relaxed, because a new reference can be only created
+// by the thread that already holds one. The decrement must be acquire-release
+// so that all accesses to the event happen before it is recycled. For the
+// same reason QP::QF::gc() reads the counter with an acquire load before
+// deciding to recycle the event without the decrement (the last holder),
+// so that it sees all writes of the other threads to the event.
+//
+// NOTE5:
+// When the application is compiled with the macro QF_LOCKFREE_EPOOL defined,
+// the event pools are the lock-free QP::QLFPool instead of QP::QMPool.
+// QF::newX_() first reserves a block by decrementing the number of free
+// blocks with compare-and-swap (which checks the margin and updates the
+// low-watermark) and only then pops a block from the free-block stack.
+// Conversely, QF::gc() first pushes the block onto the stack and only then
+// increments the number of free blocks. This guarantees that the stack
+// always holds at least as many blocks as are reserved. The stack is popped
+// and pushed with a 64-bit compare-and-swap of the head, which contains
+// a generation tag to detect the reuse of the same top block (ABA problem).
+// The pools still need the 32-bit block index for the link in the free
+// blocks, so the blocks must be at least 4 bytes large, which is always
+// the case on POSIX.
+//
+// NOTE6:
+// When the application is compiled with the macro QF_MAGAZINE_SIZE defined
+// (e.g., -DQF_MAGAZINE_SIZE=16), every thread that allocates or recycles
+// dynamic events gets its own magazines of free event blocks (see NOTE2 in
+// src/qf/qf_dyn.cpp). The magazines are allocated on the heap the first time
+// the thread needs them and are flushed back to the event pools when the
+// thread terminates (p-thread key destructor). The key destructor does not
+// run for the main thread, so QF::run() flushes the magazines of the main
+// thread itself after QF::stop(), before calling QF::onCleanup(), where the
+// event pools can be inspected (e.g., QF::getPoolMin()). The magazines of
+// the active objects still running at that time are not flushed (their
+// threads are terminated only by the exit of the process), so the free
+// blocks reported after the shutdown can be understated by at most
+// QF_MAGAZINE_SIZE blocks per such thread. The magazines work with both
+// QP::QMPool and QP::QLFPool event pools, which must be sized for the extra
+// QF_MAGAZINE_SIZE blocks per thread (the small event pools of the DPP
+// examples are not).
+//
+// NOTE7:
+// When the application is compiled with the macro QF_DRAIN_MAX defined
+// (e.g., -DQF_DRAIN_MAX=16), the thread of every active object removes up
+// to QF_DRAIN_MAX events from its event queue at once with
+// QP::QActive::getBatch_(), which takes the lock of the queue only once
+// and waits only when the queue is empty. The events are then dispatched
+// one after another, each still run to completion, and are recycled
+// together with QP::QF::gcBatch_(), which decrements their reference
+// counters in a single critical section and returns the recycled blocks to
+// every event pool at once. Under load this brings the number of lock
+// acquisitions per event from about three (get, reference counter, event
+// pool) to about three per batch. The events posted LIFO to the active
+// object after the batch has been taken (e.g., QP::QActive::recall())
+// are counted in QP::QActive::m_lifoCtr. They are at the front of the
+// queue and are dispatched right after the current RTC step, before the
+// rest of the batch. An inline event (#QF_EVT_INLINE) always ends a batch
+// and is copied out of the queue buffer, which the next QActive::get_()
+// overwrites.
+//
+// NOTE8:
+// When the application is compiled with the macro QF_TICKLESS defined,
+// QF::run() does not call QF_onClockTick() periodically. Instead, it
+// processes the time events of all tick rates (0..QF_MAX_TICK_RATE-1)
+// directly, all with the tick period set by QF_setTickRate(), and sleeps
+// on a condition variable until the absolute CLOCK_MONOTONIC time of the
+// next tick with any work (see QP::QF::ticksToNextX()), or indefinitely
+// when no time events are armed. The idle ticks in between are skipped at
+// once (see QP::QF::skipTicksX_()), and because the ticks are counted from
+// the start of QF::run() rather than from the last wake-up, the ticker
+// does not accumulate any drift. This allows fine tick periods (e.g.,
+// 10 kHz for sub-millisecond timeouts) without waking up in every tick.
+//
+// A thread arming a time event does not process any ticks. It only reads
+// the current tick (QF_ticklessNow_()), by which QF extends the timeout by
+// the ticks the ticker has not processed yet, so that the timeout counts
+// from the current tick. It then wakes up the ticker if the new time event
+// expires before the tick the ticker is waiting for (QF_ticklessArmed_()).
+// The arming latency therefore stays bounded even when the processing of
+// a tick takes longer than the tick period.
+// The application must not rely on QF_onClockTick() in this mode.
+//
+// NOTE9:
+// When the application is compiled with the macro QF_PRIO_BANDS defined
+// (see QP::QF::bandInit()), the p-threads of all active objects in a
+// priority band get the same SCHED_FIFO priority (of the highest priority
+// of the band), and every such p-thread calls sched_yield() after
+// dispatching the quantum of events of its band. The yielding thread goes
+// to the end of the run queue of its SCHED_FIFO priority, so the ready
+// active objects of the band take turns. The p-threads are created with
+// PTHREAD_EXPLICIT_SCHED, so they don't inherit the policy of the thread
+// calling QP::QActive::start(). Without the superuser privileges the
+// p-threads fall back to SCHED_OTHER, where sched_yield() guarantees no
+// turns at all. The Linux scheduler then shares the CPU among the busy
+// p-threads by their run time, so the band is fair only on average and
+// the quantum is not observed.
+//
 
 #endif // qf_port_h
 
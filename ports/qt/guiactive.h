@@ -44,7 +44,7 @@ namespace QP {
 class GuiQActive : public QActive {
 public:
     GuiQActive(QStateHandler const initial) : QActive(initial) {}
-    virtual void start(uint_fast8_t const prio,
+    virtual void start(QPrio const prio,
         QEvt const *qSto[], uint_fast16_t const qLen,
         void * const stkSto, uint_fast16_t const stkSize,
         QEvt const * const ie);
@@ -55,13 +55,21 @@ public:
         void const * const sender);
 #endif // Q_SPY
     virtual void postLIFO(QEvt const * const e);
+#ifndef Q_SPY
+    virtual bool postBatch_(QEvt const * const evts[],
+        uint_fast16_t const n, uint_fast16_t const margin);
+#else
+    virtual bool postBatch_(QEvt const * const evts[],
+        uint_fast16_t const n, uint_fast16_t const margin,
+        void const * const sender);
+#endif // Q_SPY
 };
 
 //............................................................................
 class GuiQMActive : public QMActive {
 public:
     GuiQMActive(QStateHandler const initial) : QMActive(initial) {}
-    virtual void start(uint_fast8_t const prio,
+    virtual void start(QPrio const prio,
                        QEvt const *qSto[], uint_fast16_t const qLen,
                        void * const stkSto, uint_fast16_t const stkSize,
                        QEvt const * const ie);
@@ -72,6 +80,16 @@ public:
                        void const * const sender);
 #endif // Q_SPY
     virtual void postLIFO(QEvt const * const e);
+#ifndef Q_SPY
+    virtual bool postBatch_(QEvt const * const evts[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin);
+#else
+    virtual bool postBatch_(QEvt const * const evts[],
+                            uint_fast16_t const n,
+                            uint_fast16_t const margin,
+                            void const * const sender);
+#endif // Q_SPY
 };
 
 } // namespace QP
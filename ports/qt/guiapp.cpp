@@ -89,7 +89,7 @@ bool GuiApp::event(QEvent *e) {
 }
 
 //............................................................................
-void GuiQActive::start(uint_fast8_t const prio,
+void GuiQActive::start(QPrio const prio,
                        QEvt const *qSto[], uint_fast16_t const /*qLen*/,
                        void * const stkSto, uint_fast16_t const /*stkSize*/,
                        QEvt const * const ie)
@@ -168,8 +168,26 @@ void GuiQActive::postLIFO(QEvt const * const e) {
                                 Qt::HighEventPriority);
 }
 
+//............................................................................
+#ifndef Q_SPY
+bool GuiQActive::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                            uint_fast16_t const margin)
+#else
+bool GuiQActive::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                            uint_fast16_t const margin,
+                            void const * const sender)
+#endif
+{
+    // the Qt events are posted one by one and never fail
+    uint_fast16_t i;
+    for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        (void)POST_X(evts[i], margin, sender);
+    }
+    return true;
+}
+
 //****************************************************************************
-void GuiQMActive::start(uint_fast8_t const prio,
+void GuiQMActive::start(QPrio const prio,
                         QEvt const *qSto[], uint_fast16_t const /*qLen*/,
                         void * const stkSto, uint_fast16_t const /*stkSize*/,
                         QEvt const * const ie)
@@ -248,5 +266,23 @@ void GuiQMActive::postLIFO(QEvt const * const e) {
                                 Qt::HighEventPriority);
 }
 
+//............................................................................
+#ifndef Q_SPY
+bool GuiQMActive::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                             uint_fast16_t const margin)
+#else
+bool GuiQMActive::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                             uint_fast16_t const margin,
+                             void const * const sender)
+#endif
+{
+    // the Qt events are posted one by one and never fail
+    uint_fast16_t i;
+    for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        (void)POST_X(evts[i], margin, sender);
+    }
+    return true;
+}
+
 } // namespace QP
 
@@ -111,8 +111,10 @@ void QF::thread_(QActive *act) {
     // loop until m_thread is cleared in QActive::stop()...
     do {
         QEvt const *e = act->get_(); // wait for event
-        act->dispatch(e); // dispatch to the active object's state machine
-        gc(e); // check if the event is garbage, and collect it if so
+        if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+            act->dispatch(e); // dispatch to the active object's state machine
+            gc(e); // check if the event is garbage, and collect it if so
+        }
     } while (thread->m_isRunning);
 
     QF::remove_(act);
@@ -139,7 +141,7 @@ void QF_setTickRate(unsigned ticksPerSec) {
     l_tickerThread.m_tickInterval = 1000U/ticksPerSec;
 }
 //............................................................................
-void QActive::start(uint_fast8_t const prio,
+void QActive::start(QPrio const prio,
                      QEvt const **qSto, uint_fast16_t qLen,
                      void * const stkSto, uint_fast16_t const stkSize,
                      QEvt const * const ie)
@@ -69,6 +69,15 @@ class QWaitCondition; // forward declaration
 class QThread;        // forward declaration
 class QMutex;         // forward declaration
 
+// this port stores the events posted to active objects by pointer only
+#ifdef QF_EVT_INLINE
+    #error "QF_EVT_INLINE is not supported in this QF port"
+#endif
+// this port does not post the events to active objects in batches
+#ifdef QF_TIMEEVT_SLACK
+    #error "QF_TIMEEVT_SLACK is not supported in this QF port"
+#endif
+
 #include "qep_port.h" // QEP port
 #include "qequeue.h"  // Qt port uses event-queue
 #include "qmpool.h"   // Qt port uses memory-pool
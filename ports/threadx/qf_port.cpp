@@ -96,7 +96,7 @@ static void thread_function(ULONG thread_input) { // ThreadX signature
     QF::thread_(reinterpret_cast<QActive *>(thread_input));
 }
 //............................................................................
-void QActive::start(uint_fast8_t prio,
+void QActive::start(QPrio prio,
                     QEvt const *qSto[], uint_fast16_t qLen,
                     void *stkSto, uint_fast16_t stkSize,
                     QEvt const *ie)
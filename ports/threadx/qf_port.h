@@ -43,6 +43,9 @@
 #define QF_THREAD_TYPE       TX_THREAD
 #define QF_OS_OBJECT_TYPE    bool
 
+// the native OS queues cannot post a batch of events atomically
+#define QF_NO_POST_BATCH
+
 // QF priority offset within ThreadX priority numbering scheme, see NOTE1
 #define QF_TX_PRIO_OFFSET    8
 
@@ -56,6 +59,19 @@
 
 #include "tx_api.h"    // ThreadX API
 
+// this port stores the events posted to active objects by pointer only
+#ifdef QF_EVT_INLINE
+    #error "QF_EVT_INLINE is not supported in this QF port"
+#endif
+// this port does not post the events to active objects in batches
+#ifdef QF_TIMEEVT_SLACK
+    #error "QF_TIMEEVT_SLACK is not supported in this QF port"
+#endif
+// this port gets the events from the native queues of the RTOS
+#ifdef QF_PS_BROADCAST
+    #error "QF_PS_BROADCAST is not supported in this QF port"
+#endif
+
 #include "qep_port.h"  // QEP port
 #include "qequeue.h"   // used for event deferral
 #include "qpset.h"     // used for publish/subscribe
@@ -72,7 +72,7 @@ void QF::stop(void) {
 }
 
 //............................................................................
-void QActive::start(uint_fast8_t prio,
+void QActive::start(QPrio prio,
                     QEvt const *qSto[], uint_fast16_t qLen,
                     void *stkSto, uint_fast16_t /* stkSize */,
                     QEvt const *ie)
@@ -113,8 +113,10 @@ void QActive::stop() {
 static void swi_function(UArg arg0, UArg /* arg1 */) { // TI-RTOS Swi
     QActive *act = reinterpret_cast<QActive *>(arg0);
     QEvt const *e = act->get_();
-    act->dispatch(e);
-    QF::gc(e);
+    if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+        act->dispatch(e);
+        QF::gc(e);
+    }
 
     // are events still available for this AO?
     if (!act->m_eQueue.isEmpty()) {
@@ -42,6 +42,9 @@
 #define QF_EQUEUE_TYPE       OS_EVENT *
 #define QF_THREAD_TYPE       uint32_t
 
+// the native OS queues cannot post a batch of events atomically
+#define QF_NO_POST_BATCH
+
 // The maximum number of active objects in the application
 #define QF_MAX_ACTIVE ((OS_LOWEST_PRIO - 1 < 64) ? (OS_LOWEST_PRIO - 1) : 64)
 
@@ -52,6 +55,19 @@
 
 #include "ucos_ii.h"   // uC/OS-II API
 
+// this port stores the events posted to active objects by pointer only
+#ifdef QF_EVT_INLINE
+    #error "QF_EVT_INLINE is not supported in this QF port"
+#endif
+// this port does not post the events to active objects in batches
+#ifdef QF_TIMEEVT_SLACK
+    #error "QF_TIMEEVT_SLACK is not supported in this QF port"
+#endif
+// this port gets the events from the native queues of the RTOS
+#ifdef QF_PS_BROADCAST
+    #error "QF_PS_BROADCAST is not supported in this QF port"
+#endif
+
 #include "qep_port.h"  // QEP port, includes the master uC/OS-II include
 #include "qequeue.h"   // used for event deferral
 #include "qpset.h"     // this QP port uses the native QP priority set
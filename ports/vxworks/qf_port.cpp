@@ -97,8 +97,10 @@ void QF::thread_(QActive *act) {
     act->m_osObject = 1;
     while (act->m_osObject) {
         QEvt const *e = act->get_(); // wait for event
-        act->dispatch(e); // dispatch to the active object's state machine
-        gc(e); // check if the event is garbage, and collect it if so
+        if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+            act->dispatch(e); // dispatch to the active object's state machine
+            gc(e); // check if the event is garbage, and collect it if so
+        }
     }
     act->unsubscribeAll(); // unsubscribe from all events
     QF::remove_(act); // remove this active object from QF
@@ -106,7 +108,7 @@ void QF::thread_(QActive *act) {
     taskDelete(act->m_thread);
 }
 //............................................................................
-void QActive::start(uint_fast8_t prio,
+void QActive::start(QPrio prio,
                     QEvt const *qSto[], uint_fast16_t qLen,
                     void *stkSto, uint_fast16_t stkSize,
                     QEvt const *ie)
@@ -59,7 +59,20 @@
 #define QF_CRIT_ENTRY(dummy) QF_INT_DISABLE()
 #define QF_CRIT_EXIT(dummy)  QF_INT_ENABLE()
 
-// QF_LOG2 not defined -- use the internal LOG2() implementation
+// QF_LOG2 with the count-leading-zeros builtin of GCC/Clang (the argument
+// extended with a low 1-bit makes QF_LOG2(0) == 0 without a branch) and
+// the 64-bit variant for the single-word priority set on 64-bit hosts,
+// unless QF_LOG2_PORTABLE selects the internal LOG2() implementation
+#if (defined __GNUC__) && (!defined QF_LOG2_PORTABLE)
+    #define QF_LOG2(n_) (static_cast<uint_fast8_t>(63 \
+        - __builtin_clzll((static_cast<uint64_t>(n_) << 1) | 1U)))
+    #if (defined __LP64__) || (defined _WIN64)
+        #define QF_LOG2_64(n_) \
+            (static_cast<uint_fast8_t>(64 - __builtin_clzll((n_))))
+    #endif
+#else
+    // QF_LOG2 not defined -- use the internal LOG2() implementation
+#endif
 
 #include "qep_port.h"  // QEP port
 #include "qequeue.h"   // QUTEST port uses QEQueue event-queue
@@ -128,7 +141,7 @@ extern uint8_t volatile QF_intNest;
     #define QACTIVE_EQUEUE_WAIT_(me_) \
         Q_ASSERT_ID(110, (me_)->m_eQueue.m_frontEvt != static_cast<QEvt *>(0))
     #define QACTIVE_EQUEUE_SIGNAL_(me_) \
-        (QS::rxPriv_.readySet.insert(static_cast<uint_fast8_t>((me_)->m_prio)))
+        (QS::rxPriv_.readySet.insert(static_cast<QPrio>((me_)->m_prio)))
 
     // native QF event pool operations
     #define QF_EPOOL_TYPE_  QMPool
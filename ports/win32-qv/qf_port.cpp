@@ -77,6 +77,8 @@ void QF::init(void) {
     QF_maxPool_ = static_cast<uint_fast8_t>(0);
     bzero(&QF::timeEvtHead_[0],
           static_cast<uint_fast16_t>(sizeof(QF::timeEvtHead_)));
+    bzero(&QF::tickCtr_[0],
+          static_cast<uint_fast16_t>(sizeof(QF::tickCtr_)));
     bzero(&active_[0], static_cast<uint_fast16_t>(sizeof(active_)));
 }
 //****************************************************************************
@@ -114,7 +116,10 @@ int_t QF::run(void) {
     while (l_isRunning) {
         // find the maximum priority AO ready to run
         if (QV_readySet_.notEmpty()) {
-            uint_fast8_t p = QV_readySet_.findMax();
+            QPrio p = QV_readySet_.findMax();
+#ifdef QF_PRIO_BANDS
+            p = bandNext_(p, QV_readySet_); // round-robin in the band
+#endif
             QActive *a = active_[p];
             QF_CRIT_EXIT_();
 
@@ -129,8 +134,10 @@ int_t QF::run(void) {
             // 3. determine if event is garbage and collect it if so
             //
             QEvt const *e = a->get_();
-            a->dispatch(e);
-            gc(e);
+            if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+                a->dispatch(e);
+                gc(e);
+            }
 
             QF_CRIT_ENTRY_();
 
@@ -190,7 +197,7 @@ int QF_consoleWaitForKey(void) {
 }
 
 //****************************************************************************
-void QActive::start(uint_fast8_t prio,
+void QActive::start(QPrio prio,
                     QEvt const *qSto[], uint_fast16_t qLen,
                     void *stkSto, uint_fast16_t /*stkSize*/,
                     QEvt const *ie)
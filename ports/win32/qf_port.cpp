@@ -76,6 +76,8 @@ void QF::init(void) {
     QF_maxPool_ = static_cast<uint_fast8_t>(0);
     bzero(&QF::timeEvtHead_[0],
           static_cast<uint_fast16_t>(sizeof(QF::timeEvtHead_)));
+    bzero(&QF::tickCtr_[0],
+          static_cast<uint_fast16_t>(sizeof(QF::tickCtr_)));
     bzero(&active_[0], static_cast<uint_fast16_t>(sizeof(active_)));
 }
 //****************************************************************************
@@ -100,8 +102,10 @@ void QF::thread_(QActive *act) {
     // loop until m_thread is cleared in QActive::stop()
     do {
         QEvt const *e = act->get_(); // wait for event
-        act->dispatch(e); // dispatch to the active object's state machine
-        gc(e); // check if the event is garbage, and collect it if so
+        if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+            act->dispatch(e); // dispatch to the active object's state machine
+            gc(e); // check if the event is garbage, and collect it if so
+        }
     } while (act->m_thread != NULL);
 
     act->unsubscribeAll(); // make sure that no events are subscribed
@@ -182,7 +186,7 @@ int QF_consoleWaitForKey(void) {
 }
 
 //****************************************************************************
-void QActive::start(uint_fast8_t prio,
+void QActive::start(QPrio prio,
                     QEvt const *qSto[], uint_fast16_t qLen,
                     void *stkSto, uint_fast16_t stkSize,
                     QEvt const *ie)
@@ -67,10 +67,10 @@ QActive *QF::active_[QF_MAX_ACTIVE + 1]; // to be used by QF ports only
 /// @sa QP::QF::remove_()
 ///
 void QF::add_(QActive * const a) {
-    uint_fast8_t p = static_cast<uint_fast8_t>(a->m_prio);
+    QPrio p = static_cast<QPrio>(a->m_prio);
 
-    Q_REQUIRE_ID(100, (static_cast<uint_fast8_t>(0) < p)
-                      && (p <= static_cast<uint_fast8_t>(QF_MAX_ACTIVE))
+    Q_REQUIRE_ID(100, (static_cast<QPrio>(0) < p)
+                      && (p <= static_cast<QPrio>(QF_MAX_ACTIVE))
                       && (active_[p] == static_cast<QActive *>(0)));
     QF_CRIT_STAT_
     QF_CRIT_ENTRY_();
@@ -93,10 +93,10 @@ void QF::add_(QActive * const a) {
 /// @sa QP::QF::add_()
 ///
 void QF::remove_(QActive * const a) {
-    uint_fast8_t p = static_cast<uint_fast8_t>(a->m_prio);
+    QPrio p = static_cast<QPrio>(a->m_prio);
 
-    Q_REQUIRE_ID(200, (static_cast<uint_fast8_t>(0) < p)
-                      && (p <= static_cast<uint_fast8_t>(QF_MAX_ACTIVE))
+    Q_REQUIRE_ID(200, (static_cast<QPrio>(0) < p)
+                      && (p <= static_cast<QPrio>(QF_MAX_ACTIVE))
                       && (active_[p] == a));
 
     QF_CRIT_STAT_
@@ -106,6 +106,161 @@ void QF::remove_(QActive * const a) {
     QF_CRIT_EXIT_();
 }
 
+#ifdef QF_PRIO_BANDS
+
+#if (QF_PRIO_BANDS < 1) || (QF_PRIO_BANDS > 255)
+    #error "QF_PRIO_BANDS defined incorrectly, expected 1..255"
+#endif
+
+//! band of priorities, whose active objects are serviced round-robin
+struct QPrioBand {
+    QPrioStore lo;    //!< the lowest priority of the band
+    QPrioStore hi;    //!< the highest priority of the band
+    QPrioStore turn;  //!< the priority of the AO, whose turn it is
+    uint16_t quantum; //!< the number of events dispatched in a turn
+    uint16_t left;    //!< the number of events left in the current turn
+};
+
+static QPrioBand l_band[QF_PRIO_BANDS]; //!< the priority bands
+static uint8_t l_bandOf[QF_MAX_ACTIVE + 1]; //!< 1-based band of prio or 0
+static uint_fast8_t l_nBands; //!< the number of the initialized bands
+
+//****************************************************************************
+/// @description
+/// This function makes the priorities @p lo..@p hi a band, whose active
+/// objects share a single scheduling level. The active objects of the band
+/// still need their own priorities (for the registration in the framework
+/// and for the publish-subscribe), but the scheduler of the QF port does not
+/// order them strictly by these priorities. Instead, the scheduler services
+/// the ready active objects of the band round-robin, each one for
+/// @p quantum events (or until its queue gets empty), so that none of the
+/// equivalent active objects (e.g., workers) can starve the others.
+///
+/// @param[in] lo      the lowest priority of the band
+/// @param[in] hi      the highest priority of the band
+/// @param[in] quantum the number of events an active object of the band
+///                    can process in a single turn (1..0xFFFF)
+///
+/// @note
+/// The active objects of the band are still scheduled strictly against all
+/// other priorities: the band as a whole has the priority @p hi with
+/// respect to any higher priority and @p lo with respect to any lower one.
+///
+/// @note
+/// This function is available only when the application is compiled with
+/// the macro QF_PRIO_BANDS defined to the maximum number of the bands
+/// (1..255) and is supported only by the QF ports, which define the
+/// internal macro QF_BAND_SCHED_ (QV, POSIX-QV, Win32-QV and POSIX). It
+/// must be called after QP::QF::init() and before starting any active
+/// object of the band.
+///
+/// @usage
+/// @code
+/// QP::QF::init();
+/// QP::QF::bandInit(2U, 9U, 4U); // eight workers at prio. 2..9, 4 events
+/// for (uint_fast8_t n = 0U; n < 8U; ++n) {
+///     AO_Worker[n]->start(n + 2U, . . .);
+/// }
+/// @endcode
+///
+void QF::bandInit(QPrio const lo, QPrio const hi,
+                  uint_fast16_t const quantum)
+{
+    /// @pre the band must be within the valid priorities, the quantum
+    /// must fit the band and a free band must be available
+    Q_REQUIRE_ID(300, (static_cast<QPrio>(0) < lo)
+                      && (lo <= hi)
+                      && (hi <= static_cast<QPrio>(QF_MAX_ACTIVE))
+                      && (quantum != static_cast<uint_fast16_t>(0))
+                      && (quantum <= static_cast<uint_fast16_t>(0xFFFF))
+                      && (l_nBands < static_cast<uint_fast8_t>(QF_PRIO_BANDS)));
+
+    QPrioBand * const b = &l_band[l_nBands];
+    b->lo      = static_cast<QPrioStore>(lo);
+    b->hi      = static_cast<QPrioStore>(hi);
+    b->turn    = static_cast<QPrioStore>(lo); // so that hi gets the 1st turn
+    b->quantum = static_cast<uint16_t>(quantum);
+    b->left    = static_cast<uint16_t>(0);
+    ++l_nBands;
+
+    for (QPrio p = lo; p <= hi; ++p) {
+        /// @pre the bands cannot overlap
+        Q_REQUIRE_ID(310, l_bandOf[p] == static_cast<uint8_t>(0));
+        l_bandOf[p] = static_cast<uint8_t>(l_nBands);
+    }
+}
+
+//****************************************************************************
+/// @description
+/// Returns the highest priority of the band of the priority @p p, or @p p
+/// itself if the priority is not in any band. The QF ports, which map the
+/// QF priorities to the priorities of the threads, use this priority for
+/// all active objects of the band (see QP::QF::bandInit()).
+///
+QPrio QF::bandTop_(QPrio const p) {
+    uint_fast8_t const b = static_cast<uint_fast8_t>(l_bandOf[p]);
+    return (b != static_cast<uint_fast8_t>(0))
+           ? static_cast<QPrio>(l_band[b - 1U].hi)
+           : p;
+}
+
+//****************************************************************************
+/// @description
+/// Returns the number of the events an active object of the band of the
+/// priority @p p can process in a single turn, or zero if the priority is
+/// not in any band (see QP::QF::bandInit()).
+///
+uint_fast16_t QF::bandQuantum_(QPrio const p) {
+    uint_fast8_t const b = static_cast<uint_fast8_t>(l_bandOf[p]);
+    return (b != static_cast<uint_fast8_t>(0))
+           ? static_cast<uint_fast16_t>(l_band[b - 1U].quantum)
+           : static_cast<uint_fast16_t>(0);
+}
+
+//****************************************************************************
+/// @description
+/// The scheduler of the QF port calls this function with the highest
+/// priority @p p in the set of the ready active objects @p ready, right
+/// before dispatching a single event to the active object. When @p p is
+/// in a band, the function returns the priority of the active object,
+/// whose turn it is in the band: the same active object as in the previous
+/// call until it uses up the quantum of events or its queue gets empty,
+/// and then the next ready active object of the band below it (wrapping
+/// around from the lowest to the highest priority of the band).
+///
+/// @returns the priority of the active object to dispatch the next event.
+///
+/// @note
+/// Must be called inside the critical section of the scheduler (with the
+/// set @p ready stable), because it updates the turn of the band.
+///
+QPrio QF::bandNext_(QPrio const p, QPSet const &ready) {
+    uint_fast8_t const b = static_cast<uint_fast8_t>(l_bandOf[p]);
+    QPrio n = p;
+    if (b != static_cast<uint_fast8_t>(0)) { // the priority in a band?
+        QPrioBand * const band = &l_band[b - 1U];
+        n = static_cast<QPrio>(band->turn);
+
+        // the turn is over or the AO has nothing to do?
+        if ((band->left == static_cast<uint16_t>(0))
+            || (!ready.hasElement(n)))
+        {
+            // the next ready AO of the band (p itself is ready)
+            do {
+                n = (n > static_cast<QPrio>(band->lo))
+                    ? (n - static_cast<QPrio>(1))
+                    : static_cast<QPrio>(band->hi);
+            } while (!ready.hasElement(n));
+            band->turn = static_cast<QPrioStore>(n);
+            band->left = band->quantum;
+        }
+        --band->left;
+    }
+    return n;
+}
+
+#endif // QF_PRIO_BANDS
+
 //****************************************************************************
 /// @description
 /// macro to encapsulate pointer increment, which violates MISRA-C:2004
@@ -147,7 +302,7 @@ void QF::bzero(void * const start, uint_fast16_t len) {
 /// of a 32-bit bitmask. This function can be replaced in the QP ports, if
 /// the CPU has special instructions, such as CLZ (count leading zeros).
 ///
-uint_fast8_t QPSet::findMax(void) const {
+static uint_fast8_t bitLog2(uint32_t x) {
     static uint8_t const log2LUT[16] = {
         static_cast<uint8_t>(0), static_cast<uint8_t>(1),
         static_cast<uint8_t>(2), static_cast<uint8_t>(2),
@@ -158,21 +313,7 @@ uint_fast8_t QPSet::findMax(void) const {
         static_cast<uint8_t>(4), static_cast<uint8_t>(4),
         static_cast<uint8_t>(4), static_cast<uint8_t>(4)
     };
-#if (QF_MAX_ACTIVE <= 32)
-    uint32_t x = m_bits;
     uint_fast8_t n = static_cast<uint_fast8_t>(0);
-#else
-    uint32_t x;
-    uint_fast8_t n;
-    if (m_bits[1] != static_cast<uint32_t>(0)) {
-        x = m_bits[1];
-        n = static_cast<uint_fast8_t>(32);
-    }
-    else {
-        x = m_bits[0];
-        n = static_cast<uint_fast8_t>(0);
-    }
-#endif
     if (x != static_cast<uint32_t>(0)) {
         uint32_t t = (x >> 16);
         if (t != static_cast<uint32_t>(0)) {
@@ -194,6 +335,30 @@ uint_fast8_t QPSet::findMax(void) const {
     return n;
 }
 
+//****************************************************************************
+/// @description
+/// Finds the maximum element of the priority set with the function
+/// bitLog2(), which is used when the QP port does not define QF_LOG2().
+///
+QPrio QPSet::findMax(void) const {
+#if (QF_MAX_ACTIVE <= 32)
+    return static_cast<QPrio>(bitLog2(m_bits));
+#elif (QF_MAX_ACTIVE <= 64)
+    return (m_bits[1] != static_cast<uint32_t>(0))
+           ? (bitLog2(m_bits[1]) + static_cast<QPrio>(32))
+           : bitLog2(m_bits[0]);
+#else // hierarchical priority set
+    QPrio n = static_cast<QPrio>(0);
+    if (m_top != static_cast<uint32_t>(0)) {
+        QPrio const s = static_cast<QPrio>(bitLog2(m_top)) - 1U;
+        QPrio const l = (s << 5)
+            + static_cast<QPrio>(bitLog2(m_sum[s])) - 1U;
+        n = (l << 5) + static_cast<QPrio>(bitLog2(m_leaf[l]));
+    }
+    return n;
+#endif // QF_MAX_ACTIVE
+}
+
 #endif // QF_LOG2
 
 } // namespace QP
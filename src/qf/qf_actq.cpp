@@ -55,6 +55,9 @@ namespace QP {
 
 Q_DEFINE_THIS_MODULE("qf_actq")
 
+// the event queue operations of active objects might be provided in the port
+#ifndef QACTIVE_EQUEUE_PORT_
+
 //****************************************************************************
 /// @description
 /// Direct event posting is the simplest asynchronous communication method
@@ -98,7 +101,7 @@ bool QActive::post_(QEvt const * const e, uint_fast16_t const margin,
     /// @pre event pointer must be valid
     Q_REQUIRE_ID(100, e != static_cast<QEvt const *>(0));
 
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(m_eQueue.m_lock);
     QEQueueCtr nFree = m_eQueue.m_nFree; // get volatile into the temporary
 
     // test-probe#1 for faking queue overflow
@@ -112,7 +115,8 @@ bool QActive::post_(QEvt const * const e, uint_fast16_t const margin,
         }
         else {
             status = false; // cannot post
-            Q_ERROR_CRIT_(110); // must be able to post the event
+            // must be able to post the event
+            Q_ERROR_OBJ_CRIT_(m_eQueue.m_lock, 110);
         }
     }
     else if (nFree > static_cast<QEQueueCtr>(margin)) {
@@ -124,7 +128,9 @@ bool QActive::post_(QEvt const * const e, uint_fast16_t const margin,
 
     // is it a dynamic event?
     if (e->poolId_ != static_cast<uint8_t>(0)) {
+        QF_EVT_NEST_ENTRY_(e);
         QF_EVT_REF_CTR_INC_(e); // increment the reference counter
+        QF_EVT_NEST_EXIT_(e);
     }
 
     if (status) { // can post the event?
@@ -160,13 +166,14 @@ bool QActive::post_(QEvt const * const e, uint_fast16_t const margin,
 #endif
         // empty queue?
         if (m_eQueue.m_frontEvt == static_cast<QEvt const *>(0)) {
-            m_eQueue.m_frontEvt = e;      // deliver event directly
+            m_eQueue.m_frontEvt = QF_EVT_TO_SLOT_(e); // deliver directly
             QACTIVE_EQUEUE_SIGNAL_(this); // signal the event queue
         }
         // queue is not empty, insert event into the ring-buffer
         else {
             // insert event pointer e into the buffer (FIFO)
-            QF_PTR_AT_(m_eQueue.m_ring, m_eQueue.m_head) = e;
+            QF_PTR_AT_(m_eQueue.m_ring, m_eQueue.m_head) =
+                QF_EVT_TO_SLOT_(e);
 
             // need to wrap head?
             if (m_eQueue.m_head == static_cast<QEQueueCtr>(0)) {
@@ -175,7 +182,7 @@ bool QActive::post_(QEvt const * const e, uint_fast16_t const margin,
             --m_eQueue.m_head; // advance the head (counter clockwise)
         }
 
-        QF_CRIT_EXIT_();
+        QF_OBJ_CRIT_EXIT_(m_eQueue.m_lock);
     }
     else { // cannot post the event
 
@@ -203,7 +210,7 @@ bool QActive::post_(QEvt const * const e, uint_fast16_t const margin,
         }
 #endif
 
-        QF_CRIT_EXIT_();
+        QF_OBJ_CRIT_EXIT_(m_eQueue.m_lock);
 
         QF::gc(e); // recycle the event to avoid a leak
     }
@@ -229,7 +236,7 @@ void QActive::postLIFO(QEvt const * const e) {
     QF_CRIT_STAT_
     QS_TEST_PROBE_DEF(&QActive::postLIFO)
 
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(m_eQueue.m_lock);
     QEQueueCtr nFree = m_eQueue.m_nFree;// tmp to avoid UB for volatile access
 
     QS_TEST_PROBE_ID(1,
@@ -237,15 +244,21 @@ void QActive::postLIFO(QEvt const * const e) {
     )
 
     // the queue must be able to accept the event (cannot overflow)
-    Q_ASSERT_CRIT_(210, nFree != static_cast<QEQueueCtr>(0));
+    Q_ASSERT_OBJ_CRIT_(m_eQueue.m_lock, 210,
+                       nFree != static_cast<QEQueueCtr>(0));
 
     // is it a dynamic event?
     if (e->poolId_ != static_cast<uint8_t>(0)) {
+        QF_EVT_NEST_ENTRY_(e);
         QF_EVT_REF_CTR_INC_(e); // increment the reference counter
+        QF_EVT_NEST_EXIT_(e);
     }
 
     --nFree;  // one free entry just used up
     m_eQueue.m_nFree = nFree; // update the volatile
+#ifdef QF_DRAIN_MAX
+    ++m_lifoCtr; // one more event at the front, see QActive::getBatch_()
+#endif
     if (m_eQueue.m_nMin > nFree) {
         m_eQueue.m_nMin = nFree; // update minimum so far
     }
@@ -274,7 +287,8 @@ void QActive::postLIFO(QEvt const * const e) {
 #endif
 
     QEvt const *frontEvt = m_eQueue.m_frontEvt;// read volatile into temporary
-    m_eQueue.m_frontEvt = e; // deliver the event directly to the front
+    // deliver the event directly to the front
+    m_eQueue.m_frontEvt = QF_EVT_TO_SLOT_(e);
 
     // was the queue empty?
     if (frontEvt == static_cast<QEvt const *>(0)) {
@@ -289,8 +303,168 @@ void QActive::postLIFO(QEvt const * const e) {
 
         QF_PTR_AT_(m_eQueue.m_ring, m_eQueue.m_tail) = frontEvt;
     }
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(m_eQueue.m_lock);
+}
+
+//****************************************************************************
+/// @description
+/// Posts a batch of events to the event queue of the active object using
+/// the First-In-First-Out (FIFO) policy. All the events are enqueued in the
+/// order of the array within a single critical section, with a single
+/// QS trace record and at most one signaling of the event queue.
+///
+/// @param[in] evts   array of pointers to the events to post
+/// @param[in] n      number of the events in the array (at least 1)
+/// @param[in] margin number of required free slots in the queue
+///                   after posting all the events. The special value
+///                   QP::QF_NO_MARGIN means that this function will assert
+///                   if posting fails.
+///
+/// @returns
+/// 'true' (success) if all the events have been posted and 'false'
+/// (failure) if the queue cannot accept all of them with the provided
+/// margin, in which case none of the events is posted.
+///
+/// @attention
+/// Should be called only via the macro POST_BATCH() or POST_BATCH_X().
+///
+/// @sa
+/// QActive::post_()
+///
+#ifndef QF_NO_POST_BATCH
+#ifndef Q_SPY
+bool QActive::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                         uint_fast16_t const margin)
+#else
+bool QActive::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                         uint_fast16_t const margin,
+                         void const * const sender)
+#endif
+{
+    bool status;
+    uint_fast16_t i;
+    QF_CRIT_STAT_
+
+    /// @pre the array of events must be valid and not empty
+    Q_REQUIRE_ID(600, (evts != static_cast<QEvt const * const *>(0))
+                      && (n != static_cast<uint_fast16_t>(0)));
+
+    QF_OBJ_CRIT_ENTRY_(m_eQueue.m_lock);
+    QEQueueCtr nFree = m_eQueue.m_nFree; // get volatile into the temporary
+
+    // reserve all n entries at once (all or nothing)
+    if (margin == QF_NO_MARGIN) {
+        if (static_cast<uint_fast16_t>(nFree) >= n) {
+            status = true; // can post
+        }
+        else {
+            status = false; // cannot post
+            // must be able to post the events
+            Q_ERROR_OBJ_CRIT_(m_eQueue.m_lock, 610);
+        }
+    }
+    else if (static_cast<uint_fast32_t>(nFree)
+             >= (static_cast<uint_fast32_t>(n)
+                 + static_cast<uint_fast32_t>(margin)))
+    {
+        status = true; // can post
+    }
+    else {
+        status = false; // cannot post, but don't assert
+    }
+
+    for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        QEvt const * const e = evts[i];
+
+        // is it a dynamic event?
+        if (e->poolId_ != static_cast<uint8_t>(0)) {
+            QF_EVT_NEST_ENTRY_(e);
+            QF_EVT_REF_CTR_INC_(e); // increment the reference counter
+            QF_EVT_NEST_EXIT_(e);
+        }
+    }
+
+    if (status) { // can post the events?
+        // was the queue empty before the batch?
+        bool const wasEmpty =
+            (m_eQueue.m_frontEvt == static_cast<QEvt const *>(0));
+
+        for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+            QEvt const * const e = evts[i];
+
+            // empty queue?
+            if (m_eQueue.m_frontEvt == static_cast<QEvt const *>(0)) {
+                m_eQueue.m_frontEvt = QF_EVT_TO_SLOT_(e); // deliver directly
+            }
+            // queue is not empty, insert event into the ring-buffer
+            else {
+                // insert event pointer e into the buffer (FIFO)
+                QF_PTR_AT_(m_eQueue.m_ring, m_eQueue.m_head) =
+                    QF_EVT_TO_SLOT_(e);
+
+                // need to wrap head?
+                if (m_eQueue.m_head == static_cast<QEQueueCtr>(0)) {
+                    m_eQueue.m_head = m_eQueue.m_end; // wrap around
+                }
+                --m_eQueue.m_head; // advance the head (counter clockwise)
+            }
+
+#ifdef Q_UTEST
+            // callback to examine every posted event, see QActive::post_()
+            if ((QS::priv_.locFilter[QS::AO_OBJ]
+                 == static_cast<QActive *>(0))
+                || (QS::priv_.locFilter[QS::AO_OBJ] == this))
+            {
+                QS::onTestPost(sender, this, e, status);
+            }
+#endif
+        }
+
+        nFree -= static_cast<QEQueueCtr>(n); // n free entries just used up
+        m_eQueue.m_nFree = nFree; // update the volatile
+        if (m_eQueue.m_nMin > nFree) {
+            m_eQueue.m_nMin = nFree; // update minimum so far
+        }
+
+        QS_BEGIN_NOCRIT_(QS_QF_POST_BATCH,
+                         QS::priv_.locFilter[QS::AO_OBJ], this)
+            QS_TIME_();               // timestamp
+            QS_OBJ_(sender);          // the sender object
+            QS_OBJ_(this);            // this active object
+            QS_EQC_(static_cast<QEQueueCtr>(n)); // number of events posted
+            QS_EQC_(nFree);           // number of free entries
+            QS_EQC_(m_eQueue.m_nMin); // min number of free entries
+        QS_END_NOCRIT_()
+
+        if (wasEmpty) {
+            QACTIVE_EQUEUE_SIGNAL_(this); // signal the event queue once
+        }
+
+        QF_OBJ_CRIT_EXIT_(m_eQueue.m_lock);
+    }
+    else { // cannot post the events
+
+        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_POST_ATTEMPT,
+                         QS::priv_.locFilter[QS::AO_OBJ], this)
+            QS_TIME_();           // timestamp
+            QS_OBJ_(sender);      // the sender object
+            QS_SIG_(evts[0]->sig);// the signal of the first event
+            QS_OBJ_(this);        // this active object
+            QS_2U8_(evts[0]->poolId_, evts[0]->refCtr_); // of the first evt
+            QS_EQC_(nFree);       // number of free entries
+            QS_EQC_(static_cast<QEQueueCtr>(margin)); // margin requested
+        QS_END_NOCRIT_()
+
+        QF_OBJ_CRIT_EXIT_(m_eQueue.m_lock);
+
+        for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+            QF::gc(evts[i]); // recycle the event to avoid a leak
+        }
+    }
+
+    return status;
 }
+#endif // QF_NO_POST_BATCH
 
 //****************************************************************************
 /// @description
@@ -301,7 +475,9 @@ void QActive::postLIFO(QEvt const * const e) {
 ///
 /// @returns
 /// A pointer to the received event. The returned pointer is guaranteed to be
-/// valid (can't be NULL).
+/// valid (can't be NULL), except for a stale doorbell of a broadcast
+/// channel (see NOTE5 in qf_ps.cpp), for which the QF port must skip the
+/// RTC step.
 ///
 /// @note
 /// This function is used internally by a QF port to extract events from
@@ -314,12 +490,19 @@ void QActive::postLIFO(QEvt const * const e) {
 QEvt const *QActive::get_(void) {
     QF_CRIT_STAT_
 
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(m_eQueue.m_lock);
     QACTIVE_EQUEUE_WAIT_(this); // wait for event to arrive directly
 
-    QEvt const *e = m_eQueue.m_frontEvt; // always remove evt from the front
+    // always remove evt from the front
+    QEvt const *e = QF_EVT_FROM_SLOT_(m_eQueue.m_frontEvt,
+                                      m_eQueue.m_inlineEvt);
     QEQueueCtr nFree = m_eQueue.m_nFree + static_cast<QEQueueCtr>(1);
     m_eQueue.m_nFree = nFree; // upate the number of free
+#ifdef QF_DRAIN_MAX
+    if (m_lifoCtr != static_cast<uint_fast16_t>(0)) { // event posted LIFO?
+        --m_lifoCtr; // one less event at the front, see QF_DRAIN_MAX
+    }
+#endif
 
     // any events in the ring buffer?
     if (nFree <= m_eQueue.m_end) {
@@ -345,7 +528,7 @@ QEvt const *QActive::get_(void) {
         m_eQueue.m_frontEvt = static_cast<QEvt const *>(0);
 
         // all entries in the queue must be free (+1 for fronEvt)
-        Q_ASSERT_CRIT_(310, nFree ==
+        Q_ASSERT_OBJ_CRIT_(m_eQueue.m_lock, 310, nFree ==
                             (m_eQueue.m_end + static_cast<QEQueueCtr>(1)));
 
         QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_GET_LAST,
@@ -356,10 +539,127 @@ QEvt const *QActive::get_(void) {
             QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr of the evt
         QS_END_NOCRIT_()
     }
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(m_eQueue.m_lock);
+
+#ifdef QF_PS_BROADCAST
+    // the doorbell of a broadcast channel? see NOTE5 in qf_ps.cpp
+    if (e->sig == QF_BCAST_SIG_) {
+        e = static_cast<QBroadcast *>(QF_EVT_CONST_CAST_(e))->take_(this);
+    }
+#endif // QF_PS_BROADCAST
     return e;
 }
 
+#ifdef QF_DRAIN_MAX
+//****************************************************************************
+/// @description
+/// The behavior of this function is the same as calling QActive::get_()
+/// up to @p n times, except that the lock of the event queue is taken only
+/// once and the function blocks only until the first event arrives.
+///
+/// @param[out] evts array to receive the events removed from the queue
+/// @param[in]  n    the maximum number of events to remove (at least 1)
+///
+/// @returns
+/// the number of events removed from the queue (up to n), in the order in
+/// which they must be dispatched. The stale doorbells of broadcast channels
+/// are left out, so the number can be 0 (see QP::QActive::get_()).
+///
+/// @note
+/// A QP::QInlineEvt is copied to the single buffer of the queue, so that
+/// an inline event always ends the batch. The caller must copy it out of
+/// the buffer before calling QActive::get_() again.
+///
+/// @note
+/// The events posted LIFO later are counted in QActive::m_lifoCtr, which
+/// is cleared here in the same critical section as the events are removed.
+///
+/// @sa
+/// #QF_DRAIN_MAX, QP::QF::gcBatch_()
+///
+uint_fast16_t QActive::getBatch_(QEvt const *evts[], uint_fast16_t const n) {
+    uint_fast16_t i = static_cast<uint_fast16_t>(0);
+    QEvt const *e;
+    QF_CRIT_STAT_
+
+    /// @pre at least one event must be requested
+    Q_REQUIRE_ID(700, n != static_cast<uint_fast16_t>(0));
+
+    QF_OBJ_CRIT_ENTRY_(m_eQueue.m_lock);
+    QACTIVE_EQUEUE_WAIT_(this); // wait for event to arrive directly
+
+    do {
+        // always remove evt from the front
+        e = QF_EVT_FROM_SLOT_(m_eQueue.m_frontEvt, m_eQueue.m_inlineEvt);
+        QEQueueCtr nFree = m_eQueue.m_nFree + static_cast<QEQueueCtr>(1);
+        m_eQueue.m_nFree = nFree; // upate the number of free
+
+        // any events in the ring buffer?
+        if (nFree <= m_eQueue.m_end) {
+
+            // remove event from the tail
+            m_eQueue.m_frontEvt =
+                QF_PTR_AT_(m_eQueue.m_ring, m_eQueue.m_tail);
+            if (m_eQueue.m_tail == static_cast<QEQueueCtr>(0)) { // wrap?
+                m_eQueue.m_tail = m_eQueue.m_end; // wrap around
+            }
+            --m_eQueue.m_tail;
+
+            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_GET,
+                             QS::priv_.locFilter[QS::AO_OBJ], this)
+                QS_TIME_();                      // timestamp
+                QS_SIG_(e->sig);                 // the signal of this event
+                QS_OBJ_(this);                   // this active object
+                QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr of evt
+                QS_EQC_(nFree);                  // number of free entries
+            QS_END_NOCRIT_()
+        }
+        else {
+            // the queue becomes empty
+            m_eQueue.m_frontEvt = static_cast<QEvt const *>(0);
+
+            // all entries in the queue must be free (+1 for fronEvt)
+            Q_ASSERT_OBJ_CRIT_(m_eQueue.m_lock, 710, nFree ==
+                               (m_eQueue.m_end + static_cast<QEQueueCtr>(1)));
+
+            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_GET_LAST,
+                             QS::priv_.locFilter[QS::AO_OBJ], this)
+                QS_TIME_();                      // timestamp
+                QS_SIG_(e->sig);                 // the signal of this event
+                QS_OBJ_(this);                   // this active object
+                QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr of evt
+            QS_END_NOCRIT_()
+        }
+
+        evts[i] = e;
+        ++i;
+    } while ((i < n)
+             && (m_eQueue.m_frontEvt != static_cast<QEvt const *>(0))
+             && (!QF_EVT_IS_INLINE_(e, m_eQueue.m_inlineEvt)));
+
+    m_lifoCtr = static_cast<uint_fast16_t>(0); // no events posted LIFO yet
+    QF_OBJ_CRIT_EXIT_(m_eQueue.m_lock);
+
+#ifdef QF_PS_BROADCAST
+    // replace the doorbells of broadcast channels, see NOTE5 in qf_ps.cpp
+    uint_fast16_t j;
+    uint_fast16_t k = static_cast<uint_fast16_t>(0);
+    for (j = static_cast<uint_fast16_t>(0); j < i; ++j) {
+        e = evts[j];
+        if (e->sig == QF_BCAST_SIG_) {
+            e = static_cast<QBroadcast *>(QF_EVT_CONST_CAST_(e))->take_(this);
+        }
+        if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+            evts[k] = e;
+            ++k;
+        }
+    }
+    i = k;
+#endif // QF_PS_BROADCAST
+    return i;
+}
+#endif // QF_DRAIN_MAX
+
 //****************************************************************************
 /// @description
 /// Queries the minimum of free ever present in the given event queue of
@@ -378,16 +678,16 @@ QEvt const *QActive::get_(void) {
 /// the minimum of free ever present in the given event queue of an active
 /// object with priority @p prio, since the active object was started.
 ///
-uint_fast16_t QF::getQueueMin(uint_fast8_t const prio) {
+uint_fast16_t QF::getQueueMin(QPrio const prio) {
 
-    Q_REQUIRE_ID(400, (prio <= static_cast<uint_fast8_t>(QF_MAX_ACTIVE))
+    Q_REQUIRE_ID(400, (prio <= static_cast<QPrio>(QF_MAX_ACTIVE))
                       && (active_[prio] != static_cast<QActive *>(0)));
 
     QF_CRIT_STAT_
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(active_[prio]->m_eQueue.m_lock);
     uint_fast16_t min =
         static_cast<uint_fast16_t>(active_[prio]->m_eQueue.m_nMin);
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(active_[prio]->m_eQueue.m_lock);
 
     return min;
 }
@@ -406,10 +706,10 @@ void QTicker::init(QEvt const * const /*e*/) {
 //............................................................................
 void QTicker::dispatch(QEvt const * const /*e*/) {
     QF_CRIT_STAT_
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(m_eQueue.m_lock);
     QEQueueCtr n = m_eQueue.m_tail; // # ticks since the last call
     m_eQueue.m_tail = static_cast<QEQueueCtr>(0); // clear the # ticks
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(m_eQueue.m_lock);
 
     for (; n > static_cast<QEQueueCtr>(0); --n) {
         QF::TICK_X(static_cast<uint_fast8_t>(m_eQueue.m_head), this);
@@ -424,7 +724,7 @@ bool QTicker::post_(QEvt const * const /*e*/, uint_fast16_t const /*margin*/,
 #endif
 {
     QF_CRIT_STAT_
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(m_eQueue.m_lock);
     if (m_eQueue.m_frontEvt == static_cast<QEvt const *>(0)) {
 
 #ifdef Q_EVT_CTOR
@@ -456,7 +756,7 @@ bool QTicker::post_(QEvt const * const /*e*/, uint_fast16_t const /*margin*/,
         QS_EQC_(static_cast<uint8_t>(0)); // min number of free entries
     QS_END_NOCRIT_()
 
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(m_eQueue.m_lock);
 
     return true; // the event is always posted correctly
 }
@@ -465,6 +765,74 @@ bool QTicker::post_(QEvt const * const /*e*/, uint_fast16_t const /*margin*/,
 void QTicker::postLIFO(QEvt const * const /*e*/) {
     Q_ERROR_ID(900); // operation not allowed
 }
+//............................................................................
+#ifndef QF_NO_POST_BATCH
+#ifndef Q_SPY
+bool QTicker::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                         uint_fast16_t const margin)
+#else
+bool QTicker::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                         uint_fast16_t const margin,
+                         void const * const sender)
+#endif
+{
+    uint_fast16_t i;
+    for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        (void)POST_X(evts[i], margin, sender); // each event is one tick
+    }
+    return true; // the events are always posted correctly
+}
+#endif // QF_NO_POST_BATCH
+
+#endif // QACTIVE_EQUEUE_PORT_
+
+#ifdef QF_EVT_INLINE
+//****************************************************************************
+/// @description
+/// Posts a small event by value, without allocating it from an event pool.
+/// The event is built on the stack of the caller and packed into the slot
+/// of the event queue by the regular QP::QActive::post_() operation, so it
+/// is subject to the same margin and QS tracing as any other event.
+///
+/// @param[in] sig    signal of the event to post
+/// @param[in] par    parameter of the event to post, which must fit into
+///                   the slot of the event queue (see QP::QInlineEvt)
+/// @param[in] margin number of required free slots in the queue
+///                   after posting the event. The special value
+///                   QP::QF_NO_MARGIN means that this function will assert
+///                   if posting fails.
+///
+/// @returns
+/// 'true' (success) if the posting succeeded (with the provided margin) and
+/// 'false' (failure) when the posting fails.
+///
+/// @attention
+/// Should be called only via the macro POST_INLINE() or POST_INLINE_X().
+///
+#ifndef Q_SPY
+bool QActive::postInline_(QSignal const sig, uint32_t const par,
+                          uint_fast16_t const margin)
+#else
+bool QActive::postInline_(QSignal const sig, uint32_t const par,
+                          uint_fast16_t const margin,
+                          void const * const sender)
+#endif
+{
+    /// @pre the parameter must fit into the slot of the event queue
+    Q_REQUIRE_ID(500, QInlineEvt::fits_(par));
+
+    QInlineEvt ie;
+    ie.sig = sig;
+    ie.par = par;
+    QInlineEvt::mark_(&ie);
+
+#ifndef Q_SPY
+    return post_(&ie, margin);
+#else
+    return post_(&ie, margin, sender);
+#endif
+}
+#endif // QF_EVT_INLINE
 
 } // namespace QP
 
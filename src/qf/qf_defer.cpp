@@ -117,33 +117,43 @@ bool QActive::recall(QEQueue * const eq) {
     if (e != static_cast<QEvt const *>(0)) {
         this->postLIFO(e); // post it to the _front_ of the AO's queue
 
-        QF_CRIT_STAT_
-        QF_CRIT_ENTRY_();
-
         // is it a dynamic event?
         if (e->poolId_ != static_cast<uint8_t>(0)) {
+#ifndef QF_EVT_REF_ATOMIC
+            QF_CRIT_STAT_
+            QF_OBJ_CRIT_ENTRY_(QF_EVT_LOCK_(e));
 
             // after posting to the AO's queue the event must be referenced
             // at least twice: once in the deferred event queue (eq->get()
             // did NOT decrement the reference counter) and once in the
             // AO's event queue.
-            Q_ASSERT_CRIT_(210, e->refCtr_ >= static_cast<uint8_t>(2));
+            Q_ASSERT_OBJ_CRIT_(QF_EVT_LOCK_(e), 210,
+                               e->refCtr_ >= static_cast<QEvtRefCtr>(2));
 
             // we need to decrement the reference counter once, to account
             // for removing the event from the deferred event queue.
             QF_EVT_REF_CTR_DEC_(e); // decrement the reference counter
+
+            QF_OBJ_CRIT_EXIT_(QF_EVT_LOCK_(e));
+#else
+            // the same as above, but the atomic reference counter needs
+            // no critical section
+            Q_ASSERT_ID(210,
+                QF_EVT_REF_CTR_GET_(e) >= static_cast<QEvtRefCtr>(2));
+            QF_EVT_REF_CTR_DEC_(e); // decrement the reference counter
+#endif // QF_EVT_REF_ATOMIC
         }
 
-        QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_RECALL,
-                         QS::priv_.locFilter[QS::AO_OBJ], this)
+        QS_CRIT_STAT_
+        QS_BEGIN_(QS_QF_ACTIVE_RECALL,
+                  QS::priv_.locFilter[QS::AO_OBJ], this)
             QS_TIME_();      // time stamp
             QS_OBJ_(this);   // this active object
             QS_OBJ_(eq);     // the deferred queue
             QS_SIG_(e->sig); // the signal of the event
             QS_2U8_(e->poolId_, e->refCtr_); // pool Id & ref Count
-        QS_END_NOCRIT_()
+        QS_END_()
 
-        QF_CRIT_EXIT_();
         recalled = true;
     }
     else {
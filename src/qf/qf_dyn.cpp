@@ -53,6 +53,216 @@ Q_DEFINE_THIS_MODULE("qf_dyn")
 QF_EPOOL_TYPE_ QF_pool_[QF_MAX_EPOOL]; // allocate the event pools
 uint_fast8_t QF_maxPool_;              // number of initialized event pools
 
+#ifdef QF_OBJ_LOCK_TYPE
+QF_OBJ_LOCK_TYPE QF_evtLock_[QF_MAX_EPOOL]; // event reference-counter locks
+#endif // QF_OBJ_LOCK_TYPE
+
+// Local objects *************************************************************
+enum {
+    // number of event-size classes (4 classes per power of 2), see NOTE3
+    QF_SIZE_CLASSES = 4 * ((8 * QF_EVENT_SIZ_SIZE) - 1)
+};
+
+//! index of the first event pool that can hold the smallest event size
+//! of the given size class
+static uint8_t l_classPool[QF_SIZE_CLASSES];
+
+//! flags of the event pools dedicated to a single event type (QEvtPool)
+static bool l_typedPool[QF_MAX_EPOOL];
+
+//! flags of the event pools dedicated to events carrying buffers (QBufEvt)
+static bool l_bufEvtPool[QF_MAX_EPOOL];
+
+//............................................................................
+//! the size class of the event size @p size (> 0), see NOTE3
+static uint_fast8_t sizeClass(uint32_t const size) {
+    uint32_t const n = size - static_cast<uint32_t>(1);
+    uint_fast8_t c;
+
+    if (n < static_cast<uint32_t>(4)) {
+        c = static_cast<uint_fast8_t>(n);
+    }
+    else {
+        // e = floor(log2(n)), which is at least 2 here
+#ifdef QF_LOG2
+        uint_fast8_t const e = static_cast<uint_fast8_t>(QF_LOG2(n))
+                               - static_cast<uint_fast8_t>(1);
+#else
+        uint_fast8_t e = static_cast<uint_fast8_t>(0);
+        uint32_t x = n;
+        uint_fast8_t sh = static_cast<uint_fast8_t>(16);
+        do { // binary search for the most significant 1-bit
+            if ((x >> sh) != static_cast<uint32_t>(0)) {
+                x >>= sh;
+                e += sh;
+            }
+            sh >>= 1;
+        } while (sh != static_cast<uint_fast8_t>(0));
+#endif // QF_LOG2
+        // 4 classes per power of 2 selected by the 2 bits following the MSB
+        c = static_cast<uint_fast8_t>(
+                (static_cast<uint_fast8_t>(4) * (e - 1U))
+                + static_cast<uint_fast8_t>(
+                      (n >> (e - 2U)) & static_cast<uint32_t>(3)));
+    }
+    return c;
+}
+//............................................................................
+//! the smallest event size in the size class @p c
+static uint32_t sizeClassMin(uint_fast8_t const c) {
+    uint32_t n;
+    if (c < static_cast<uint_fast8_t>(4)) {
+        n = static_cast<uint32_t>(c);
+    }
+    else {
+        n = (static_cast<uint32_t>(4) + static_cast<uint32_t>(c & 3U))
+            << ((c >> 2) - 1U);
+    }
+    return n + static_cast<uint32_t>(1);
+}
+
+#ifdef QF_MAGAZINE_SIZE
+//****************************************************************************
+// per-thread magazines of free event blocks, see NOTE2
+
+//............................................................................
+static void *magazineGet(uint_fast8_t const idx) {
+    QFMagazine * const mags = QF_magazines_();
+    void *b = static_cast<void *>(0);
+
+    if (mags != static_cast<QFMagazine *>(0)) { // magazines available?
+        QFMagazine &mag = mags[idx];
+        if (mag.m_n == static_cast<uint_fast16_t>(0)) { // magazine empty?
+            // refill half of the magazine from the event pool
+            mag.m_n = QF_EPOOL_GET_MANY_(QF_pool_[idx], &mag.m_blk[0],
+                static_cast<uint_fast16_t>(QF_MAGAZINE_SIZE / 2));
+        }
+        if (mag.m_n != static_cast<uint_fast16_t>(0)) {
+            --mag.m_n;
+            b = mag.m_blk[mag.m_n];
+        }
+    }
+    return b;
+}
+//............................................................................
+static bool magazinePut(uint_fast8_t const idx, void * const b) {
+    QFMagazine * const mags = QF_magazines_();
+    bool status = (mags != static_cast<QFMagazine *>(0));
+
+    if (status) { // magazines available?
+        QFMagazine &mag = mags[idx];
+        if (mag.m_n == static_cast<uint_fast16_t>(QF_MAGAZINE_SIZE)) {
+            // flush the upper half of the full magazine to the event pool
+            mag.m_n = static_cast<uint_fast16_t>(QF_MAGAZINE_SIZE / 2);
+            QF_EPOOL_PUT_MANY_(QF_pool_[idx], &mag.m_blk[mag.m_n],
+                static_cast<uint_fast16_t>(QF_MAGAZINE_SIZE) - mag.m_n);
+        }
+        mag.m_blk[mag.m_n] = b;
+        ++mag.m_n;
+    }
+    return status;
+}
+//............................................................................
+/// @description
+/// Returns all free blocks cached in the magazines @p mags to the event
+/// pools. The QF port calls this function when the thread owning the
+/// magazines terminates.
+///
+void QF_magazineFlush_(QFMagazine * const mags) {
+    for (uint_fast8_t idx = static_cast<uint_fast8_t>(0);
+         idx < QF_maxPool_;
+         ++idx)
+    {
+        if (mags[idx].m_n != static_cast<uint_fast16_t>(0)) {
+            QF_EPOOL_PUT_MANY_(QF_pool_[idx], &mags[idx].m_blk[0],
+                               mags[idx].m_n);
+            mags[idx].m_n = static_cast<uint_fast16_t>(0);
+        }
+    }
+}
+
+//****************************************************************************
+// NOTE2:
+// The optional per-thread magazines (QF_MAGAZINE_SIZE) keep the blocks
+// recycled by a thread for its own subsequent allocations, so that the
+// shared event pools (and their cache lines) are accessed only once per
+// QF_MAGAZINE_SIZE/2 events, in batches. Only the allocations without
+// margin are served from the magazines, because the margin must be checked
+// against the event pool. The event pools see the blocks in the magazines
+// as allocated, so the QS_QF_MPOOL_GET/PUT records account for every block
+// that leaves or enters a pool and the low-watermark reported by
+// QF::getPoolMin() never overstates the number of available blocks (it can
+// understate it by at most QF_MAGAZINE_SIZE blocks per thread).
+//
+// The blocks cached in the magazine of one thread are not available to the
+// other threads, so the event pools must be sized with QF_MAGAZINE_SIZE
+// extra blocks for every thread allocating or recycling events. Otherwise
+// an allocation without margin can fail even though some magazines still
+// hold free blocks.
+//
+#endif // QF_MAGAZINE_SIZE
+
+//****************************************************************************
+//! add a new event pool, shared by all event types or dedicated to one
+static uint_fast8_t poolAdd(void * const poolSto,
+                            uint_fast32_t const poolSize,
+                            uint_fast16_t const evtSize,
+                            bool const typed, bool const bufEvt)
+{
+    /// @pre cannot exceed the number of available memory pools
+    Q_REQUIRE_ID(200, QF_maxPool_
+                      < static_cast<uint_fast8_t>(Q_DIM(QF_pool_)));
+
+    QF_EPOOL_INIT_(QF_pool_[QF_maxPool_], poolSto, poolSize, evtSize);
+#ifdef QF_OBJ_LOCK_TYPE
+    QF_OBJ_LOCK_INIT(&QF_evtLock_[QF_maxPool_]);
+#endif // QF_OBJ_LOCK_TYPE
+    l_typedPool[QF_maxPool_]  = typed;
+    l_bufEvtPool[QF_maxPool_] = bufEvt;
+    ++QF_maxPool_; // one more pool
+
+    // update the first pool for every size class, see NOTE3
+    for (uint_fast8_t c = static_cast<uint_fast8_t>(0);
+         c < static_cast<uint_fast8_t>(QF_SIZE_CLASSES);
+         ++c)
+    {
+        uint_fast8_t idx = static_cast<uint_fast8_t>(0);
+        while ((idx < QF_maxPool_)
+               && (l_typedPool[idx]
+                   || (static_cast<uint32_t>(
+                           QF_EPOOL_EVENT_SIZE_(QF_pool_[idx]))
+                       < sizeClassMin(c))))
+        {
+            ++idx;
+        }
+        l_classPool[c] = static_cast<uint8_t>(idx);
+    }
+
+#ifdef Q_SPY
+    // generate the object-dictionary entry for the initialized pool
+    char_t obj_name[11] = "EvtPool";
+    uint_fast8_t i = static_cast<uint_fast8_t>(7);
+    if (QF_maxPool_ >= static_cast<uint_fast8_t>(100)) {
+        obj_name[i] = static_cast<char_t>(
+            static_cast<int8_t>('0')
+            + static_cast<int8_t>(QF_maxPool_ / 100U));
+        ++i;
+    }
+    if (QF_maxPool_ >= static_cast<uint_fast8_t>(10)) {
+        obj_name[i] = static_cast<char_t>(
+            static_cast<int8_t>('0')
+            + static_cast<int8_t>((QF_maxPool_ / 10U) % 10U));
+        ++i;
+    }
+    obj_name[i] = static_cast<char_t>(
+        static_cast<int8_t>('0') + static_cast<int8_t>(QF_maxPool_ % 10U));
+    QS::obj_dict(&QF_pool_[QF_maxPool_ - static_cast<uint_fast8_t>(1)],
+                 &obj_name[0]);
+#endif // Q_SPY
+
+    return QF_maxPool_; // the ID of the new pool
+}
+
 //****************************************************************************
 /// @description
 /// This function initializes one event pool at a time and must be called
@@ -83,26 +293,46 @@ uint_fast8_t QF_maxPool_;              // number of initialized event pools
 void QF::poolInit(void * const poolSto,
                   uint_fast32_t const poolSize, uint_fast16_t const evtSize)
 {
-    /// @pre cannot exceed the number of available memory pools
-    Q_REQUIRE_ID(200, QF_maxPool_
-                      < static_cast<uint_fast8_t>(Q_DIM(QF_pool_)));
+    // find the last pool shared by all event types...
+    uint_fast8_t idx = QF_maxPool_;
+    while ((idx > static_cast<uint_fast8_t>(0))
+           && l_typedPool[idx - static_cast<uint_fast8_t>(1)])
+    {
+        --idx;
+    }
     /// @pre please initialize event pools in ascending order of evtSize
-    Q_REQUIRE_ID(201, (QF_maxPool_ == static_cast<uint_fast8_t>(0))
+    Q_REQUIRE_ID(201, (idx == static_cast<uint_fast8_t>(0))
         || (QF_EPOOL_EVENT_SIZE_(
-               QF_pool_[QF_maxPool_ - static_cast<uint_fast8_t>(1)])
+               QF_pool_[idx - static_cast<uint_fast8_t>(1)])
             < evtSize));
 
-    QF_EPOOL_INIT_(QF_pool_[QF_maxPool_], poolSto, poolSize, evtSize);
-    ++QF_maxPool_; // one more pool
+    (void)poolAdd(poolSto, poolSize, evtSize, false, false);
+}
 
-#ifdef Q_SPY
-    // generate the object-dictionary entry for the initialized pool
-    char_t obj_name[9] = "EvtPool?";
-    obj_name[7] = static_cast<char_t>(
-        static_cast<int8_t>('0') + static_cast<int8_t>(QF_maxPool_));
-    QS::obj_dict(&QF_pool_[QF_maxPool_ - static_cast<uint_fast8_t>(1)],
-                 &obj_name[0]);
-#endif // Q_SPY
+//****************************************************************************
+/// @description
+/// This function initializes an event pool dedicated to a single event type.
+/// Events are allocated from such a pool only by the event pool ID, which
+/// the Q_NEW() and Q_NEW_X() macros obtain at compile time from the event
+/// type, so the dedicated pools are not subject to the ascending order of
+/// the event sizes and are never searched by QP::QF::newX_().
+///
+/// @param[in] poolSto  pointer to the storage for the event pool
+/// @param[in] poolSize size of the storage for the pool in bytes
+/// @param[in] evtSize  the size of the event type in bytes
+/// @param[in] bufEvt   true if the event type is derived from QP::QBufEvt
+///
+/// @returns the event pool ID (1-based) of the initialized pool
+///
+/// @note
+/// The application code should not call this function directly.
+/// The only allowed use is through the QP::QEvtPool::init() template.
+///
+uint_fast8_t QF::typedPoolInit_(void * const poolSto,
+                  uint_fast32_t const poolSize, uint_fast16_t const evtSize,
+                  bool const bufEvt)
+{
+    return poolAdd(poolSto, poolSize, evtSize, true, bufEvt);
 }
 
 //****************************************************************************
@@ -133,17 +363,62 @@ void QF::poolInit(void * const poolSto,
 ///
 QEvt *QF::newX_(uint_fast16_t const evtSize,
                 uint_fast16_t const margin, enum_t const sig)
+{
+    return newTypedX_(static_cast<uint_fast8_t>(0), evtSize, margin, sig);
+}
+
+//****************************************************************************
+/// @description
+/// Allocates an event dynamically from the given event pool or, when no
+/// pool is given, from one of the QF event pools shared by all event types.
+///
+/// @param[in] poolId  the ID of the event pool dedicated to the event type
+///                    (see QP::QEvtPool) or 0 for the shared event pools
+/// @param[in] evtSize the size (in bytes) of the event to allocate
+/// @param[in] margin  the number of un-allocated events still available
+///                    in a given event pool after the allocation completes
+///                    The special value QP::QF_NO_MARGIN means that this
+///                    function will assert if allocation fails.
+/// @param[in] sig     the signal to be assigned to the allocated event
+///
+/// @returns
+/// pointer to the newly allocated event, see QP::QF::newX_().
+///
+/// @note
+/// The application code should not call this function directly.
+/// The only allowed use is through the macros Q_NEW() or Q_NEW_X().
+///
+QEvt *QF::newTypedX_(uint_fast8_t const poolId, uint_fast16_t const evtSize,
+                     uint_fast16_t const margin, enum_t const sig)
 {
     uint_fast8_t idx;
 
-    // find the pool id that fits the requested event size ...
-    for (idx = static_cast<uint_fast8_t>(0); idx < QF_maxPool_; ++idx) {
-        if (evtSize <= QF_EPOOL_EVENT_SIZE_(QF_pool_[idx])) {
-            break;
+    if (poolId == static_cast<uint_fast8_t>(0)) { // shared event pools?
+        uint_fast8_t const c = sizeClass(static_cast<uint32_t>(evtSize));
+
+        // the event size must be within the range of the size classes
+        Q_ASSERT_ID(300, (evtSize != static_cast<uint_fast16_t>(0))
+                         && (c < static_cast<uint_fast8_t>(QF_SIZE_CLASSES)));
+
+        // find the pool id that fits the requested event size, see NOTE3 ...
+        idx = static_cast<uint_fast8_t>(l_classPool[c]);
+        while ((idx < QF_maxPool_)
+               && (l_typedPool[idx]
+                   || (QF_EPOOL_EVENT_SIZE_(QF_pool_[idx]) < evtSize)))
+        {
+            ++idx; // only the pools within the size class of evtSize
         }
+        // cannot run out of registered pools
+        Q_ASSERT_ID(310, idx < QF_maxPool_);
+    }
+    else { // dedicated event pool
+        idx = poolId - static_cast<uint_fast8_t>(1);
+
+        // the dedicated pool must be registered and fit the event
+        Q_ASSERT_ID(330, (idx < QF_maxPool_)
+                         && l_typedPool[idx]
+                         && (QF_EPOOL_EVENT_SIZE_(QF_pool_[idx]) >= evtSize));
     }
-    // cannot run out of registered pools
-    Q_ASSERT_ID(310, idx < QF_maxPool_);
 
     QS_CRIT_STAT_
     QS_BEGIN_(QS_QF_NEW, static_cast<void *>(0), static_cast<void *>(0))
@@ -154,10 +429,23 @@ QEvt *QF::newX_(uint_fast16_t const evtSize,
 
     // get e -- platform-dependent
     QEvt *e;
+#ifdef QF_MAGAZINE_SIZE
+    // try the magazine of the calling thread first, see NOTE2
+    e = (margin == QF_NO_MARGIN)
+        ? static_cast<QEvt *>(magazineGet(idx))
+        : static_cast<QEvt *>(0);
+    if (e == static_cast<QEvt *>(0)) {
+        QF_EPOOL_GET_(QF_pool_[idx], e,
+                      ((margin != QF_NO_MARGIN)
+                          ? margin
+                          : static_cast<uint_fast16_t>(0)));
+    }
+#else
     QF_EPOOL_GET_(QF_pool_[idx], e,
                   ((margin != QF_NO_MARGIN)
                       ? margin
                       : static_cast<uint_fast16_t>(0)));
+#endif // QF_MAGAZINE_SIZE
 
     // was e allocated correctly?
     if (e != static_cast<QEvt const *>(0)) {
@@ -166,7 +454,10 @@ QEvt *QF::newX_(uint_fast16_t const evtSize,
         e->poolId_ = static_cast<uint8_t>(
                        idx + static_cast<uint_fast8_t>(1));
         // initialize the reference counter to 0
-        e->refCtr_ = static_cast<uint8_t>(0);
+        e->refCtr_ = static_cast<QEvtRefCtr>(0);
+        if (l_bufEvtPool[idx]) { // event carrying a buffer? see NOTE4
+            static_cast<QBufEvt *>(e)->buf = static_cast<QBuf const *>(0);
+        }
     }
     else {
         // must tolerate bad alloc.
@@ -201,11 +492,12 @@ QEvt *QF::newX_(uint_fast16_t const evtSize,
 void QF::gc(QEvt const * const e) {
     // is it a dynamic event?
     if (e->poolId_ != static_cast<uint8_t>(0)) {
+#ifndef QF_EVT_REF_ATOMIC
         QF_CRIT_STAT_
-        QF_CRIT_ENTRY_();
+        QF_OBJ_CRIT_ENTRY_(QF_EVT_LOCK_(e));
 
         // isn't this the last reference?
-        if (e->refCtr_ > static_cast<uint8_t>(1)) {
+        if (e->refCtr_ > static_cast<QEvtRefCtr>(1)) {
 
             QS_BEGIN_NOCRIT_(QS_QF_GC_ATTEMPT,
                              static_cast<void *>(0), static_cast<void *>(0))
@@ -216,13 +508,30 @@ void QF::gc(QEvt const * const e) {
 
             QF_EVT_REF_CTR_DEC_(e); // decrement the ref counter
 
-            QF_CRIT_EXIT_();
+            QF_OBJ_CRIT_EXIT_(QF_EVT_LOCK_(e));
+        }
+#else // atomic reference counter, see NOTE1
+        QS_CRIT_STAT_
+
+        // isn't this the last reference?
+        if ((QF_EVT_REF_CTR_GET_(e) > static_cast<QEvtRefCtr>(1))
+            && (QF_EVT_REF_ATOMIC_DEC(&QF_EVT_CONST_CAST_(e)->refCtr_)
+                != static_cast<QEvtRefCtr>(0)))
+        {
+            QS_BEGIN_(QS_QF_GC_ATTEMPT,
+                      static_cast<void *>(0), static_cast<void *>(0))
+                QS_TIME_();        // timestamp
+                QS_SIG_(e->sig);   // the signal of the event
+                QS_2U8_(e->poolId_, e->refCtr_);// pool Id & refCtr of the evt
+            QS_END_()
         }
+#endif // QF_EVT_REF_ATOMIC
         // this is the last reference to this event, recycle it
         else {
             uint_fast8_t idx = static_cast<uint_fast8_t>(e->poolId_)
                                - static_cast<uint_fast8_t>(1);
 
+#ifndef QF_EVT_REF_ATOMIC
             QS_BEGIN_NOCRIT_(QS_QF_GC,
                              static_cast<void *>(0), static_cast<void *>(0))
                 QS_TIME_();        // timestamp
@@ -230,11 +539,26 @@ void QF::gc(QEvt const * const e) {
                 QS_2U8_(e->poolId_, e->refCtr_);// pool Id & refCtr of the evt
             QS_END_NOCRIT_()
 
-            QF_CRIT_EXIT_();
+            QF_OBJ_CRIT_EXIT_(QF_EVT_LOCK_(e));
+#else
+            QS_BEGIN_(QS_QF_GC, static_cast<void *>(0), static_cast<void *>(0))
+                QS_TIME_();        // timestamp
+                QS_SIG_(e->sig);   // the signal of the event
+                QS_2U8_(e->poolId_, e->refCtr_);// pool Id & refCtr of the evt
+            QS_END_()
+#endif // QF_EVT_REF_ATOMIC
 
             // pool ID must be in range
             Q_ASSERT_ID(410, idx < QF_maxPool_);
 
+            if (l_bufEvtPool[idx]) { // event carrying a buffer? see NOTE4
+                QBuf const * const buf =
+                    static_cast<QBufEvt const *>(e)->buf;
+                if (buf != static_cast<QBuf const *>(0)) {
+                    gc(buf); // remove the reference held by the event
+                }
+            }
+
 #ifdef Q_EVT_VIRTUAL
             // explicitly exectute the destructor'
             // NOTE: casting 'const' away is legitimate,
@@ -242,10 +566,211 @@ void QF::gc(QEvt const * const e) {
             QF_EVT_CONST_CAST_(e)->~QEvt(); // xtor,
 #endif
             // cast 'const' away, which is OK, because it's a pool event
+#ifdef QF_MAGAZINE_SIZE
+            // try the magazine of the calling thread first, see NOTE2
+            if (!magazinePut(idx, QF_EVT_CONST_CAST_(e))) {
+                QF_EPOOL_PUT_(QF_pool_[idx], QF_EVT_CONST_CAST_(e));
+            }
+#else
             QF_EPOOL_PUT_(QF_pool_[idx], QF_EVT_CONST_CAST_(e));
+#endif // QF_MAGAZINE_SIZE
+        }
+    }
+}
+
+#ifdef QF_DRAIN_MAX
+//****************************************************************************
+/// @description
+/// Recycles the events dispatched by the thread of an active object that
+/// drains its event queue in batches (see QP::QActive::getBatch_()). The
+/// effect is the same as calling QP::QF::gc() for every event, but the
+/// reference counters are decremented in a single critical section and the
+/// recycled events are returned to their event pools in batches, see NOTE5.
+///
+/// @param[in] evts array of the events to recycle (dynamic or static)
+/// @param[in] n    the number of the events (at most #QF_DRAIN_MAX)
+///
+void QF::gcBatch_(QEvt const * const evts[], uint_fast16_t const n) {
+    QEvt const *last[QF_DRAIN_MAX]; // events with the last reference gone
+    uint_fast16_t nLast = static_cast<uint_fast16_t>(0);
+    uint_fast16_t i;
+
+    /// @pre the number of events must not exceed the batch size
+    Q_REQUIRE_ID(700, n <= static_cast<uint_fast16_t>(QF_DRAIN_MAX));
+
+#ifndef QF_EVT_REF_ATOMIC
+    QEvt const *locked = static_cast<QEvt const *>(0); // event with lock held
+    QF_CRIT_STAT_
+#else
+    QS_CRIT_STAT_
+#endif // QF_EVT_REF_ATOMIC
+
+    for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        QEvt const * const e = evts[i];
+
+        // is it a dynamic event?
+        if (e->poolId_ != static_cast<uint8_t>(0)) {
+#ifndef QF_EVT_REF_ATOMIC
+            // the lock of this reference counter not held yet?
+            if ((locked == static_cast<QEvt const *>(0))
+                || (QF_EVT_LOCK_ID_(locked) != QF_EVT_LOCK_ID_(e)))
+            {
+                if (locked != static_cast<QEvt const *>(0)) {
+                    QF_OBJ_CRIT_EXIT_(QF_EVT_LOCK_(locked));
+                }
+                QF_OBJ_CRIT_ENTRY_(QF_EVT_LOCK_(e));
+                locked = e;
+            }
+
+            // isn't this the last reference?
+            if (e->refCtr_ > static_cast<QEvtRefCtr>(1)) {
+
+                QS_BEGIN_NOCRIT_(QS_QF_GC_ATTEMPT,
+                                 static_cast<void *>(0),
+                                 static_cast<void *>(0))
+                    QS_TIME_();      // timestamp
+                    QS_SIG_(e->sig); // the signal of the event
+                    QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr
+                QS_END_NOCRIT_()
+
+                QF_EVT_REF_CTR_DEC_(e); // decrement the ref counter
+            }
+#else // atomic reference counter, see NOTE1
+            // isn't this the last reference?
+            if ((QF_EVT_REF_CTR_GET_(e) > static_cast<QEvtRefCtr>(1))
+                && (QF_EVT_REF_ATOMIC_DEC(&QF_EVT_CONST_CAST_(e)->refCtr_)
+                    != static_cast<QEvtRefCtr>(0)))
+            {
+                QS_BEGIN_(QS_QF_GC_ATTEMPT,
+                          static_cast<void *>(0), static_cast<void *>(0))
+                    QS_TIME_();      // timestamp
+                    QS_SIG_(e->sig); // the signal of the event
+                    QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr
+                QS_END_()
+            }
+#endif // QF_EVT_REF_ATOMIC
+            // this is the last reference to this event, recycle it below
+            else {
+#ifndef QF_EVT_REF_ATOMIC
+                QS_BEGIN_NOCRIT_(QS_QF_GC,
+                                 static_cast<void *>(0),
+                                 static_cast<void *>(0))
+                    QS_TIME_();      // timestamp
+                    QS_SIG_(e->sig); // the signal of the event
+                    QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr
+                QS_END_NOCRIT_()
+#else
+                QS_BEGIN_(QS_QF_GC,
+                          static_cast<void *>(0), static_cast<void *>(0))
+                    QS_TIME_();      // timestamp
+                    QS_SIG_(e->sig); // the signal of the event
+                    QS_2U8_(e->poolId_, e->refCtr_); // pool Id & refCtr
+                QS_END_()
+#endif // QF_EVT_REF_ATOMIC
+                last[nLast] = e;
+                ++nLast;
+            }
+        }
+    }
+#ifndef QF_EVT_REF_ATOMIC
+    if (locked != static_cast<QEvt const *>(0)) {
+        QF_OBJ_CRIT_EXIT_(QF_EVT_LOCK_(locked));
+    }
+#endif // QF_EVT_REF_ATOMIC
+
+    void *blk[QF_DRAIN_MAX]; // blocks to return to the event pool blkIdx
+    uint_fast16_t nBlk = static_cast<uint_fast16_t>(0);
+    uint_fast8_t blkIdx = static_cast<uint_fast8_t>(0);
+
+    for (i = static_cast<uint_fast16_t>(0); i < nLast; ++i) {
+        QEvt const * const e = last[i];
+        uint_fast8_t const idx = static_cast<uint_fast8_t>(e->poolId_)
+                                 - static_cast<uint_fast8_t>(1);
+
+        // pool ID must be in range
+        Q_ASSERT_ID(710, idx < QF_maxPool_);
+
+        if (l_bufEvtPool[idx]) { // event carrying a buffer? see NOTE4
+            QBuf const * const buf = static_cast<QBufEvt const *>(e)->buf;
+            if (buf != static_cast<QBuf const *>(0)) {
+                gc(buf); // remove the reference held by the event
+            }
+        }
+
+#ifdef Q_EVT_VIRTUAL
+        // explicitly exectute the destructor'
+        // NOTE: casting 'const' away is legitimate,
+        // because it's a pool event
+        QF_EVT_CONST_CAST_(e)->~QEvt(); // xtor,
+#endif
+        bool cached = false;
+#ifdef QF_MAGAZINE_SIZE
+        // try the magazine of the calling thread first, see NOTE2
+        cached = magazinePut(idx, QF_EVT_CONST_CAST_(e));
+#endif // QF_MAGAZINE_SIZE
+        if (!cached) {
+            // a block of another event pool?
+            if ((nBlk != static_cast<uint_fast16_t>(0)) && (blkIdx != idx)) {
+                QF_EPOOL_PUT_MANY_(QF_pool_[blkIdx], &blk[0], nBlk);
+                nBlk = static_cast<uint_fast16_t>(0);
+            }
+            // cast 'const' away, which is OK, because it's a pool event
+            blk[nBlk] = QF_EVT_CONST_CAST_(e);
+            ++nBlk;
+            blkIdx = idx;
         }
     }
+    if (nBlk != static_cast<uint_fast16_t>(0)) {
+        QF_EPOOL_PUT_MANY_(QF_pool_[blkIdx], &blk[0], nBlk);
+    }
 }
+#endif // QF_DRAIN_MAX
+
+//****************************************************************************
+// NOTE1:
+// When the QF port provides atomic reference counters (QF_EVT_REF_ATOMIC),
+// the references are added and removed without any critical section. The
+// last reference is detected either by the counter not exceeding 1 (no other
+// holder can add a reference then), or by the atomic decrement returning
+// zero when two holders drop their references at the same time. Only the
+// recycling of the event takes the critical section of the event pool.
+//
+// The counter is read with an acquire load (QF_EVT_REF_CTR_GET_()), which
+// pairs with the acquire-release decrements of the other holders. The last
+// holder, which recycles the event without decrementing the counter, then
+// sees all writes of the other threads to the event before the event block
+// can be reused.
+//
+
+//****************************************************************************
+// NOTE3:
+// The event pool that fits the requested event size is found through the
+// size classes of the event sizes. Every power of 2 is divided into
+// 4 classes by the 2 bits following the most significant 1-bit of (size-1),
+// so that the event sizes within one class differ by at most 25%. At every
+// call to QF::poolInit() the first pool that can hold the smallest size of
+// every class is stored in the l_classPool[] lookup table. QF::newX_() then
+// needs only to check the pools whose block sizes fall into the same class
+// as the requested size, which is at most one pool unless the block sizes
+// of the pools are closer than 25% to each other. The search is therefore
+// done in constant time regardless of the number of event pools.
+//
+// The event pools dedicated to a single event type (QP::QEvtPool) are
+// skipped both in the l_classPool[] table and in the search, because such
+// pools are accessed only directly by the event pool ID of the event type.
+//
+
+//****************************************************************************
+// NOTE5:
+// QF::gcBatch_() recycles the events in two passes. The first pass drops
+// one reference of every dynamic event while holding the lock of the
+// reference counters, which is taken only once unless the events come from
+// event pools with different locks (see #QF_OBJ_LOCK_TYPE). The second pass
+// runs outside of that critical section and returns the blocks of the
+// consecutive events from the same event pool with one QF_EPOOL_PUT_MANY_().
+// The order of recycling within the batch is not observable, because none
+// of the recycled events can be referenced anymore.
+//
 
 //****************************************************************************
 /// @description
@@ -268,8 +793,9 @@ QEvt const *QF::newRef_(QEvt const * const e, QEvt const * const evtRef) {
         (e->poolId_ != static_cast<uint8_t>(0))
         && (evtRef == static_cast<QEvt const *>(0)));
 
+#ifndef QF_EVT_REF_ATOMIC
     QF_CRIT_STAT_
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(QF_EVT_LOCK_(e));
 
     QF_EVT_REF_CTR_INC_(e); // increments the ref counter
 
@@ -280,7 +806,18 @@ QEvt const *QF::newRef_(QEvt const * const e, QEvt const * const evtRef) {
         QS_2U8_(e->poolId_, e->refCtr_); // pool Id & ref Count
     QS_END_NOCRIT_()
 
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(QF_EVT_LOCK_(e));
+#else // atomic reference counter, see NOTE1
+    QS_CRIT_STAT_
+
+    QF_EVT_REF_CTR_INC_(e); // increments the ref counter
+
+    QS_BEGIN_(QS_QF_NEW_REF, static_cast<void *>(0), static_cast<void *>(0))
+        QS_TIME_();      // timestamp
+        QS_SIG_(e->sig); // the signal of the event
+        QS_2U8_(e->poolId_, e->refCtr_); // pool Id & ref Count
+    QS_END_()
+#endif // QF_EVT_REF_ATOMIC
 
     return e;
 }
@@ -310,11 +847,86 @@ void QF::deleteRef_(QEvt const * const evtRef) {
 
 //****************************************************************************
 /// @description
-/// Obtain the block size of any registered event pools
+/// Allocates a reference-counted buffer for a large event payload from one
+/// of the QF event pools shared by all event types.
+///
+/// @param[in] size    the size of the payload in bytes
+/// @param[in] margin  the number of un-allocated blocks still available
+///                    in a given event pool after the allocation completes
+///                    The special value QP::QF_NO_MARGIN means that this
+///                    function will assert if allocation fails.
+///
+/// @returns
+/// pointer to the newly allocated buffer. This pointer can be NULL only if
+/// margin!=0 and the buffer cannot be allocated with the specified margin.
+///
+/// @note
+/// The application code should not call this function directly.
+/// The only allowed use is through the macros Q_NEW_BUF() or Q_NEW_BUF_X().
+///
+QBuf *QF::newBuf_(uint_fast16_t const size, uint_fast16_t const margin) {
+    // the payload starts at the last member QBuf::m_data[1]
+    QBuf * const buf = static_cast<QBuf *>(newX_(
+        static_cast<uint_fast16_t>((sizeof(QBuf) - sizeof(void *)) + size),
+        margin, static_cast<enum_t>(0)));
+
+    if (buf != static_cast<QBuf *>(0)) {
+        buf->m_size = static_cast<uint16_t>(size);
+    }
+    return buf;
+}
+
+//****************************************************************************
+/// @description
+/// Adds a reference to the buffer @p buf and stores it in the event @p e.
+///
+/// @param[in,out] e    pointer to the event carrying the buffer
+/// @param[in]     buf  pointer to the buffer to attach
+///
+/// @note
+/// The application code should not call this function directly.
+/// The only allowed use is through the macro Q_BUF_ATTACH().
+///
+void QF::attachBuf_(QBufEvt * const e, QBuf const * const buf) {
+    /// @pre the event must come from an event pool dedicated to its type,
+    /// which must be derived from QP::QBufEvt, the event must not carry
+    /// a buffer yet and the buffer must be dynamic
+    Q_REQUIRE_ID(600, (e->poolId_ != static_cast<uint8_t>(0))
+        && (static_cast<uint_fast8_t>(e->poolId_) <= QF_maxPool_)
+        && l_bufEvtPool[e->poolId_ - static_cast<uint8_t>(1)]
+        && (e->buf == static_cast<QBuf const *>(0))
+        && (buf->poolId_ != static_cast<uint8_t>(0)));
+
+    e->buf = static_cast<QBuf const *>(
+                 newRef_(buf, static_cast<QEvt const *>(0)));
+}
+
+//****************************************************************************
+// NOTE4:
+// The reference counter of a buffer (QP::QBuf) counts the events carrying
+// the buffer rather than the holders of these events, which are counted by
+// the reference counters of the events themselves. The buffer is therefore
+// shared without copying by all subscribers of a published event and by all
+// references to the event (including the deferred events), and only the
+// recycling of the last carrying event removes the reference to the buffer.
+// The event pools dedicated to the event types derived from QP::QBufEvt
+// are flagged when registered (see QP::QEvtPool::init()), so that
+// QP::QF::newTypedX_() can clear the attached buffer of a new event and
+// QP::QF::gc() can release the buffer of a recycled event.
+//
+
+//****************************************************************************
+/// @description
+/// Obtain the block size of the largest event pool shared by all event
+/// types (the pools dedicated to a single event type are not considered)
 ///
 uint_fast16_t QF::poolGetMaxBlockSize(void) {
-    return QF_EPOOL_EVENT_SIZE_(
-               QF_pool_[QF_maxPool_ - static_cast<uint_fast8_t>(1)]);
+    // find the last pool shared by all event types...
+    uint_fast8_t idx = QF_maxPool_ - static_cast<uint_fast8_t>(1);
+    while ((idx > static_cast<uint_fast8_t>(0)) && l_typedPool[idx]) {
+        --idx;
+    }
+    return QF_EPOOL_EVENT_SIZE_(QF_pool_[idx]);
 }
 
 } // namespace QP
@@ -152,6 +152,10 @@ void QMPool::init(void * const poolSto, uint_fast32_t poolSize,
     m_nMin     = m_nTot;  // the minimum number of free blocks
     m_start    = poolSto; // the original start this pool buffer
     m_end      = fb;      // the last block in this pool
+
+#ifdef QF_OBJ_LOCK_TYPE
+    QF_OBJ_LOCK_INIT(&m_lock); // this pool is protected by its own lock
+#endif // QF_OBJ_LOCK_TYPE
 }
 
 //****************************************************************************
@@ -179,7 +183,7 @@ void QMPool::put(void * const b) {
                       && QF_PTR_RANGE_(b, m_start, m_end));
     QF_CRIT_STAT_
 
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(m_lock);
     static_cast<QFreeBlock*>(b)->m_next =
         static_cast<QFreeBlock *>(m_free_head); // link into the free list
     m_free_head = b; // set as new head of the free list
@@ -192,7 +196,7 @@ void QMPool::put(void * const b) {
         QS_MPC_(m_nFree); // the number of free blocks in the pool
     QS_END_NOCRIT_()
 
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(m_lock);
 }
 
 //****************************************************************************
@@ -223,13 +227,13 @@ void *QMPool::get(uint_fast16_t const margin) {
     QFreeBlock *fb;
     QF_CRIT_STAT_
 
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(m_lock);
     // have the than margin?
     if (m_nFree > static_cast<QMPoolCtr>(margin)) {
         fb = static_cast<QFreeBlock *>(m_free_head);  // get a free block
 
         // the pool has some free blocks, so a free block must be available
-        Q_ASSERT_CRIT_(310, fb != static_cast<QFreeBlock *>(0));
+        Q_ASSERT_OBJ_CRIT_(m_lock, 310, fb != static_cast<QFreeBlock *>(0));
 
         void *fb_next = fb->m_next; // put volatile to a temporary to avoid UB
 
@@ -237,7 +241,8 @@ void *QMPool::get(uint_fast16_t const margin) {
         --m_nFree;  // one free block less
         if (m_nFree == static_cast<QMPoolCtr>(0)) {
             // pool is becoming empty, so the next free block must be NULL
-            Q_ASSERT_CRIT_(320, fb_next == static_cast<QFreeBlock *>(0));
+            Q_ASSERT_OBJ_CRIT_(m_lock, 320,
+                               fb_next == static_cast<QFreeBlock *>(0));
 
             m_nMin = static_cast<QMPoolCtr>(0);// remember that pool got empty
         }
@@ -247,7 +252,8 @@ void *QMPool::get(uint_fast16_t const margin) {
             // NOTE: the next free block pointer can fall out of range
             // when the client code writes past the memory block, thus
             // corrupting the next block.
-            Q_ASSERT_CRIT_(330, QF_PTR_RANGE_(fb_next, m_start, m_end));
+            Q_ASSERT_OBJ_CRIT_(m_lock, 330,
+                               QF_PTR_RANGE_(fb_next, m_start, m_end));
 
             // is the number of free blocks the new minimum so far?
             if (m_nMin > m_nFree) {
@@ -277,11 +283,121 @@ void *QMPool::get(uint_fast16_t const margin) {
             QS_MPC_(margin);   // the requested margin
         QS_END_NOCRIT_()
     }
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(m_lock);
 
     return fb; // return the block or NULL pointer to the caller
 }
 
+#if (defined QF_MAGAZINE_SIZE) || (defined QF_DRAIN_MAX)
+
+//****************************************************************************
+/// @description
+/// The function allocates up to @p n memory blocks from the pool in
+/// a single critical section. It is used to refill the per-thread caches of
+/// free event blocks (magazines), see #QF_MAGAZINE_SIZE.
+///
+/// @param[out] blk  array receiving the allocated blocks
+/// @param[in]  n    the maximum number of blocks to allocate
+///
+/// @returns
+/// the number of blocks actually allocated (might be 0).
+///
+/// @note
+/// Every allocated block is traced with the QS_QF_MPOOL_GET record, so that
+/// the QS trace of the pool stays the same as with the individual QMPool::get()
+/// calls.
+///
+uint_fast16_t QMPool::getMany(void *blk[], uint_fast16_t const n) {
+    uint_fast16_t i;
+    QF_CRIT_STAT_
+
+    QF_OBJ_CRIT_ENTRY_(m_lock);
+    for (i = static_cast<uint_fast16_t>(0);
+         (i < n) && (m_nFree > static_cast<QMPoolCtr>(0));
+         ++i)
+    {
+        QFreeBlock *fb = static_cast<QFreeBlock *>(m_free_head);
+
+        // the pool has some free blocks, so a free block must be available
+        Q_ASSERT_OBJ_CRIT_(m_lock, 510, fb != static_cast<QFreeBlock *>(0));
+
+        void *fb_next = fb->m_next; // put volatile to a temporary to avoid UB
+
+        --m_nFree;  // one free block less
+        if (m_nFree == static_cast<QMPoolCtr>(0)) {
+            // pool is becoming empty, so the next free block must be NULL
+            Q_ASSERT_OBJ_CRIT_(m_lock, 520,
+                               fb_next == static_cast<QFreeBlock *>(0));
+
+            m_nMin = static_cast<QMPoolCtr>(0);// remember that pool got empty
+        }
+        else {
+            // pool is not empty, so the next free block must be in range
+            Q_ASSERT_OBJ_CRIT_(m_lock, 530,
+                               QF_PTR_RANGE_(fb_next, m_start, m_end));
+
+            // is the number of free blocks the new minimum so far?
+            if (m_nMin > m_nFree) {
+                m_nMin = m_nFree; // remember the minimum so far
+            }
+        }
+
+        m_free_head = fb_next; // set the head to the next free block
+        blk[i] = fb;
+
+        QS_BEGIN_NOCRIT_(QS_QF_MPOOL_GET,
+                         QS::priv_.locFilter[QS::MP_OBJ], this)
+            QS_TIME_();        // timestamp
+            QS_OBJ_(this);     // this memory pool
+            QS_MPC_(m_nFree);  // the number of free blocks in the pool
+            QS_MPC_(m_nMin);   // the mninimum # free blocks in the pool
+        QS_END_NOCRIT_()
+    }
+    QF_OBJ_CRIT_EXIT_(m_lock);
+
+    return i;
+}
+
+//****************************************************************************
+/// @description
+/// Recycle @p n memory blocks to the pool in a single critical section.
+/// It is used to flush the per-thread caches of free event blocks
+/// (magazines), see #QF_MAGAZINE_SIZE, and to recycle the events drained
+/// from an event queue in a batch, see #QF_DRAIN_MAX.
+///
+/// @param[in] blk  array of the blocks to recycle
+/// @param[in] n    the number of blocks to recycle
+///
+void QMPool::putMany(void * const blk[], uint_fast16_t const n) {
+    QF_CRIT_STAT_
+
+    QF_OBJ_CRIT_ENTRY_(m_lock);
+    for (uint_fast16_t i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        /// @pre # free blocks cannot exceed the total # blocks and
+        /// the block pointer must be in range to come from this pool.
+        Q_REQUIRE_OBJ_CRIT_(m_lock, 600, (m_nFree < m_nTot)
+                            && QF_PTR_RANGE_(blk[i], m_start, m_end));
+
+        static_cast<QFreeBlock*>(blk[i])->m_next =
+            static_cast<QFreeBlock *>(m_free_head); // link into the free list
+        m_free_head = blk[i]; // set as new head of the free list
+        ++m_nFree;            // one more free block in this pool
+
+        QS_BEGIN_NOCRIT_(QS_QF_MPOOL_PUT,
+                         QS::priv_.locFilter[QS::MP_OBJ], this)
+            QS_TIME_();       // timestamp
+            QS_OBJ_(this);    // this memory pool
+            QS_MPC_(m_nFree); // the number of free blocks in the pool
+        QS_END_NOCRIT_()
+    }
+    QF_OBJ_CRIT_EXIT_(m_lock);
+}
+
+#endif // QF_MAGAZINE_SIZE || QF_DRAIN_MAX
+
+// the minimum number of free blocks might be provided in the port
+#ifndef QF_EPOOL_PORT_
+
 //****************************************************************************
 /// @description
 /// This function obtains the minimum number of free blocks in the given
@@ -301,14 +417,16 @@ uint_fast16_t QF::getPoolMin(uint_fast8_t const poolId) {
     Q_REQUIRE_ID(400, (static_cast<uint_fast8_t>(1) <= poolId)
                        && (poolId <= QF_maxPool_));
 
+    QF_EPOOL_TYPE_ &pool = QF_pool_[poolId - static_cast<uint_fast8_t>(1)];
     QF_CRIT_STAT_
-    QF_CRIT_ENTRY_();
-    uint_fast16_t min = static_cast<uint_fast16_t>(
-        QF_pool_[poolId - static_cast<uint_fast8_t>(1)].m_nMin);
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_ENTRY_(pool.m_lock);
+    uint_fast16_t min = static_cast<uint_fast16_t>(pool.m_nMin);
+    QF_OBJ_CRIT_EXIT_(pool.m_lock);
 
     return min;
 }
 
+#endif // QF_EPOOL_PORT_
+
 } // namespace QP
 
@@ -56,6 +56,489 @@ Q_DEFINE_THIS_MODULE("qf_ps")
 QSubscrList *QF_subscrList_;
 enum_t QF_maxPubSignal_;
 
+#ifdef QF_OBJ_LOCK_TYPE
+QF_OBJ_LOCK_TYPE QF_subscrLock_; // lock of the subscriber lists
+#endif // QF_OBJ_LOCK_TYPE
+
+#if defined(QF_SUBSCR_DENSE) || defined(QF_PS_SPARSE) \
+    || defined(QF_PS_BROADCAST)
+    //! the priority-set of the subscriber list @p list_
+    #define QF_SUBSCR_SET_(list_) ((list_).m_set)
+#else
+    #define QF_SUBSCR_SET_(list_) (list_)
+#endif
+
+#ifdef QF_SUBSCR_DENSE
+#ifndef QF_SUBSCR_DENSE_COPY
+    //! the maximum number of the subscribers of a signal, which
+    //! QF::publish_() copies to its stack, see NOTE1
+    #define QF_SUBSCR_DENSE_COPY \
+        ((QF_MAX_ACTIVE < 64) ? QF_MAX_ACTIVE : 64)
+#endif
+#if (QF_SUBSCR_DENSE_COPY < 1) || (QF_SUBSCR_DENSE_COPY > QF_MAX_ACTIVE)
+    #error "QF_SUBSCR_DENSE_COPY defined incorrectly, expected 1..QF_MAX_ACTIVE"
+#endif
+#endif // QF_SUBSCR_DENSE
+
+#if defined(QF_PS_SPARSE) || defined(QF_PS_BROADCAST)
+//! the subscriber list of the signals without any subscribers
+static QSubscrList l_noSubscr;
+#endif
+
+#ifndef QF_PS_SPARSE
+    //! the signal @p sig_ can be published and subscribed
+    #define QF_PS_SIG_OK_(sig_) \
+        (static_cast<enum_t>(sig_) < QF_maxPubSignal_)
+#else
+    #define QF_PS_SIG_OK_(sig_) (true)
+
+//****************************************************************************
+/// @description
+/// Looks up the subscriber list of the signal @p sig in the hash table of
+/// the subscriber lists (see NOTE2). If the signal has no list yet and
+/// @p add is 'true', a free list is claimed for the signal.
+///
+/// @returns
+/// the subscriber list of the signal or NULL if the signal has no list
+/// (and @p add is 'false' or the table of the subscriber lists is full).
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+static QSubscrList *subscrListOf(enum_t const sig, bool const add) {
+    uint_fast16_t const n = static_cast<uint_fast16_t>(QF_maxPubSignal_);
+
+    // scale the 32-bit hash of the signal to 0..n-1 without a division
+    uint_fast16_t i = static_cast<uint_fast16_t>(
+        (static_cast<uint64_t>(static_cast<uint32_t>(sig) * 0x9E3779B1U)
+         * static_cast<uint64_t>(n)) >> 32);
+    uint_fast16_t nProbes = static_cast<uint_fast16_t>(0);
+    QSubscrList *list = static_cast<QSubscrList *>(0);
+
+    // linear probing until the signal or a free list is found
+    while ((list == static_cast<QSubscrList *>(0)) && (nProbes < n)) {
+        QSubscrList * const l = &QF_PTR_AT_(QF_subscrList_, i);
+        if (l->m_sig == static_cast<QSignal>(sig)) { // signal found?
+            list = l;
+        }
+        else if (l->m_sig == static_cast<QSignal>(0)) { // free list?
+            if (add) {
+                l->m_sig = static_cast<QSignal>(sig); // claim the list
+                list = l;
+            }
+            else {
+                nProbes = n; // the signal is not in the table
+            }
+        }
+        else {
+            // nothing to do
+        }
+        ++i;
+        if (i == n) { // wrap around?
+            i = static_cast<uint_fast16_t>(0);
+        }
+        ++nProbes;
+    }
+
+    return list;
+}
+#endif // QF_PS_SPARSE
+
+#ifdef QF_PS_RANGES
+#if (QF_PS_RANGES < 1) || (QF_PS_RANGES > 255)
+    #error "QF_PS_RANGES defined incorrectly, expected 1..255"
+#endif
+
+//! range subscription of a single active object
+struct QRangeSubscr {
+    QSignal lo;      //!< the lowest signal of the range
+    QSignal hi;      //!< the highest signal of the range
+    QPrioStore prio; //!< priority of the subscriber
+};
+
+//! segment of the signal space with the same range subscribers, which
+//! extends from the signal 'lo' up to the 'lo' of the next segment
+struct QRangeSeg {
+    QSignal lo;   //!< the lowest signal of the segment
+    QPSet   set;  //!< the range subscribers of the segment
+};
+
+//! the range subscriptions of all active objects, see NOTE3
+static QRangeSubscr l_range[QF_PS_RANGES];
+static uint_fast16_t l_nRanges; //!< number of the range subscriptions
+
+//! the segments of the signal space sorted by 'lo', see NOTE3
+static QRangeSeg l_seg[2 * QF_PS_RANGES];
+static uint_fast16_t l_nSegs; //!< number of the segments
+
+//****************************************************************************
+/// @description
+/// Rebuilds the sorted segments of the signal space from the range
+/// subscriptions (see NOTE3). Every range starts a segment at its lowest
+/// signal and another one just after its highest signal.
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+static void rangeRebuild(void) {
+    uint_fast16_t i;
+    uint_fast16_t j;
+
+    // collect the sorted unique boundaries of the segments
+    l_nSegs = static_cast<uint_fast16_t>(0);
+    for (i = static_cast<uint_fast16_t>(0); i < (2U * l_nRanges); ++i) {
+        QRangeSubscr const &r = l_range[i >> 1];
+        QSignal const b = ((i & 1U) == 0U)
+                          ? r.lo
+                          : static_cast<QSignal>(r.hi + 1U);
+
+        // the boundary after the highest QSignal does not exist
+        if ((b != static_cast<QSignal>(0)) || ((i & 1U) == 0U)) {
+            j = l_nSegs;
+            while ((j > static_cast<uint_fast16_t>(0))
+                   && (l_seg[j - 1U].lo > b))
+            {
+                --j;
+            }
+            if ((j == static_cast<uint_fast16_t>(0))
+                || (l_seg[j - 1U].lo != b)) // new boundary?
+            {
+                uint_fast16_t k;
+                for (k = l_nSegs; k > j; --k) {
+                    l_seg[k].lo = l_seg[k - 1U].lo;
+                }
+                l_seg[j].lo = b;
+                ++l_nSegs;
+            }
+        }
+    }
+
+    // find the subscribers of every segment
+    for (j = static_cast<uint_fast16_t>(0); j < l_nSegs; ++j) {
+        l_seg[j].set.setEmpty();
+        for (i = static_cast<uint_fast16_t>(0); i < l_nRanges; ++i) {
+            if ((l_range[i].lo <= l_seg[j].lo)
+                && (l_seg[j].lo <= l_range[i].hi))
+            {
+                l_seg[j].set.insert(
+                    static_cast<QPrio>(l_range[i].prio));
+            }
+        }
+    }
+}
+
+//****************************************************************************
+/// @description
+/// Finds the range subscribers of the signal @p sig by binary search of
+/// the segment, which contains the signal (see NOTE3).
+///
+/// @returns
+/// the range subscribers of the signal or NULL if there are none.
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+static QPSet const *rangeSubscrOf(QSignal const sig) {
+    QPSet const *set = static_cast<QPSet const *>(0);
+
+    // any segments and the signal not below the first one?
+    if ((l_nSegs != static_cast<uint_fast16_t>(0)) && (l_seg[0].lo <= sig)) {
+        uint_fast16_t lo = static_cast<uint_fast16_t>(0);
+        uint_fast16_t hi = l_nSegs - 1U;
+        while (lo < hi) { // find the last segment starting at or below sig
+            uint_fast16_t const mid = (lo + hi + 1U) >> 1;
+            if (l_seg[mid].lo <= sig) {
+                lo = mid;
+            }
+            else {
+                hi = mid - 1U;
+            }
+        }
+        if (l_seg[lo].set.notEmpty()) {
+            set = &l_seg[lo].set;
+        }
+    }
+    return set;
+}
+
+//****************************************************************************
+/// @description
+/// Removes the range subscription @p lo..@p hi of the active object of
+/// priority @p p, or all its range subscriptions if @p all is 'true', and
+/// rebuilds the segments of the signal space (see NOTE3).
+///
+static void rangeRemove(QPrio const p,
+                        QSignal const lo, QSignal const hi, bool const all)
+{
+    uint_fast16_t i = static_cast<uint_fast16_t>(0);
+    QF_CRIT_STAT_
+    QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
+
+    while (i < l_nRanges) {
+        QRangeSubscr const &r = l_range[i];
+        if ((static_cast<QPrio>(r.prio) == p)
+            && (all || ((r.lo == lo) && (r.hi == hi))))
+        {
+            --l_nRanges;
+            l_range[i] = l_range[l_nRanges]; // move the last range here
+        }
+        else {
+            ++i;
+        }
+    }
+    rangeRebuild();
+
+    QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
+}
+#endif // QF_PS_RANGES
+
+#ifdef QF_PS_FILTERS
+#if (QF_PS_FILTERS < 1) || (QF_PS_FILTERS > 1024)
+    #error "QF_PS_FILTERS defined incorrectly, expected 1..1024"
+#endif
+
+//! content filter of the subscription of a single active object
+struct QSubscrFilter {
+    QSignal sig;       //!< the subscribed signal
+    QPrioStore prio;   //!< priority of the subscriber
+    QEvtFilter filter; //!< the filter function
+    void const *arg;   //!< the argument of the filter function
+};
+
+#ifndef QF_PS_SIG_FILTERS
+    //! the maximum number of the content filters of a single signal,
+    //! which QF::publish_() copies to its stack, see NOTE4
+    #define QF_PS_SIG_FILTERS \
+        ((QF_PS_FILTERS < 8) ? QF_PS_FILTERS : 8)
+#endif
+#if (QF_PS_SIG_FILTERS < 1) || (QF_PS_SIG_FILTERS > QF_PS_FILTERS) \
+    || (QF_PS_SIG_FILTERS > QF_MAX_ACTIVE)
+    #error "QF_PS_SIG_FILTERS defined incorrectly, expected 1..QF_PS_FILTERS"
+#endif
+
+//! the content filters of all subscriptions sorted by the signal, NOTE4
+static QSubscrFilter l_filter[QF_PS_FILTERS];
+static uint_fast16_t l_nFilters; //!< number of the content filters
+
+//****************************************************************************
+/// @description
+/// Finds the index of the first content filter of the signal @p sig (or
+/// the index, at which such filter would be inserted) by binary search.
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+static uint_fast16_t filterFind(QSignal const sig) {
+    uint_fast16_t lo = static_cast<uint_fast16_t>(0);
+    uint_fast16_t hi = l_nFilters;
+    while (lo < hi) {
+        uint_fast16_t const mid = (lo + hi) >> 1;
+        if (l_filter[mid].sig < sig) {
+            lo = mid + 1U;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+//****************************************************************************
+/// @description
+/// Sets the content filter of the subscription of the signal @p sig by the
+/// active object of priority @p p, or removes it if @p filter is NULL.
+///
+/// @returns
+/// 'false' if the filter could not be added, because the table of the
+/// content filters is full or the signal has #QF_PS_SIG_FILTERS filters
+/// already, and 'true' otherwise.
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+static bool filterSet(QSignal const sig, QPrio const p,
+                      QEvtFilter const filter, void const * const arg)
+{
+    uint_fast16_t const first = filterFind(sig);
+    uint_fast16_t i = first;
+    uint_fast16_t j;
+    bool ok = true;
+
+    // find the filter of this subscriber among the filters of the signal
+    while ((i < l_nFilters) && (l_filter[i].sig == sig)
+           && (static_cast<QPrio>(l_filter[i].prio) != p))
+    {
+        ++i;
+    }
+
+    // the subscriber has a filter of the signal?
+    if ((i < l_nFilters) && (l_filter[i].sig == sig)) {
+        if (filter != static_cast<QEvtFilter>(0)) { // replace the filter?
+            l_filter[i].filter = filter;
+            l_filter[i].arg    = arg;
+        }
+        else { // remove the filter
+            --l_nFilters;
+            for (j = i; j < l_nFilters; ++j) {
+                l_filter[j] = l_filter[j + 1U];
+            }
+        }
+    }
+    else if (filter != static_cast<QEvtFilter>(0)) { // add the filter?
+        // 'i' is past the filters of the signal, so 'i - first' counts them
+        if ((l_nFilters < static_cast<uint_fast16_t>(QF_PS_FILTERS))
+            && ((i - first)
+                < static_cast<uint_fast16_t>(QF_PS_SIG_FILTERS)))
+        {
+            for (j = l_nFilters; j > i; --j) {
+                l_filter[j] = l_filter[j - 1U];
+            }
+            l_filter[i].sig    = sig;
+            l_filter[i].prio   = static_cast<QPrioStore>(p);
+            l_filter[i].filter = filter;
+            l_filter[i].arg    = arg;
+            ++l_nFilters;
+        }
+        else {
+            ok = false; // the table or the filters of the signal are full
+        }
+    }
+    else {
+        // nothing to do
+    }
+    return ok;
+}
+
+//****************************************************************************
+/// @description
+/// Evaluates the content filters of the subscriptions of the published
+/// event @p e, which have been copied to @p flt[] (see NOTE4).
+///
+/// @returns
+/// the set of the subscribers, whose filters rejected the event.
+///
+static QPSet filterEval(QEvt const * const e,
+                        QSubscrFilter const flt[], QPrio const n)
+{
+    QPSet rejected;
+    QPrio i;
+    rejected.setEmpty();
+    for (i = static_cast<QPrio>(0); i < n; ++i) {
+        if (!(*flt[i].filter)(e, flt[i].arg)) { // filter rejects the event?
+            rejected.insert(static_cast<QPrio>(flt[i].prio));
+        }
+    }
+    return rejected;
+}
+#endif // QF_PS_FILTERS
+
+#ifdef QF_PS_REVERSE
+#if (QF_PS_REVERSE < 1) || (QF_PS_REVERSE > 65535)
+    #error "QF_PS_REVERSE defined incorrectly, expected 1..65535"
+#endif
+
+//! signal subscribed by an active object, node of the reverse index
+struct QOwnSig {
+    QSignal sig;   //!< the subscribed signal
+    uint16_t next; //!< next node of the same AO (1-based), 0 at the end
+};
+
+//! the pool of the signals subscribed by all active objects, NOTE6
+static QOwnSig l_ownSig[QF_PS_REVERSE];
+static uint16_t l_ownHead[QF_MAX_ACTIVE + 1]; //!< first node of every AO
+static uint16_t l_nOwnSig[QF_MAX_ACTIVE + 1]; //!< number of the signals
+static uint16_t l_ownFree; //!< first node of the free list (1-based)
+static uint16_t l_ownUsed; //!< number of the nodes taken from the pool
+
+//****************************************************************************
+/// @description
+/// Adds the signal @p sig to the signals subscribed by the active object
+/// of priority @p p (see NOTE6). The signal must not be there already.
+///
+/// @returns
+/// 'false' if the signal could not be added, because all #QF_PS_REVERSE
+/// nodes of the pool are in use, and 'true' otherwise.
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+static bool ownSigAdd(QPrio const p, QSignal const sig) {
+    uint_fast16_t n = static_cast<uint_fast16_t>(l_ownFree);
+
+    if (n != static_cast<uint_fast16_t>(0)) { // any node freed before?
+        l_ownFree = l_ownSig[n - 1U].next;
+    }
+    else if (l_ownUsed < static_cast<uint16_t>(QF_PS_REVERSE)) {
+        ++l_ownUsed;
+        n = static_cast<uint_fast16_t>(l_ownUsed);
+    }
+    else {
+        // the pool is exhausted, 'n' stays 0
+    }
+    if (n != static_cast<uint_fast16_t>(0)) {
+        l_ownSig[n - 1U].sig  = sig;
+        l_ownSig[n - 1U].next = l_ownHead[p];
+        l_ownHead[p] = static_cast<uint16_t>(n);
+        l_nOwnSig[p] = static_cast<uint16_t>(l_nOwnSig[p] + 1U);
+    }
+    return (n != static_cast<uint_fast16_t>(0));
+}
+
+//****************************************************************************
+/// @description
+/// Removes the signal @p sig from the signals subscribed by the active
+/// object of priority @p p and returns its node to the pool (see NOTE6).
+/// Removing a signal that is not there has no effect.
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+static void ownSigRemove(QPrio const p, QSignal const sig) {
+    uint16_t *link = &l_ownHead[p];
+
+    while ((*link != static_cast<uint16_t>(0))
+           && (l_ownSig[*link - 1U].sig != sig))
+    {
+        link = &l_ownSig[*link - 1U].next;
+    }
+    if (*link != static_cast<uint16_t>(0)) { // found?
+        uint_fast16_t const n = static_cast<uint_fast16_t>(*link);
+        *link = l_ownSig[n - 1U].next; // unlink the node
+        l_ownSig[n - 1U].next = l_ownFree; // and free it
+        l_ownFree = static_cast<uint16_t>(n);
+        l_nOwnSig[p] = static_cast<uint16_t>(l_nOwnSig[p] - 1U);
+    }
+}
+#endif // QF_PS_REVERSE
+
+//****************************************************************************
+/// @description
+/// Removes the active object @p act from the subscriber list @p list of
+/// the signal @p sig, including its content filter of the signal.
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+static void listRemove(QSubscrList &list, QSignal const sig,
+                       QActive const * const act)
+{
+    QPrio const p = act->getPrio();
+    list.remove(p);
+#ifdef QF_PS_FILTERS
+    (void)filterSet(sig, p, static_cast<QEvtFilter>(0),
+                    static_cast<void const *>(0)); // remove the filter
+#endif // QF_PS_FILTERS
+
+    QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_UNSUBSCRIBE,
+                     QS::priv_.locFilter[QS::AO_OBJ], act)
+        QS_TIME_();     // timestamp
+        QS_SIG_(sig);   // the signal of this event
+        QS_OBJ_(act);   // this active object
+    QS_END_NOCRIT_()
+
+    (void)sig; // unused parameter, if neither filters nor QS are used
+}
+
 //****************************************************************************
 /// @description
 /// This function initializes the publish-subscribe facilities of QF and must
@@ -65,7 +548,9 @@ enum_t QF_maxPubSignal_;
 /// @param[in] subscrSto pointer to the array of subscriber lists
 /// @param[in] maxSignal the dimension of the subscriber array and at
 ///                      the same time the maximum signal that can be
-///                      published or subscribed.
+///                      published or subscribed. With #QF_PS_SPARSE it is
+///                      only the dimension of the subscriber array (see
+///                      NOTE2).
 ///
 /// The array of subscriber-lists is indexed by signals and provides a mapping
 /// between the signals and subscriber-lists. The subscriber-lists are
@@ -86,9 +571,18 @@ enum_t QF_maxPubSignal_;
 /// @include qf_main.cpp
 ///
 void QF::psInit(QSubscrList * const subscrSto, enum_t const maxSignal) {
+#ifdef QF_PS_SPARSE
+    /// @pre there must be at least one subscriber list
+    Q_REQUIRE_ID(50, maxSignal > static_cast<enum_t>(0));
+#endif // QF_PS_SPARSE
+
     QF_subscrList_   = subscrSto;
     QF_maxPubSignal_ = maxSignal;
 
+#ifdef QF_OBJ_LOCK_TYPE
+    QF_OBJ_LOCK_INIT(&QF_subscrLock_);
+#endif // QF_OBJ_LOCK_TYPE
+
     // zero the subscriber list, so that the framework can start correctly
     // even if the startup code fails to clear the uninitialized data
     // (as is required by the C++ Standard)
@@ -97,6 +591,72 @@ void QF::psInit(QSubscrList * const subscrSto, enum_t const maxSignal) {
               * static_cast<uint_fast16_t>(sizeof(QSubscrList))));
 }
 
+#ifdef QF_PS_BROADCAST
+//****************************************************************************
+/// @description
+/// This function attaches the broadcast channel @p bc to the signal @p sig,
+/// so that QF::publish_() writes the events of the signal only once into
+/// the ring buffer of the channel, from which all the subscribers read them
+/// (see NOTE5). The function must be called after QF::psInit() and before
+/// any active object subscribes to the signal.
+///
+/// @param[in] sig     the published signal of the channel
+/// @param[in] bc      pointer to the broadcast channel
+/// @param[in] ringSto storage for the ring buffer of the channel
+/// @param[in] ringLen the length of the ring buffer, which must be a power
+///                    of two. The ring must hold all the events of the
+///                    signal, which the slowest subscriber has not read yet.
+///
+/// @note
+/// The ring keeps a reference to every event until its slot is reused,
+/// so up to @p ringLen events of the signal are held by the channel.
+///
+void QF::psBroadcast(enum_t const sig, QBroadcast * const bc,
+                     QEvt const *ringSto[], uint_fast16_t const ringLen)
+{
+    /// @pre the signal must be in range and the ring length must be
+    /// a power of two
+    Q_REQUIRE_ID(60, (Q_USER_SIG <= sig)
+                     && QF_PS_SIG_OK_(sig)
+                     && (bc != static_cast<QBroadcast *>(0))
+                     && (ringLen > static_cast<uint_fast16_t>(0))
+                     && ((ringLen & (ringLen - 1U)) == 0U));
+
+    uint_fast16_t i;
+    for (i = static_cast<uint_fast16_t>(0); i < ringLen; ++i) {
+        ringSto[i] = static_cast<QEvt const *>(0);
+    }
+    bc->m_ring = &ringSto[0];
+    bc->m_mask = static_cast<uint32_t>(ringLen - 1U);
+    bc->m_head = static_cast<uint32_t>(0);
+    bc->m_tail = static_cast<uint32_t>(0);
+    bc->m_rung.setEmpty();
+
+    QF_CRIT_STAT_
+    QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
+
+#ifndef QF_PS_SPARSE
+    QSubscrList * const list = &QF_PTR_AT_(QF_subscrList_, sig);
+#else
+    QSubscrList * const list = subscrListOf(sig, true);
+
+    // the table of the subscriber lists must not overflow
+    Q_ASSERT_OBJ_CRIT_(QF_subscrLock_, 610,
+                       list != static_cast<QSubscrList *>(0));
+#endif // QF_PS_SPARSE
+
+    // the signal must not have a channel or any subscribers yet
+    Q_ASSERT_OBJ_CRIT_(QF_subscrLock_, 70,
+                       (list->m_bcast == static_cast<QBroadcast *>(0))
+                       && (!QF_SUBSCR_SET_(*list).notEmpty()));
+
+    bc->m_list = list;
+    list->m_bcast = bc;
+
+    QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
+}
+#endif // QF_PS_BROADCAST
+
 //****************************************************************************
 /// @description
 /// This function posts (using the FIFO policy) the event @a e to **all**
@@ -120,10 +680,10 @@ void QF::publish_(QEvt const * const e) {
 void QF::publish_(QEvt const * const e, void const * const sender) {
 #endif
     /// @pre the published signal must be within the configured range
-    Q_REQUIRE_ID(100, static_cast<enum_t>(e->sig) < QF_maxPubSignal_);
+    Q_REQUIRE_ID(100, QF_PS_SIG_OK_(e->sig));
 
     QF_CRIT_STAT_
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
 
     QS_BEGIN_NOCRIT_(QS_QF_PUBLISH,
                      static_cast<void *>(0), static_cast<void *>(0))
@@ -142,15 +702,141 @@ void QF::publish_(QEvt const * const e, void const * const sender) {
         // recycles the event if the counter drops to zero. This covers the
         // case when the event was published without any subscribers.
         //
+        QF_EVT_NEST_ENTRY_(e);
         QF_EVT_REF_CTR_INC_(e);
+        QF_EVT_NEST_EXIT_(e);
     }
 
+#ifndef QF_PS_SPARSE
+    QSubscrList const *l = &QF_PTR_AT_(QF_subscrList_, e->sig);
+#else
+    QSubscrList const *l = subscrListOf(static_cast<enum_t>(e->sig), false);
+    if (l == static_cast<QSubscrList *>(0)) { // no subscriber list?
+        l = &l_noSubscr;
+    }
+#endif // QF_PS_SPARSE
+
+#ifdef QF_PS_BROADCAST
+    // write the event of a broadcast signal into the ring, see NOTE5
+    QBroadcast * const bc = l->m_bcast;
+    QEvt const *old = static_cast<QEvt const *>(0);
+    QPSet bells;
+    bells.setEmpty();
+    if (bc != static_cast<QBroadcast *>(0)) {
+        // the ring of the broadcast channel must not overflow
+        if (!bc->write_(e, &bells, &old)) {
+            Q_ERROR_OBJ_CRIT_(QF_subscrLock_, 220);
+        }
+        l = &l_noSubscr; // the subscribers get only the doorbells
+    }
+#endif // QF_PS_BROADCAST
+    QSubscrList const &list = *l;
+
     // make a local, modifiable copy of the subscriber list
-    QPSet subscrList = QF_PTR_AT_(QF_subscrList_, e->sig);
-    QF_CRIT_EXIT_();
+    QPSet subscrList;
+#ifdef QF_SUBSCR_DENSE
+    QPrioStore subscr[QF_SUBSCR_DENSE_COPY]; // see NOTE1
+    QPrio n = static_cast<QPrio>(list.m_nSubscr);
+    QPrio i;
+    bool dense = (n <= static_cast<QPrio>(QF_SUBSCR_DENSE_COPY));
+#endif // QF_SUBSCR_DENSE
+
+#ifdef QF_PS_FILTERS
+    // copy the content filters of the signal, see NOTE4
+    QSubscrFilter flt[QF_PS_SIG_FILTERS];
+    QPrio nFlt = static_cast<QPrio>(0);
+    uint_fast16_t f;
+    for (f = filterFind(e->sig);
+         (f < l_nFilters) && (l_filter[f].sig == e->sig); ++f)
+    {
+        flt[nFlt] = l_filter[f];
+        ++nFlt;
+    }
+#endif // QF_PS_FILTERS
+
+#ifdef QF_PS_RANGES
+    // copy the range subscribers of the signal, see NOTE3
+    QPSet ranged;
+    QPSet const * const rangeSet = rangeSubscrOf(e->sig);
+    if (rangeSet != static_cast<QPSet const *>(0)) {
+        ranged = *rangeSet;
+    }
+    else {
+        ranged.setEmpty();
+    }
+#ifdef QF_SUBSCR_DENSE
+    dense = dense && (!ranged.notEmpty()); // merged in the priority-set
+#endif // QF_SUBSCR_DENSE
+#endif // QF_PS_RANGES
+
+#ifdef QF_SUBSCR_DENSE
+    if (dense) { // copy the sorted array of the subscribers, see NOTE1
+        for (i = static_cast<QPrio>(0); i < n; ++i) {
+            subscr[i] = list.m_prio[i];
+        }
+        subscrList.setEmpty();
+    }
+    else { // publish through the priority-set of the subscribers
+        n = static_cast<QPrio>(0);
+        subscrList = QF_SUBSCR_SET_(list);
+    }
+#else
+    subscrList = QF_SUBSCR_SET_(list);
+#endif // QF_SUBSCR_DENSE
+    QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
+
+#ifdef QF_PS_FILTERS
+    // remove the subscribers, whose filters reject the event, see NOTE4
+    if (nFlt != static_cast<QPrio>(0)) {
+        QPSet rejected = filterEval(e, flt, nFlt);
+#ifdef QF_SUBSCR_DENSE
+        QPrio m = static_cast<QPrio>(0);
+        for (i = static_cast<QPrio>(0); i < n; ++i) {
+            if (!rejected.hasElement(static_cast<QPrio>(subscr[i]))) {
+                subscr[m] = subscr[i];
+                ++m;
+            }
+        }
+        n = m;
+#endif // QF_SUBSCR_DENSE
+        while (rejected.notEmpty()) {
+            QPrio const r = rejected.findMax();
+            rejected.remove(r);
+            subscrList.remove(r);
+        }
+    }
+#endif // QF_PS_FILTERS
+
+#ifdef QF_PS_RANGES
+    // add the range subscribers, which the filters don't apply to, NOTE4
+    while (ranged.notEmpty()) {
+        QPrio const r = ranged.findMax();
+        ranged.remove(r);
+        subscrList.insert(r);
+    }
+#endif // QF_PS_RANGES
+
+#ifdef QF_SUBSCR_DENSE
+    if (n != static_cast<QPrio>(0)) { // any subscribers in the array?
+        QF_SCHED_STAT_
+
+        // lock the scheduler up to the prio of the highest-prio subscriber
+        QF_SCHED_LOCK_(static_cast<QPrio>(subscr[0]));
+        for (i = static_cast<QPrio>(0); i < n; ++i) {
+            QActive * const a = active_[subscr[i]];
+
+            // the prio of the AO must be registered with the framework
+            Q_ASSERT_ID(210, a != static_cast<QActive *>(0));
+
+            // POST() asserts internally if the queue overflows
+            (void)a->POST(e, sender);
+        }
+        QF_SCHED_UNLOCK_(); // unlock the scheduler
+    }
+#endif // QF_SUBSCR_DENSE
 
     if (subscrList.notEmpty()) { // any subscribers?
-        uint_fast8_t p = subscrList.findMax(); // the highest-prio subscriber
+        QPrio p = subscrList.findMax(); // the highest-prio subscriber
         QF_SCHED_STAT_
 
         QF_SCHED_LOCK_(p); // lock the scheduler up to prio 'p'
@@ -166,12 +852,28 @@ void QF::publish_(QEvt const * const e, void const * const sender) {
                 p = subscrList.findMax(); // the highest-prio subscriber
             }
             else {
-                p = static_cast<uint_fast8_t>(0); // no more subscribers
+                p = static_cast<QPrio>(0); // no more subscribers
             }
-        } while (p != static_cast<uint_fast8_t>(0));
+        } while (p != static_cast<QPrio>(0));
         QF_SCHED_UNLOCK_(); // unlock the scheduler
     }
 
+#ifdef QF_PS_BROADCAST
+    if (old != static_cast<QEvt const *>(0)) { // event overwritten in ring?
+        gc(old); // the ring no longer references the event
+    }
+    while (bells.notEmpty()) { // ring the doorbells, see NOTE5
+        QPrio const p = bells.findMax();
+        bells.remove(p);
+
+        // the prio of the AO must be registered with the framework
+        Q_ASSERT_ID(210, active_[p] != static_cast<QActive *>(0));
+
+        // POST() asserts internally if the queue overflows
+        (void)active_[p]->POST(bc, sender);
+    }
+#endif // QF_PS_BROADCAST
+
     // The following garbage collection step decrements the reference counter
     // and recycles the event if the counter drops to zero. This covers both
     // cases when the event was published with or without any subscribers.
@@ -197,16 +899,47 @@ void QF::publish_(QEvt const * const e, void const * const sender) {
 /// QP::QF::publish_(), QP::QActive::unsubscribe(), and
 /// QP::QActive::unsubscribeAll()
 ///
+#ifndef QF_PS_FILTERS
+void QActive::subscribe(enum_t const sig) const {
+#else
 void QActive::subscribe(enum_t const sig) const {
-    uint_fast8_t p = static_cast<uint_fast8_t>(m_prio);
+    subscribe(sig, static_cast<QEvtFilter>(0), static_cast<void const *>(0));
+}
+
+//****************************************************************************
+/// @description
+/// This function subscribes the active object to the signal @p sig just
+/// like QP::QActive::subscribe(enum_t), but QF::publish_() posts the events
+/// with the signal @p sig to the active object only if the content filter
+/// @p filter returns 'true' for them (see NOTE4). The events rejected by
+/// the filter are neither posted nor referenced for the active object.
+///
+/// @param[in] sig    event signal to subscribe
+/// @param[in] filter the content filter or NULL for no filter
+/// @param[in] arg    the argument passed to the content filter (e.g., the
+///                   expected value of a key in the event)
+///
+/// @note
+/// Subscribing to the signal again replaces the filter. Subscribing
+/// without a filter removes the filter. At most #QF_PS_SIG_FILTERS active
+/// objects can subscribe to the same signal with a filter (see NOTE4).
+///
+/// @sa
+/// QP::QEvtFilter
+///
+void QActive::subscribe(enum_t const sig,
+                        QEvtFilter const filter, void const * const arg) const
+{
+#endif // QF_PS_FILTERS
+    QPrio p = static_cast<QPrio>(m_prio);
     Q_REQUIRE_ID(300, (Q_USER_SIG <= sig)
-              && (sig < QF_maxPubSignal_)
-              && (static_cast<uint_fast8_t>(0) < p)
-              && (p <= static_cast<uint_fast8_t>(QF_MAX_ACTIVE))
+              && QF_PS_SIG_OK_(sig)
+              && (static_cast<QPrio>(0) < p)
+              && (p <= static_cast<QPrio>(QF_MAX_ACTIVE))
               && (QF::active_[p] == this));
 
     QF_CRIT_STAT_
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
 
     QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_SUBSCRIBE,
                      QS::priv_.locFilter[QS::AO_OBJ], this)
@@ -215,8 +948,39 @@ void QActive::subscribe(enum_t const sig) const {
         QS_OBJ_(this); // this active object
     QS_END_NOCRIT_()
 
-    QF_PTR_AT_(QF_subscrList_, sig).insert(p); // insert into subscriber-list
-    QF_CRIT_EXIT_();
+#ifndef QF_PS_SPARSE
+    QSubscrList * const list = &QF_PTR_AT_(QF_subscrList_, sig);
+#else
+    QSubscrList * const list = subscrListOf(sig, true);
+
+    // the table of the subscriber lists must not overflow
+    Q_ASSERT_OBJ_CRIT_(QF_subscrLock_, 610,
+                       list != static_cast<QSubscrList *>(0));
+#endif // QF_PS_SPARSE
+#ifdef QF_PS_BROADCAST
+    // a new subscriber of the broadcast channel reads only the new events
+    if ((list->m_bcast != static_cast<QBroadcast *>(0))
+        && (!list->hasElement(p)))
+    {
+        list->m_bcast->m_cursor[p] = list->m_bcast->m_head;
+    }
+#endif // QF_PS_BROADCAST
+#ifdef QF_PS_REVERSE
+    // the pool of the own signals must not overflow, see NOTE6
+    if ((!list->hasElement(p))
+        && (!ownSigAdd(p, static_cast<QSignal>(sig))))
+    {
+        Q_ERROR_OBJ_CRIT_(QF_subscrLock_, 310);
+    }
+#endif // QF_PS_REVERSE
+    list->insert(p); // insert into subscriber-list
+#ifdef QF_PS_FILTERS
+    // the content filters (also of the signal) must not overflow, NOTE4
+    if (!filterSet(static_cast<QSignal>(sig), p, filter, arg)) {
+        Q_ERROR_OBJ_CRIT_(QF_subscrLock_, 910);
+    }
+#endif // QF_PS_FILTERS
+    QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
 }
 
 //****************************************************************************
@@ -244,18 +1008,18 @@ void QActive::subscribe(enum_t const sig) const {
 /// QP::QActive::unsubscribeAll()
 ///
 void QActive::unsubscribe(enum_t const sig) const {
-    uint_fast8_t p = static_cast<uint_fast8_t>(m_prio);
+    QPrio p = static_cast<QPrio>(m_prio);
 
     //! @pre the singal and the prioriy must be in ragne, the AO must also
     // be registered with the framework
     Q_REQUIRE_ID(400, (Q_USER_SIG <= sig)
-                      && (sig < QF_maxPubSignal_)
-                      && (static_cast<uint_fast8_t>(0) < p)
-                      && (p <= static_cast<uint_fast8_t>(QF_MAX_ACTIVE))
+                      && QF_PS_SIG_OK_(sig)
+                      && (static_cast<QPrio>(0) < p)
+                      && (p <= static_cast<QPrio>(QF_MAX_ACTIVE))
                       && (QF::active_[p] == this));
 
     QF_CRIT_STAT_
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
 
     QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_UNSUBSCRIBE,
                      QS::priv_.locFilter[QS::AO_OBJ], this)
@@ -264,11 +1028,107 @@ void QActive::unsubscribe(enum_t const sig) const {
         QS_OBJ_(this);      // this active object
     QS_END_NOCRIT_()
 
+#ifndef QF_PS_SPARSE
     QF_PTR_AT_(QF_subscrList_,sig).remove(p);  // remove from subscriber-list
+#else
+    QSubscrList * const list = subscrListOf(sig, false);
+    if (list != static_cast<QSubscrList *>(0)) { // signal has a list?
+        list->remove(p);  // remove from subscriber-list
+    }
+#endif // QF_PS_SPARSE
+#ifdef QF_PS_FILTERS
+    filterSet(static_cast<QSignal>(sig), p, static_cast<QEvtFilter>(0),
+              static_cast<void const *>(0)); // remove the filter
+#endif // QF_PS_FILTERS
+#ifdef QF_PS_REVERSE
+    ownSigRemove(p, static_cast<QSignal>(sig));
+#endif // QF_PS_REVERSE
 
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
 }
 
+#ifdef QF_PS_RANGES
+//****************************************************************************
+/// @description
+/// This function is part of the Publish-Subscribe event delivery mechanism
+/// available in QF. Subscribing to the range of signals means that the
+/// framework will start posting all published events with the signals
+/// @p lo..@p hi (inclusive) to the event queue of the active object.
+/// Unlike the subscriptions to the individual signals, a range subscription
+/// takes only a single entry in the table of range subscriptions, no
+/// matter how many signals it covers (see NOTE3).
+///
+/// @param[in] lo the lowest signal of the range to subscribe
+/// @param[in] hi the highest signal of the range to subscribe
+///
+/// @note
+/// An event is posted only once to the active object, which has subscribed
+/// to its signal both individually and in a range.
+///
+/// @sa
+/// QP::QActive::unsubscribeRange(), QP::QActive::unsubscribeAll()
+///
+void QActive::subscribeRange(enum_t const lo, enum_t const hi) const {
+    QPrio const p = static_cast<QPrio>(m_prio);
+
+    /// @pre the signals must be in range and ordered, the AO must also
+    /// be registered with the framework
+    Q_REQUIRE_ID(700, (Q_USER_SIG <= lo)
+                      && (static_cast<QSignal>(lo) <= static_cast<QSignal>(hi))
+                      && QF_PS_SIG_OK_(hi)
+                      && (static_cast<QPrio>(0) < p)
+                      && (p <= static_cast<QPrio>(QF_MAX_ACTIVE))
+                      && (QF::active_[p] == this));
+
+    QF_CRIT_STAT_
+    QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
+
+    // the table of the range subscriptions must not overflow
+    Q_ASSERT_OBJ_CRIT_(QF_subscrLock_, 710,
+        l_nRanges < static_cast<uint_fast16_t>(QF_PS_RANGES));
+
+    QRangeSubscr &r = l_range[l_nRanges];
+    r.lo   = static_cast<QSignal>(lo);
+    r.hi   = static_cast<QSignal>(hi);
+    r.prio = static_cast<QPrioStore>(p);
+    ++l_nRanges;
+    rangeRebuild();
+
+    QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
+}
+
+//****************************************************************************
+/// @description
+/// This function is part of the Publish-Subscribe event delivery mechanism
+/// available in QF. Un-subscribing from the range of signals means that the
+/// framework will stop posting published events with the signals
+/// @p lo..@p hi to the event queue of the active object, unless the active
+/// object has subscribed to them otherwise.
+///
+/// @param[in] lo the lowest signal of the range to unsubscribe
+/// @param[in] hi the highest signal of the range to unsubscribe
+///
+/// @note
+/// The range must be the same as in QP::QActive::subscribeRange(). Ranges
+/// cannot be split or un-subscribed partially.
+///
+/// @sa
+/// QP::QActive::subscribeRange(), QP::QActive::unsubscribeAll()
+///
+void QActive::unsubscribeRange(enum_t const lo, enum_t const hi) const {
+    QPrio const p = static_cast<QPrio>(m_prio);
+
+    /// @pre the priority must be in range and the AO must also
+    /// be registered with the framework
+    Q_REQUIRE_ID(800, (static_cast<QPrio>(0) < p)
+                      && (p <= static_cast<QPrio>(QF_MAX_ACTIVE))
+                      && (QF::active_[p] == this));
+
+    rangeRemove(p, static_cast<QSignal>(lo), static_cast<QSignal>(hi),
+                false);
+}
+#endif // QF_PS_RANGES
+
 //****************************************************************************
 /// @description
 /// This function is part of the Publish-Subscribe event delivery mechanism
@@ -291,32 +1151,424 @@ void QActive::unsubscribe(enum_t const sig) const {
 /// QP::QActive::unsubscribe()
 ///
 void QActive::unsubscribeAll(void) const {
-    uint_fast8_t const p = static_cast<uint_fast8_t>(m_prio);
+    QPrio const p = static_cast<QPrio>(m_prio);
 
-    Q_REQUIRE_ID(500, (static_cast<uint_fast8_t>(0) < p)
-                      && (p <= static_cast<uint_fast8_t>(QF_MAX_ACTIVE))
+    Q_REQUIRE_ID(500, (static_cast<QPrio>(0) < p)
+                      && (p <= static_cast<QPrio>(QF_MAX_ACTIVE))
                       && (QF::active_[p] == this));
 
-    for (enum_t sig = Q_USER_SIG; sig < QF_maxPubSignal_; ++sig) {
+#if defined(QF_PS_REVERSE) // visit only the own signals, see NOTE6
+    bool more;
+    do {
         QF_CRIT_STAT_
-        QF_CRIT_ENTRY_();
-        if (QF_PTR_AT_(QF_subscrList_, sig).hasElement(p)) {
-            QF_PTR_AT_(QF_subscrList_, sig).remove(p);
+        QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
+        more = (l_ownHead[p] != static_cast<uint16_t>(0));
+        if (more) {
+            QSignal const sig = l_ownSig[l_ownHead[p] - 1U].sig;
+            ownSigRemove(p, sig); // removes the first node
+#ifndef QF_PS_SPARSE
+            listRemove(QF_PTR_AT_(QF_subscrList_, sig), sig, this);
+#else
+            listRemove(*subscrListOf(static_cast<enum_t>(sig), false),
+                       sig, this);
+#endif // QF_PS_SPARSE
+        }
+        QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
 
-            QS_BEGIN_NOCRIT_(QS_QF_ACTIVE_UNSUBSCRIBE,
-                             QS::priv_.locFilter[QS::AO_OBJ], this)
-                QS_TIME_();     // timestamp
-                QS_SIG_(sig);   // the signal of this event
-                QS_OBJ_(this);  // this active object
-            QS_END_NOCRIT_()
+        // prevent merging critical sections
+        QF_CRIT_EXIT_NOP();
+    } while (more);
+#elif !defined(QF_PS_SPARSE)
+    for (enum_t sig = Q_USER_SIG; sig < QF_maxPubSignal_; ++sig) {
+        QSubscrList &list = QF_PTR_AT_(QF_subscrList_, sig);
+        QF_CRIT_STAT_
+        QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
+        if (list.hasElement(p)) {
+            listRemove(list, static_cast<QSignal>(sig), this);
+        }
+        QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
 
+        // prevent merging critical sections
+        QF_CRIT_EXIT_NOP();
+    }
+#else // visit only the lists in the hash table, see NOTE2
+    for (enum_t i = static_cast<enum_t>(0); i < QF_maxPubSignal_; ++i) {
+        QSubscrList &list = QF_PTR_AT_(QF_subscrList_, i);
+        QF_CRIT_STAT_
+        QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
+        if (list.hasElement(p)) {
+            listRemove(list, list.m_sig, this);
         }
-        QF_CRIT_EXIT_();
+        QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
 
         // prevent merging critical sections
         QF_CRIT_EXIT_NOP();
     }
+#endif // QF_PS_REVERSE
+
+#ifdef QF_PS_RANGES
+    rangeRemove(p, static_cast<QSignal>(0), static_cast<QSignal>(0), true);
+#endif // QF_PS_RANGES
+}
+
+#ifdef QF_PS_REVERSE
+//****************************************************************************
+/// @description
+/// This function provides the signals, to which the active object has
+/// subscribed with QP::QActive::subscribe(), by visiting only the signals
+/// of this active object (see NOTE6).
+///
+/// @param[out] sigs array to receive the subscribed signals
+/// @param[in]  n    the dimension of the array @p sigs
+///
+/// @returns
+/// the number of the signals subscribed by the active object, which can
+/// be more than @p n (only the first @p n signals are copied then).
+///
+/// @note
+/// The range subscriptions (see QP::QActive::subscribeRange()) are not
+/// included.
+///
+uint_fast16_t QActive::getSubscriptions(enum_t sigs[],
+                                        uint_fast16_t const n) const
+{
+    QPrio const p = static_cast<QPrio>(m_prio);
+
+    /// @pre the priority must be in range and the AO must also
+    /// be registered with the framework
+    Q_REQUIRE_ID(550, (static_cast<QPrio>(0) < p)
+                      && (p <= static_cast<QPrio>(QF_MAX_ACTIVE))
+                      && (QF::active_[p] == this));
+
+    QF_CRIT_STAT_
+    QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
+    uint_fast16_t const nSig = static_cast<uint_fast16_t>(l_nOwnSig[p]);
+    uint_fast16_t i = static_cast<uint_fast16_t>(0);
+    uint_fast16_t k;
+    for (k = static_cast<uint_fast16_t>(l_ownHead[p]);
+         (k != static_cast<uint_fast16_t>(0)) && (i < n);
+         k = static_cast<uint_fast16_t>(l_ownSig[k - 1U].next))
+    {
+        sigs[i] = static_cast<enum_t>(l_ownSig[k - 1U].sig);
+        ++i;
+    }
+    QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
+
+    return nSig;
+}
+#endif // QF_PS_REVERSE
+
+#ifdef QF_SUBSCR_DENSE
+//****************************************************************************
+/// @description
+/// Inserts the priority @p p into the array of subscribers, which is kept
+/// sorted from the highest to the lowest priority (see NOTE1). Inserting
+/// a subscriber that is already in the list has no effect.
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+void QSubscrList::insert(QPrio const p) {
+    if (!m_set.hasElement(p)) { // not subscribed yet?
+        QPrio i = static_cast<QPrio>(m_nSubscr);
+
+        // shift the lower-prio subscribers to make room for 'p'
+        while ((i > static_cast<QPrio>(0))
+               && (static_cast<QPrio>(m_prio[i - 1U]) < p))
+        {
+            m_prio[i] = m_prio[i - 1U];
+            --i;
+        }
+        m_prio[i] = static_cast<QPrioStore>(p);
+        ++m_nSubscr;
+        m_set.insert(p);
+    }
+}
+
+//****************************************************************************
+/// @description
+/// Removes the priority @p p from the sorted array of subscribers (see
+/// NOTE1). Removing a subscriber that is not in the list has no effect.
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+void QSubscrList::remove(QPrio const p) {
+    if (m_set.hasElement(p)) { // subscribed?
+        QPrio i = static_cast<QPrio>(0);
+        QPrio const n = static_cast<QPrio>(m_nSubscr) - 1U;
+
+        // find the subscriber 'p'
+        while (static_cast<QPrio>(m_prio[i]) != p) {
+            ++i;
+        }
+        // shift the lower-prio subscribers over 'p'
+        for (; i < n; ++i) {
+            m_prio[i] = m_prio[i + 1U];
+        }
+        m_nSubscr = static_cast<QPrioStore>(n);
+        m_set.remove(p);
+    }
 }
+#endif // QF_SUBSCR_DENSE
+
+#ifdef QF_PS_BROADCAST
+//****************************************************************************
+/// @description
+/// The broadcast channel is a static event with the reserved empty signal,
+/// which is posted to the subscribers as the doorbell of the channel.
+/// The channel must be attached to a signal with QP::QF::psBroadcast()
+/// before it can be used.
+///
+QBroadcast::QBroadcast(void)
+#ifdef Q_EVT_CTOR
+  : QEvt(QF_BCAST_SIG_, QEvt::STATIC_EVT)
+#endif
+{
+#ifndef Q_EVT_CTOR
+    sig     = QF_BCAST_SIG_;
+    poolId_ = static_cast<uint8_t>(0); // the doorbell is a static event
+    refCtr_ = static_cast<QEvtRefCtr>(0);
+#endif
+    m_ring  = static_cast<QEvt const **>(0);
+    m_list  = static_cast<QSubscrList const *>(0);
+}
+
+//****************************************************************************
+/// @description
+/// Writes the published event @p e into the ring of the channel and
+/// collects in @p bells the subscribers, which don't have the doorbell of
+/// the channel pending yet (see NOTE5). The event formerly stored in the
+/// slot of the ring is returned in @p old, so that the caller can recycle
+/// it outside of the critical section.
+///
+/// @returns
+/// 'false' if the event could not be written, because the slowest
+/// subscriber has not read the whole ring yet, and 'true' otherwise.
+///
+/// @note
+/// Must be called inside the critical section of the subscriber lists.
+///
+bool QBroadcast::write_(QEvt const * const e, QPSet * const bells,
+                        QEvt const ** const old)
+{
+    QPSet subscr = QF_SUBSCR_SET_(*m_list);
+    bool ok = true;
+
+    // does the ring appear full? find the slowest subscriber again
+    if ((m_head - m_tail) > m_mask) {
+        QPSet set = subscr;
+        m_tail = m_head;
+        while (set.notEmpty()) {
+            QPrio const p = set.findMax();
+            set.remove(p);
+            if ((m_head - m_cursor[p]) > (m_head - m_tail)) {
+                m_tail = m_cursor[p];
+            }
+        }
+    }
+
+    if ((m_head - m_tail) <= m_mask) { // room in the ring?
+        QEvt const ** const slot = &m_ring[m_head & m_mask];
+        *old  = *slot; // all subscribers have already read this event
+        *slot = e;
+        ++m_head;
+
+        // is it a dynamic event? the ring keeps a reference to it
+        if (QF_EVT_POOL_ID_(e) != static_cast<uint8_t>(0)) {
+            QF_EVT_NEST_ENTRY_(e);
+            QF_EVT_REF_CTR_INC_(e);
+            QF_EVT_NEST_EXIT_(e);
+        }
+
+        // only the subscribers without a pending doorbell need one
+        while (subscr.notEmpty()) {
+            QPrio const p = subscr.findMax();
+            subscr.remove(p);
+            if (!m_rung.hasElement(p)) {
+                m_rung.insert(p);
+                bells->insert(p);
+            }
+        }
+    }
+    else {
+        ok = false;
+    }
+    return ok;
+}
+
+//****************************************************************************
+/// @description
+/// Replaces the doorbell of the channel, which the active object @p act
+/// has just removed from its event queue, with the next event from the
+/// ring (see NOTE5). If more events are waiting in the ring, the doorbell
+/// is posted to the active object again, so that the events of the channel
+/// are interleaved with the other events of the active object.
+///
+/// @returns
+/// the next event of the channel for the active object, or NULL if the
+/// doorbell is stale, because the active object has unsubscribed from the
+/// signal meanwhile.
+///
+/// @note
+/// This function is used internally by QP::QActive::get_() outside of any
+/// critical section. The returned event is referenced for the active
+/// object just like a posted event, so it must be recycled with QF::gc().
+///
+QEvt const *QBroadcast::take_(QActive * const act) {
+    QPrio const p = act->getPrio();
+    QEvt const *e = static_cast<QEvt const *>(0); // a stale doorbell?
+    bool more = false;
+    QF_CRIT_STAT_
+    QF_OBJ_CRIT_ENTRY_(QF_subscrLock_);
+
+    uint32_t const c = m_cursor[p];
+    if (m_list->hasElement(p) && (c != m_head)) { // any events to read?
+        e = m_ring[c & m_mask];
+        m_cursor[p] = c + 1U;
+
+        // is it a dynamic event? reference it for the active object
+        if (QF_EVT_POOL_ID_(e) != static_cast<uint8_t>(0)) {
+            QF_EVT_NEST_ENTRY_(e);
+            QF_EVT_REF_CTR_INC_(e);
+            QF_EVT_NEST_EXIT_(e);
+        }
+        more = ((c + 1U) != m_head);
+    }
+    if (!more) {
+        m_rung.remove(p); // the next publication rings the doorbell again
+    }
+    QF_OBJ_CRIT_EXIT_(QF_subscrLock_);
+
+    if (more) { // ring the doorbell again for the rest of the events
+        // POST() asserts internally if the queue overflows
+        (void)act->POST(this, act);
+    }
+    return e;
+}
+#endif // QF_PS_BROADCAST
 
 } // namespace QP
 
+//****************************************************************************
+// NOTE1:
+// When the application is compiled with the macro QF_SUBSCR_DENSE defined,
+// every subscriber list QP::QSubscrList also keeps the priorities of the
+// subscribers in a contiguous array sorted from the highest to the lowest
+// priority. The array is updated incrementally when an active object
+// subscribes or unsubscribes, which is rare, so that QF::publish_(), which
+// is frequent, only copies the array and posts the event in a tight loop,
+// instead of repeatedly finding and removing the highest priority in the
+// priority-set. The price is QF_MAX_ACTIVE + 1 more bytes of RAM per signal
+// in the array of subscriber lists passed to QF::psInit().
+//
+// QF::publish_() copies the array to its stack only if the signal has at
+// most QF_SUBSCR_DENSE_COPY subscribers (QF_MAX_ACTIVE, but at most 64, by
+// default), which takes QF_SUBSCR_DENSE_COPY * sizeof(QP::QPrioStore)
+// bytes of the stack of every publisher regardless of QF_MAX_ACTIVE.
+// A signal with more subscribers, or with range subscribers (see NOTE3),
+// is published through the priority-set of its subscriber list, exactly as
+// without QF_SUBSCR_DENSE, which takes sizeof(QP::QPSet) bytes of the stack
+// (about QF_MAX_ACTIVE / 8 bytes).
+//
+// NOTE2:
+// When the application is compiled with the macro QF_PS_SPARSE defined,
+// the signals are not used as the indices into the array of subscriber
+// lists, so that they can be spread over the whole range of QP::QSignal
+// (e.g., 32-bit signals partitioned by subsystem with Q_SIGNAL_SIZE == 4).
+// Instead, the array passed to QF::psInit() is an open-addressing hash
+// table keyed by the signal, with linear probing. A subscriber list is
+// claimed for a signal when the signal is subscribed for the first time
+// and it is never released afterwards, so no "tombstones" are needed and
+// the size of the table only needs to match the number of the signals
+// that are actually subscribed. The table can have any size (for example
+// the usual MAX_PUB_SIG lists), because the hash of the signal is scaled
+// to the size with a multiplication and a shift instead of a division.
+// Publishing a signal without a subscriber list finds a free list and does
+// nothing. QActive::unsubscribeAll()
+// visits the lists of the hash table instead of all the signals.
+//
+// NOTE3:
+// When the application is compiled with the macro QF_PS_RANGES defined
+// (e.g., -DQF_PS_RANGES=16), active objects can subscribe to whole ranges
+// of signals with QActive::subscribeRange(). At most QF_PS_RANGES range
+// subscriptions of all active objects are kept in a small table, which is
+// independent of the subscriber lists of the individual signals. Whenever
+// the range subscriptions change (which is rare), the signal space is
+// partitioned into sorted segments, in which the set of the range
+// subscribers does not change. QF::publish_() then finds the segment of
+// the published signal by binary search and adds its range subscribers to
+// the subscribers of the individual signal, so the cost of a range
+// subscription to publishing is O(log(QF_PS_RANGES)) regardless of the
+// number of the signals it covers.
+//
+// NOTE4:
+// When the application is compiled with the macro QF_PS_FILTERS defined
+// (e.g., -DQF_PS_FILTERS=32), an active object can subscribe to a signal
+// with a content filter QP::QEvtFilter, for example to receive only the
+// readings of one sensor. At most QF_PS_FILTERS filters of all active
+// objects are kept in a table sorted by the signal, and at most
+// QF_PS_SIG_FILTERS (8 by default) of them can belong to one signal.
+// QF::publish_() copies the filters of the published signal inside the
+// critical section (found by binary search) to an array on its stack and
+// evaluates them outside of it, before posting the event. The array takes
+// QF_PS_SIG_FILTERS * sizeof(QSubscrFilter) bytes of the stack of every
+// publisher (24 bytes per filter on a 64-bit host, 12-16 bytes on a 32-bit
+// MCU), regardless of QF_MAX_ACTIVE. The subscribers, whose filters reject
+// the event, are skipped, so they are neither woken up nor do they
+// reference the event. The filters run in the context of the publisher, so
+// they must be short and they must not call any QF services. A filter
+// applies only to the subscription of the individual signal. An active
+// object, whose range subscription (see NOTE3) covers the signal as well,
+// gets the event regardless of the filter, exactly as if it had no direct
+// subscription.
+//
+// NOTE5:
+// When the application is compiled with the macro QF_PS_BROADCAST defined,
+// a published signal with many subscribers (e.g., a market-data feed) can
+// be given a broadcast channel QP::QBroadcast with QF::psBroadcast().
+// QF::publish_() then writes the event of such signal only once into the
+// ring of the channel and references it only once. Every subscriber reads
+// the ring with its own cursor. A subscriber is notified by posting the
+// channel itself as a "doorbell" (a static event), but only if it has no
+// doorbell of the channel pending already, so a subscriber that lags behind
+// costs the publisher just a bit test instead of an event posting and
+// a wakeup. QActive::get_() replaces the doorbell with the next event from
+// the ring and posts the doorbell again if more events are waiting, so the
+// state machines of the subscribers see the ordinary events, which they
+// recycle as usual. An event stays referenced by the ring until its slot
+// is reused, which happens only after the slowest subscriber has read it.
+// The publisher finds the slowest subscriber only when the ring appears
+// full. If the ring is really full, QF::publish_() asserts, just like when
+// an event queue overflows.
+//
+// The events of a broadcast signal can be dispatched after the events,
+// which were posted directly to the subscriber later. The events, which
+// a subscriber has not read from the ring yet, are skipped when it
+// unsubscribes. A doorbell still queued then is stale, so QActive::get_()
+// returns NULL for it instead of the doorbell and the kernel (or the thread
+// loop of the QF port) skips the RTC step. The subscriber then simply waits
+// or gets scheduled again, as after any other RTC step.
+// The content filters of the subscribers of a broadcast signal are not
+// applied, but the range subscribers of the signal still get the events
+// posted directly.
+//
+// NOTE6:
+// When the application is compiled with the macro QF_PS_REVERSE defined
+// (e.g., -DQF_PS_REVERSE=4096), QF also keeps the signals subscribed by
+// every active object, which QActive::subscribe() and QActive::unsubscribe()
+// maintain along with the subscriber lists. The signals are the nodes of
+// a single pool of QF_PS_REVERSE nodes shared by all active objects, and
+// the nodes of every active object are linked into a list, so QF_PS_REVERSE
+// bounds only the total number of the subscriptions, not the number of the
+// subscriptions of one active object. This reverse index lets
+// QActive::unsubscribeAll() visit only the signals of the active object,
+// instead of all the signals up to the maximum published signal (or all the
+// lists of the hash table with QF_PS_SPARSE), so tearing down an active
+// object takes only as many short critical sections as it has
+// subscriptions. QActive::unsubscribe() searches only the list of the
+// active object. The index also serves QActive::getSubscriptions().
+// The price is QF_PS_REVERSE * (sizeof(QSignal) + 2) bytes of RAM for the
+// pool (rounded up by the alignment) plus 4 bytes per priority level.
+//
+
@@ -43,7 +43,7 @@ namespace QP {
 //****************************************************************************
 QActive::QActive(QStateHandler const initial)
   : QHsm(initial),
-    m_prio(static_cast<uint8_t>(0))
+    m_prio(static_cast<QPrioStore>(0))
 {
     m_state.fun = Q_STATE_CAST(&QHsm::top);
 
@@ -54,6 +54,10 @@ QActive::QActive(QStateHandler const initial)
 #ifdef QF_THREAD_TYPE
     QF::bzero(&m_thread, static_cast<uint_fast16_t>(sizeof(m_thread)));
 #endif
+
+#ifdef QF_DRAIN_MAX
+    m_lifoCtr = static_cast<uint_fast16_t>(0);
+#endif
 }
 
 } // namespace QP
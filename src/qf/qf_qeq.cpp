@@ -91,6 +91,10 @@ void QEQueue::init(QEvt const *qSto[], uint_fast16_t const qLen) {
     m_nFree    = static_cast<QEQueueCtr>(
                  qLen + static_cast<uint_fast16_t>(1)); //+1 for frontEvt
     m_nMin     = m_nFree;
+
+#ifdef QF_OBJ_LOCK_TYPE
+    QF_OBJ_LOCK_INIT(&m_lock); // this queue is protected by its own lock
+#endif // QF_OBJ_LOCK_TYPE
 }
 
 //****************************************************************************
@@ -122,7 +126,7 @@ bool QEQueue::post(QEvt const * const e, uint_fast16_t const margin) {
     /// @pre event must be valid
     Q_REQUIRE_ID(200, e != static_cast<QEvt const *>(0));
 
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(m_lock);
     QEQueueCtr nFree = m_nFree; // temporary to avoid UB for volatile access
 
     // margin available?
@@ -131,7 +135,9 @@ bool QEQueue::post(QEvt const * const e, uint_fast16_t const margin) {
     {
         // is it a dynamic event?
         if (e->poolId_ != static_cast<uint8_t>(0)) {
+            QF_EVT_NEST_ENTRY_(e);
             QF_EVT_REF_CTR_INC_(e); // increment the reference counter
+            QF_EVT_NEST_EXIT_(e);
         }
 
         --nFree; // one free entry just used up
@@ -152,12 +158,12 @@ bool QEQueue::post(QEvt const * const e, uint_fast16_t const margin) {
 
         // is the queue empty?
         if (m_frontEvt == static_cast<QEvt const *>(0)) {
-            m_frontEvt = e; // deliver event directly
+            m_frontEvt = QF_EVT_TO_SLOT_(e); // deliver event directly
         }
         // queue is not empty, leave event in the ring-buffer
         else {
             // insert event into the ring buffer (FIFO)
-            QF_PTR_AT_(m_ring, m_head) = e; // insert e into buffer
+            QF_PTR_AT_(m_ring, m_head) = QF_EVT_TO_SLOT_(e); // insert e
 
             // need to wrap?
             if (m_head == static_cast<QEQueueCtr>(0)) {
@@ -170,7 +176,7 @@ bool QEQueue::post(QEvt const * const e, uint_fast16_t const margin) {
     else {
         /// @note assert if event cannot be posted and dropping events is
         /// not acceptable
-        Q_ASSERT_CRIT_(210, margin != QF_NO_MARGIN);
+        Q_ASSERT_OBJ_CRIT_(m_lock, 210, margin != QF_NO_MARGIN);
 
         QS_BEGIN_NOCRIT_(QS_QF_EQUEUE_POST_ATTEMPT,
                          QS::priv_.locFilter[QS::EQ_OBJ], this)
@@ -184,7 +190,117 @@ bool QEQueue::post(QEvt const * const e, uint_fast16_t const margin) {
 
         status = false; // event not posted
     }
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(m_lock);
+
+    return status;
+}
+
+//****************************************************************************
+/// @description
+/// Post a batch of events to the "raw" thread-safe event queue using the
+/// First-In-First-Out (FIFO) order. Either all the events are posted, in
+/// the order of the array, or none of them is.
+///
+/// @param[in] evts   array of pointers to the events to post
+/// @param[in] n      number of the events in the array (at least 1)
+/// @param[in] margin number of required free slots in the queue after
+///                   posting all the events. The special value
+///                   QP::QF_NO_MARGIN means that this function will assert
+///                   if posting fails.
+///
+/// @returns 'true' (success) when all the events are posted and 'false'
+/// (failure) when the queue cannot accept all of them with the margin.
+///
+/// @note
+/// This function can be called from any task context or ISR context.
+///
+/// @sa
+/// QP::QEQueue::post()
+///
+bool QEQueue::postBatch(QEvt const * const evts[], uint_fast16_t const n,
+                        uint_fast16_t const margin)
+{
+    bool status;
+    uint_fast16_t i;
+    QF_CRIT_STAT_
+
+    /// @pre the array of events must be valid and not empty
+    Q_REQUIRE_ID(220, (evts != static_cast<QEvt const * const *>(0))
+                      && (n != static_cast<uint_fast16_t>(0)));
+
+    QF_OBJ_CRIT_ENTRY_(m_lock);
+    QEQueueCtr nFree = m_nFree; // temporary to avoid UB for volatile access
+
+    // margin available for all n events?
+    if (((margin == QF_NO_MARGIN)
+         && (static_cast<uint_fast16_t>(nFree) >= n))
+        || (static_cast<uint_fast32_t>(nFree)
+            >= (static_cast<uint_fast32_t>(n)
+                + static_cast<uint_fast32_t>(margin))))
+    {
+        for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+            QEvt const * const e = evts[i];
+
+            // is it a dynamic event?
+            if (e->poolId_ != static_cast<uint8_t>(0)) {
+                QF_EVT_NEST_ENTRY_(e);
+                QF_EVT_REF_CTR_INC_(e); // increment the reference counter
+                QF_EVT_NEST_EXIT_(e);
+            }
+
+            // is the queue empty?
+            if (m_frontEvt == static_cast<QEvt const *>(0)) {
+                m_frontEvt = QF_EVT_TO_SLOT_(e); // deliver event directly
+            }
+            // queue is not empty, leave event in the ring-buffer
+            else {
+                // insert event into the ring buffer (FIFO)
+                QF_PTR_AT_(m_ring, m_head) = QF_EVT_TO_SLOT_(e); // insert e
+
+                // need to wrap?
+                if (m_head == static_cast<QEQueueCtr>(0)) {
+                    m_head = m_end; // wrap around
+                }
+                --m_head;
+            }
+        }
+
+        nFree -= static_cast<QEQueueCtr>(n); // n free entries just used up
+        m_nFree = nFree; // update the volatile
+        if (m_nMin > nFree) {
+            m_nMin = nFree; // update minimum so far
+        }
+
+        QS_BEGIN_NOCRIT_(QS_QF_POST_BATCH,
+                         QS::priv_.locFilter[QS::EQ_OBJ], this)
+            QS_TIME_();                      // timestamp
+            QS_OBJ_(static_cast<void *>(0)); // no sender for raw queues
+            QS_OBJ_(this);                   // this queue object
+            QS_EQC_(static_cast<QEQueueCtr>(n)); // number of events posted
+            QS_EQC_(nFree);                  // number of free entries
+            QS_EQC_(m_nMin);                 // min number of free entries
+        QS_END_NOCRIT_()
+
+        status = true; // events posted successfully
+    }
+    else {
+        /// @note assert if the events cannot be posted and dropping events
+        /// is not acceptable
+        Q_ASSERT_OBJ_CRIT_(m_lock, 230, margin != QF_NO_MARGIN);
+
+        QS_BEGIN_NOCRIT_(QS_QF_EQUEUE_POST_ATTEMPT,
+                         QS::priv_.locFilter[QS::EQ_OBJ], this)
+            QS_TIME_();                      // timestamp
+            QS_SIG_(evts[0]->sig);           // the signal of the first evt
+            QS_OBJ_(this);                   // this queue object
+            QS_2U8_(evts[0]->poolId_, evts[0]->refCtr_); // of the first evt
+            QS_EQC_(nFree);                  // number of free entries
+            QS_EQC_(static_cast<QEQueueCtr>(margin)); // margin requested
+        QS_END_NOCRIT_()
+
+        status = false; // events not posted
+    }
+    QF_OBJ_CRIT_EXIT_(m_lock);
 
     return status;
 }
@@ -213,15 +329,18 @@ bool QEQueue::post(QEvt const * const e, uint_fast16_t const margin) {
 void QEQueue::postLIFO(QEvt const * const e) {
     QF_CRIT_STAT_
 
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(m_lock);
     QEQueueCtr nFree = m_nFree; // temporary to avoid UB for volatile access
 
     /// @pre the queue must be able to accept the event (cannot overflow)
-    Q_REQUIRE_CRIT_(300, nFree != static_cast<QEQueueCtr>(0));
+    Q_REQUIRE_OBJ_CRIT_(m_lock, 300,
+                        nFree != static_cast<QEQueueCtr>(0));
 
     // is it a dynamic event?
     if (e->poolId_ != static_cast<uint8_t>(0)) {
+        QF_EVT_NEST_ENTRY_(e);
         QF_EVT_REF_CTR_INC_(e); // increment the reference counter
+        QF_EVT_NEST_EXIT_(e);
     }
 
     --nFree; // one free entry just used up
@@ -241,7 +360,7 @@ void QEQueue::postLIFO(QEvt const * const e) {
     QS_END_NOCRIT_()
 
     QEvt const *frontEvt = m_frontEvt; // read volatile into temporary
-    m_frontEvt = e; // deliver event directly to the front of the queue
+    m_frontEvt = QF_EVT_TO_SLOT_(e); // deliver e directly to the front
 
     // was the queue not empty?
     if (frontEvt != static_cast<QEvt const *>(0)) {
@@ -252,7 +371,7 @@ void QEQueue::postLIFO(QEvt const * const e) {
         QF_PTR_AT_(m_ring, m_tail) = frontEvt; // buffer the old front evt
     }
 
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(m_lock);
 }
 
 //****************************************************************************
@@ -275,8 +394,9 @@ QEvt const *QEQueue::get(void) {
     QEvt const *e;
     QF_CRIT_STAT_
 
-    QF_CRIT_ENTRY_();
-    e = m_frontEvt;  // always remove the event from the front location
+    QF_OBJ_CRIT_ENTRY_(m_lock);
+    // always remove the event from the front location
+    e = QF_EVT_FROM_SLOT_(m_frontEvt, m_inlineEvt);
 
     // is the queue not empty?
     if (e != static_cast<QEvt const *>(0)) {
@@ -304,7 +424,8 @@ QEvt const *QEQueue::get(void) {
             m_frontEvt = static_cast<QEvt const *>(0); // queue becomes empty
 
             // all entries in the queue must be free (+1 for fronEvt)
-            Q_ASSERT_CRIT_(410, nFree == (m_end + static_cast<QEQueueCtr>(1)));
+            Q_ASSERT_OBJ_CRIT_(m_lock, 410,
+                nFree == (m_end + static_cast<QEQueueCtr>(1)));
 
             QS_BEGIN_NOCRIT_(QS_QF_EQUEUE_GET_LAST,
                              QS::priv_.locFilter[QS::EQ_OBJ],
@@ -316,7 +437,7 @@ QEvt const *QEQueue::get(void) {
             QS_END_NOCRIT_()
         }
     }
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(m_lock);
     return e;
 }
 
@@ -52,6 +52,97 @@ Q_DEFINE_THIS_MODULE("qf_time")
 
 // Package-scope objects *****************************************************
 QTimeEvt QF::timeEvtHead_[QF_MAX_TICK_RATE]; // heads of time event lists
+QTickCtr QF::tickCtr_[QF_MAX_TICK_RATE];     // monotonic tick counters
+
+#ifdef QF_OBJ_LOCK_TYPE
+QF_OBJ_LOCK_TYPE QF_timeEvtLock_[QF_MAX_TICK_RATE]; // time event locks
+#endif // QF_OBJ_LOCK_TYPE
+
+//! the lock of the time events at the tick rate of this time event
+#define QF_TE_LOCK_ \
+    (QF_timeEvtLock_[refCtr_ & static_cast<uint8_t>(TE_TICK_RATE)])
+
+#ifdef QF_TIMEEVT_WHEEL
+#if (QF_TIMEEVT_WHEEL < 1) || (QF_TIMEEVT_WHEEL > 12)
+    #error "QF_TIMEEVT_WHEEL defined incorrectly, expected 1..12"
+#endif
+
+//! number of the slots in every level of the timing wheel
+#define QF_TW_SLOTS_  (static_cast<uint_fast32_t>(1) << QF_TIMEEVT_WHEEL)
+
+//! number of the levels of the timing wheel, which cover all the bits of
+//! the tick counter
+#define QF_TW_LEVELS_ \
+    (((8 * QF_TIMEEVT_CTR_SIZE) + QF_TIMEEVT_WHEEL - 1) / QF_TIMEEVT_WHEEL)
+
+//! the slot lists of the timing wheels of all tick rates, see NOTE2
+static QTimeEvt * volatile l_wheel[QF_MAX_TICK_RATE][QF_TW_LEVELS_]
+                                  [QF_TW_SLOTS_];
+
+//! the number of time events linked into the timing wheel of every rate
+static uint_fast32_t l_wheelCtr[QF_MAX_TICK_RATE];
+
+//! detach the list of the slot @p slot_ and store it in @p list_
+#define QF_TW_DETACH_(list_, slot_) do { \
+    (list_) = (slot_); \
+    (slot_) = static_cast<QTimeEvt *>(0); \
+    if ((list_) != static_cast<QTimeEvt *>(0)) { \
+        (list_)->m_pprev = &(list_); \
+    } \
+} while (false)
+#endif // QF_TIMEEVT_WHEEL
+
+#ifdef QF_TIMEEVT_SLACK
+#ifndef QF_TIMEEVT_BATCH
+    //! the maximum number of the due time events collected by QF::tickX_()
+    //! before posting them in batches, see NOTE4
+    #define QF_TIMEEVT_BATCH 16
+#endif
+#if (QF_TIMEEVT_BATCH < 1) || (QF_TIMEEVT_BATCH > 256)
+    #error "QF_TIMEEVT_BATCH defined incorrectly, expected 1..256"
+#endif
+
+//! the sender of the time events posted by QF::tickX_()
+#ifdef Q_SPY
+    #define QF_TE_SENDER_ sender
+#else
+    #define QF_TE_SENDER_ static_cast<void const *>(0)
+#endif // Q_SPY
+
+//! post the @p n due time events @p evt[] to their active objects @p act[],
+//! all the time events of the same active object in one batch (see NOTE4).
+//! The array @p act[] is cleared in the process.
+static void postDue(QActive *act[], QEvt const * const evt[],
+                    uint_fast16_t const n, void const * const sender)
+{
+    QEvt const *batch[QF_TIMEEVT_BATCH];
+    uint_fast16_t i;
+    uint_fast16_t j;
+
+    for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        QActive * const a = act[i];
+
+        // the active object not served yet?
+        if (a != static_cast<QActive *>(0)) {
+            uint_fast16_t nb = static_cast<uint_fast16_t>(0);
+            for (j = i; j < n; ++j) {
+                if (act[j] == a) { // due time event of this AO?
+                    batch[nb] = evt[j];
+                    ++nb;
+                    act[j] = static_cast<QActive *>(0); // served
+                }
+            }
+            if (nb == static_cast<uint_fast16_t>(1)) {
+                (void)a->POST(batch[0], sender); // asserts if queue overflows
+            }
+            else {
+                (void)a->POST_BATCH(batch, nb, sender); // asserts if overflow
+            }
+        }
+    }
+    (void)sender; // unused parameter without Q_SPY
+}
+#endif // QF_TIMEEVT_SLACK
 
 //****************************************************************************
 /// @description
@@ -72,6 +163,8 @@ QTimeEvt QF::timeEvtHead_[QF_MAX_TICK_RATE]; // heads of time event lists
 /// @sa
 /// QP::QTimeEvt.
 ///
+#ifndef QF_TIMEEVT_WHEEL
+
 #ifndef Q_SPY
 void QF::tickX_(uint_fast8_t const tickRate)
 #else
@@ -79,15 +172,28 @@ void QF::tickX_(uint_fast8_t const tickRate, void const * const sender)
 #endif
 {
     QTimeEvt *prev = &timeEvtHead_[tickRate];
+#ifdef QF_TIMEEVT_SLACK
+    QActive *dueAct[QF_TIMEEVT_BATCH]; // AOs of the due time events
+    QEvt const *dueEvt[QF_TIMEEVT_BATCH]; // the due time events
+    uint_fast16_t nDue = static_cast<uint_fast16_t>(0);
+#endif // QF_TIMEEVT_SLACK
     QF_CRIT_STAT_
 
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(QF_timeEvtLock_[tickRate]);
+
+    ++tickCtr_[tickRate]; // monotonic tick counter
 
     QS_BEGIN_NOCRIT_(QS_QF_TICK, static_cast<void*>(0), static_cast<void*>(0))
         QS_TEC_(static_cast<QTimeEvtCtr>(++prev->m_ctr)); // tick ctr
         QS_U8_(static_cast<uint8_t>(tickRate));           // tick rate
     QS_END_NOCRIT_()
 
+    // detach the time events armed since the last run of QF::tickX_(), so
+    // that the time events armed while this tick is being processed
+    // (outside the critical section) are counted only from the next tick
+    QTimeEvt *fresh = timeEvtHead_[tickRate].toTimeEvt();
+    timeEvtHead_[tickRate].m_act = static_cast<void *>(0);
+
     // scan the linked-list of time events at this rate...
     for (;;) {
         QTimeEvt *t = prev->m_next; // advance down the time evt. list
@@ -95,13 +201,14 @@ void QF::tickX_(uint_fast8_t const tickRate, void const * const sender)
         // end of the list?
         if (t == static_cast<QTimeEvt *>(0)) {
 
-            // any new time events armed since the last run of QF::tickX_()?
-            if (timeEvtHead_[tickRate].m_act != static_cast<void *>(0)) {
+            // any new time events armed before this tick?
+            if (fresh != static_cast<QTimeEvt *>(0)) {
 
                 // sanity check
-                Q_ASSERT_CRIT_(110, prev != static_cast<QTimeEvt *>(0));
-                prev->m_next = QF::timeEvtHead_[tickRate].toTimeEvt();
-                timeEvtHead_[tickRate].m_act = static_cast<void *>(0);
+                Q_ASSERT_OBJ_CRIT_(QF_timeEvtLock_[tickRate], 110,
+                                   prev != static_cast<QTimeEvt *>(0));
+                prev->m_next = fresh;
+                fresh = static_cast<QTimeEvt *>(0);
                 t = prev->m_next; // switch to the new list
             }
             else {
@@ -116,7 +223,8 @@ void QF::tickX_(uint_fast8_t const tickRate, void const * const sender)
             t->refCtr_ &= static_cast<uint8_t>(
                               ~static_cast<uint8_t>(TE_IS_LINKED));
             // do NOT advance the prev pointer
-            QF_CRIT_EXIT_(); // exit crit. section to reduce latency
+            // exit crit. section to reduce latency
+            QF_OBJ_CRIT_EXIT_(QF_timeEvtLock_[tickRate]);
 
             // prevent merging critical sections, see NOTE1 below
             QF_CRIT_EXIT_NOP();
@@ -159,23 +267,232 @@ void QF::tickX_(uint_fast8_t const tickRate, void const * const sender)
                     QS_U8_(static_cast<uint8_t>(tickRate)); // tick rate
                 QS_END_NOCRIT_()
 
-                QF_CRIT_EXIT_(); // exit crit. section before posting
+                // exit crit. section before posting
+                QF_OBJ_CRIT_EXIT_(QF_timeEvtLock_[tickRate]);
 
+#ifndef QF_TIMEEVT_SLACK
                 (void)act->POST(t, sender); // asserts if queue overflows
+#else
+                // post the due time events in batches, see NOTE4
+                dueAct[nDue] = act;
+                dueEvt[nDue] = t;
+                ++nDue;
+                if (nDue == static_cast<uint_fast16_t>(QF_TIMEEVT_BATCH)) {
+                    postDue(dueAct, dueEvt, nDue, QF_TE_SENDER_);
+                    nDue = static_cast<uint_fast16_t>(0);
+                }
+                else {
+                    // prevent merging critical sections, see NOTE1 below
+                    QF_CRIT_EXIT_NOP();
+                }
+#endif // QF_TIMEEVT_SLACK
             }
             else {
                 prev = t; // advance to this time event
-                QF_CRIT_EXIT_(); // exit crit. section to reduce latency
+                // exit crit. section to reduce latency
+                QF_OBJ_CRIT_EXIT_(QF_timeEvtLock_[tickRate]);
 
                 // prevent merging critical sections, see NOTE1 below
                 QF_CRIT_EXIT_NOP();
             }
         }
-        QF_CRIT_ENTRY_(); // re-enter crit. section to continue
+        // re-enter crit. section to continue
+        QF_OBJ_CRIT_ENTRY_(QF_timeEvtLock_[tickRate]);
+    }
+    QF_OBJ_CRIT_EXIT_(QF_timeEvtLock_[tickRate]);
+
+#ifdef QF_TIMEEVT_SLACK
+    if (nDue != static_cast<uint_fast16_t>(0)) { // any due time evts left?
+        postDue(dueAct, dueEvt, nDue, QF_TE_SENDER_);
+    }
+#endif // QF_TIMEEVT_SLACK
+}
+
+#else // timing wheel, see NOTE2
+
+#ifndef Q_SPY
+void QF::tickX_(uint_fast8_t const tickRate)
+#else
+void QF::tickX_(uint_fast8_t const tickRate, void const * const sender)
+#endif
+{
+    QTimeEvt * volatile list; // slot list detached from the wheel
+    uint_fast8_t level;
+#ifdef QF_TIMEEVT_SLACK
+    QActive *dueAct[QF_TIMEEVT_BATCH]; // AOs of the due time events
+    QEvt const *dueEvt[QF_TIMEEVT_BATCH]; // the due time events
+    uint_fast16_t nDue = static_cast<uint_fast16_t>(0);
+#endif // QF_TIMEEVT_SLACK
+    QF_CRIT_STAT_
+
+    QF_OBJ_CRIT_ENTRY_(QF_timeEvtLock_[tickRate]);
+
+    QTimeEvtCtr const now = ++timeEvtHead_[tickRate].m_ctr; // tick counter
+    ++tickCtr_[tickRate]; // monotonic tick counter
+
+    QS_BEGIN_NOCRIT_(QS_QF_TICK, static_cast<void*>(0), static_cast<void*>(0))
+        QS_TEC_(now);                           // tick ctr
+        QS_U8_(static_cast<uint8_t>(tickRate)); // tick rate
+    QS_END_NOCRIT_()
+
+    // cascade the slots of the higher levels, whose lower levels have
+    // just wrapped around, into the lower levels
+    for (level = static_cast<uint_fast8_t>(1);
+         (level < static_cast<uint_fast8_t>(QF_TW_LEVELS_))
+         && ((static_cast<uint_fast32_t>(now)
+              & ((static_cast<uint_fast32_t>(1)
+                  << (QF_TIMEEVT_WHEEL * level)) - 1U)) == 0U);
+         ++level)
+    {
+        QF_TW_DETACH_(list, l_wheel[tickRate][level]
+            [(static_cast<uint_fast32_t>(now) >> (QF_TIMEEVT_WHEEL * level))
+             & (QF_TW_SLOTS_ - 1U)]);
+
+        while (list != static_cast<QTimeEvt *>(0)) {
+            QTimeEvt *t = list;
+            t->wheelRemove_(tickRate);
+            t->wheelInsert_(tickRate); // closer to expiration now
+
+            // exit crit. section to reduce latency
+            QF_OBJ_CRIT_EXIT_(QF_timeEvtLock_[tickRate]);
+
+            // prevent merging critical sections, see NOTE1 below
+            QF_CRIT_EXIT_NOP();
+
+            // re-enter crit. section to continue
+            QF_OBJ_CRIT_ENTRY_(QF_timeEvtLock_[tickRate]);
+        }
+    }
+
+    // all time events in the current slot of the level 0 expire now
+    QF_TW_DETACH_(list, l_wheel[tickRate][0]
+        [static_cast<uint_fast32_t>(now) & (QF_TW_SLOTS_ - 1U)]);
+
+    while (list != static_cast<QTimeEvt *>(0)) {
+        QTimeEvt *t = list;
+        QActive *act = t->toActive(); // temporary for volatile
+
+        t->wheelRemove_(tickRate);
+
+        // periodic time evt?
+        if (t->m_interval != static_cast<QTimeEvtCtr>(0)) {
+            t->m_ctr = t->m_interval; // rearm the time event
+            t->m_expire = static_cast<QTimeEvtCtr>(now + t->m_interval);
+            t->wheelInsert_(tickRate);
+        }
+        // one-shot time event: automatically disarm
+        else {
+            t->m_ctr = static_cast<QTimeEvtCtr>(0);
+
+            QS_BEGIN_NOCRIT_(QS_QF_TIMEEVT_AUTO_DISARM,
+                             QS::priv_.locFilter[QS::TE_OBJ], t)
+                QS_OBJ_(t);        // this time event object
+                QS_OBJ_(act);      // the target AO
+                QS_U8_(static_cast<uint8_t>(tickRate)); // tick rate
+            QS_END_NOCRIT_()
+        }
+
+        QS_BEGIN_NOCRIT_(QS_QF_TIMEEVT_POST,
+                         QS::priv_.locFilter[QS::TE_OBJ], t)
+            QS_TIME_();            // timestamp
+            QS_OBJ_(t);            // the time event object
+            QS_SIG_(t->sig);       // signal of this time event
+            QS_OBJ_(act);          // the target AO
+            QS_U8_(static_cast<uint8_t>(tickRate)); // tick rate
+        QS_END_NOCRIT_()
+
+        // exit crit. section before posting
+        QF_OBJ_CRIT_EXIT_(QF_timeEvtLock_[tickRate]);
+
+#ifndef QF_TIMEEVT_SLACK
+        (void)act->POST(t, sender); // asserts if queue overflows
+#else
+        // post the due time events in batches, see NOTE4
+        dueAct[nDue] = act;
+        dueEvt[nDue] = t;
+        ++nDue;
+        if (nDue == static_cast<uint_fast16_t>(QF_TIMEEVT_BATCH)) {
+            postDue(dueAct, dueEvt, nDue, QF_TE_SENDER_);
+            nDue = static_cast<uint_fast16_t>(0);
+        }
+        else {
+            // prevent merging critical sections, see NOTE1 below
+            QF_CRIT_EXIT_NOP();
+        }
+#endif // QF_TIMEEVT_SLACK
+
+        // re-enter crit. section to continue
+        QF_OBJ_CRIT_ENTRY_(QF_timeEvtLock_[tickRate]);
     }
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(QF_timeEvtLock_[tickRate]);
+
+#ifdef QF_TIMEEVT_SLACK
+    if (nDue != static_cast<uint_fast16_t>(0)) { // any due time evts left?
+        postDue(dueAct, dueEvt, nDue, QF_TE_SENDER_);
+    }
+#endif // QF_TIMEEVT_SLACK
 }
 
+//****************************************************************************
+/// @description
+/// Inserts the time event into the list of the slot of the timing wheel,
+/// which corresponds to the expiration tick m_expire. The level of the
+/// wheel is the lowest one that can hold the remaining number of ticks.
+///
+/// @note
+/// Must be called inside the critical section of the tick rate.
+///
+void QTimeEvt::wheelInsert_(uint_fast8_t const tickRate) {
+    uint_fast32_t const delta = static_cast<uint_fast32_t>(
+        static_cast<QTimeEvtCtr>(m_expire - QF::timeEvtHead_[tickRate].m_ctr));
+    uint_fast8_t level = static_cast<uint_fast8_t>(0);
+
+    while ((level < static_cast<uint_fast8_t>(QF_TW_LEVELS_ - 1))
+           && ((delta >> (QF_TIMEEVT_WHEEL * (level + 1U))) != 0U))
+    {
+        ++level;
+    }
+
+    QTimeEvt * volatile * const slot = &l_wheel[tickRate][level]
+        [(static_cast<uint_fast32_t>(m_expire) >> (QF_TIMEEVT_WHEEL * level))
+         & (QF_TW_SLOTS_ - 1U)];
+
+    m_next  = *slot; // push to the front of the slot list
+    m_pprev = slot;
+    if (m_next != static_cast<QTimeEvt *>(0)) {
+        m_next->m_pprev = &m_next;
+    }
+    *slot = this;
+
+    refCtr_ |= static_cast<uint8_t>(TE_IS_LINKED); // mark as linked
+    ++l_wheelCtr[tickRate];
+}
+
+//****************************************************************************
+/// @description
+/// Removes the time event from the list of a slot of the timing wheel (or
+/// from a slot list detached from the wheel) in constant time.
+///
+/// @note
+/// Must be called inside the critical section of the tick rate.
+///
+void QTimeEvt::wheelRemove_(uint_fast8_t const tickRate) {
+    QTimeEvt * const next = m_next;
+
+    *m_pprev = next;
+    if (next != static_cast<QTimeEvt *>(0)) {
+        next->m_pprev = m_pprev;
+    }
+    m_next  = static_cast<QTimeEvt *>(0);
+    m_pprev = static_cast<QTimeEvt * volatile *>(0);
+
+    // mark time event as NOT linked
+    refCtr_ &= static_cast<uint8_t>(~static_cast<uint8_t>(TE_IS_LINKED));
+    --l_wheelCtr[tickRate];
+}
+
+#endif // QF_TIMEEVT_WHEEL
+
 //****************************************************************************
 // NOTE1:
 // In some QF ports the critical section exit takes effect only on the next
@@ -186,6 +503,58 @@ void QF::tickX_(uint_fast8_t const tickRate, void const * const sender)
 // The QF_CRIT_EXIT_NOP() macro contains minimal code required
 // to prevent such merging of critical sections in QF ports,
 // in which it can occur.
+//
+// NOTE2:
+// When the application is compiled with the macro QF_TIMEEVT_WHEEL defined
+// (e.g., -DQF_TIMEEVT_WHEEL=8), the time events of every tick rate are kept
+// in a hierarchical timing wheel instead of the linear list, which
+// QF::tickX_() must scan in every tick. Every level of the wheel has
+// 2^QF_TIMEEVT_WHEEL slots, which are indexed by the next QF_TIMEEVT_WHEEL
+// bits of the tick counter, and there are enough levels to cover all bits
+// of QP::QTimeEvtCtr.
+// An armed time event is linked into the slot of its expiration tick at the
+// lowest level that can hold the remaining number of ticks. In every tick
+// QF::tickX_() fires all time events of the current slot of the level 0,
+// and whenever a level wraps around, it re-inserts the time events of the
+// current slot of the next level into the lower levels (cascading). The
+// cost of a tick is therefore proportional to the number of the expiring
+// (and cascaded) time events instead of all armed time events. The time
+// events are removed from the doubly-linked slot lists immediately when
+// disarmed or rearmed, which is also done in constant time.
+//
+// NOTE3:
+// When the application is compiled with the macro QF_TICKLESS defined, the
+// QF port does not call QF::tickX_() periodically, but only in the clock
+// ticks, in which some time events need processing. QF::ticksToNextX()
+// tells the port how far ahead the next such tick is, and QF::skipTicksX_()
+// advances all time events over the idle ticks in between at once. Because
+// the tick counters then lag behind the real time, QTimeEvt::armX() and
+// QTimeEvt::rearm() extend the timeout by the lag of the tick counter behind
+// the current tick reported by the port (QF_TIMEEVT_NOW_()), so that the
+// timeout counts from the current tick. The thread arming a time event thus
+// never processes the overdue ticks itself, which is left to the port. The
+// port must be notified after arming (QF_TIMEEVT_ARMED_()), because the new
+// time event can expire before the tick the port is waiting for.
+// QTimeEvt::armAt() needs no such correction, because its deadline is the
+// absolute value of the tick counter.
+//
+// NOTE4:
+// When the application is compiled with the macro QF_TIMEEVT_SLACK defined
+// (e.g., -DQF_TIMEEVT_SLACK), every time event can be given a slack by
+// QP::QTimeEvt::setSlack(), that is the number of ticks, by which its
+// expiration may be delayed. The expiration is then aligned up to the
+// absolute tick, which is a multiple of the largest power of two not
+// exceeding (slack + 1), so that the time events with similar timeouts
+// expire in the same ticks instead of many distinct ones. Only the first
+// expiration (the arming) is aligned and the periodic time events keep
+// their interval, so they remain aligned if the interval is a multiple of
+// the alignment. QF::tickX_() collects the due time events of a tick and
+// posts all of them of the same active object in a single batch
+// (QP::QActive::postBatch_()), so the active object wakes up only once.
+// The value of QF_TIMEEVT_SLACK is not used. QF::tickX_() collects up to
+// QF_TIMEEVT_BATCH (1..256, 16 by default) due time events before posting
+// them, which is also the maximum size of a batch. Larger values post
+// fewer batches under load at the cost of more stack in QF::tickX_().
 
 
 //****************************************************************************
@@ -203,6 +572,7 @@ void QF::tickX_(uint_fast8_t const tickRate, void const * const sender)
 ///
 bool QF::noTimeEvtsActiveX(uint_fast8_t const tickRate) {
     bool inactive;
+#ifndef QF_TIMEEVT_WHEEL
     if (timeEvtHead_[tickRate].m_next == static_cast<QTimeEvt *>(0)) {
         inactive = false;
     }
@@ -212,9 +582,196 @@ bool QF::noTimeEvtsActiveX(uint_fast8_t const tickRate) {
     else {
         inactive = true;
     }
+#else
+    inactive = (l_wheelCtr[tickRate] == static_cast<uint_fast32_t>(0));
+#endif // QF_TIMEEVT_WHEEL
     return inactive;
 }
 
+//****************************************************************************
+/// @description
+/// Returns the monotonic counter of the clock ticks processed at the given
+/// tick rate (by QP::QF::tickX_()) since the start of the application.
+/// Unlike the time event counters, this 64-bit counter does not wrap around
+/// in practice, so it can serve as the time base for absolute deadlines
+/// (see QP::QTimeEvt::armAt()).
+///
+/// @param[in]  tickRate  system clock tick rate to find out about.
+///
+/// @returns the number of clock ticks processed at the given tick rate.
+///
+QTickCtr QF::getTickCtr(uint_fast8_t const tickRate) {
+    QF_CRIT_STAT_
+
+    /// @pre the tick rate must be in range
+    Q_REQUIRE_ID(700, tickRate < static_cast<uint_fast8_t>(QF_MAX_TICK_RATE));
+
+    QF_OBJ_CRIT_ENTRY_(QF_timeEvtLock_[tickRate]);
+    QTickCtr const ctr = tickCtr_[tickRate]; // not atomic on most CPUs
+    QF_OBJ_CRIT_EXIT_(QF_timeEvtLock_[tickRate]);
+
+    return ctr;
+}
+
+#ifdef QF_TICKLESS
+
+//****************************************************************************
+/// @description
+/// Finds the number of ticks until the next tick of the tick rate
+/// @p tickRate, in which QF::tickX_() has some work, or 0 if no time
+/// events are armed.
+///
+/// @note
+/// Must be called inside the critical section of the tick rate.
+///
+QTimeEvtCtr QF::nextTick_(uint_fast8_t const tickRate) {
+    QTimeEvtCtr next = static_cast<QTimeEvtCtr>(0);
+
+#ifndef QF_TIMEEVT_WHEEL
+    // the main list and the "freshly armed" list of time events
+    QTimeEvt *t = timeEvtHead_[tickRate].m_next;
+    QTimeEvt *fresh = timeEvtHead_[tickRate].toTimeEvt();
+    for (;;) {
+        if (t == static_cast<QTimeEvt *>(0)) {
+            t = fresh; // continue with the "freshly armed" list
+            fresh = static_cast<QTimeEvt *>(0);
+        }
+        if (t == static_cast<QTimeEvt *>(0)) {
+            break;
+        }
+        QTimeEvtCtr const ctr = t->m_ctr; // temporary to hold volatile
+        if ((ctr != static_cast<QTimeEvtCtr>(0))
+            && ((next == static_cast<QTimeEvtCtr>(0)) || (ctr < next)))
+        {
+            next = ctr;
+        }
+        t = t->m_next;
+    }
+#else // timing wheel, see NOTE2
+    if (l_wheelCtr[tickRate] != static_cast<uint_fast32_t>(0)) {
+        uint_fast32_t const now =
+            static_cast<uint_fast32_t>(timeEvtHead_[tickRate].m_ctr);
+        uint_fast8_t level;
+
+        // find the closest non-empty slot ahead in every level. The slots
+        // of the higher levels need processing (cascading) at the start
+        // of their range of ticks. The current slot of a higher level
+        // holds the time events a full rotation ahead, which cascade
+        // when the lower levels wrap around the next time (j == SLOTS).
+        for (level = static_cast<uint_fast8_t>(0);
+             level < static_cast<uint_fast8_t>(QF_TW_LEVELS_);
+             ++level)
+        {
+            uint_fast8_t const shift =
+                static_cast<uint_fast8_t>(QF_TIMEEVT_WHEEL * level);
+            uint_fast32_t const last = (level == static_cast<uint_fast8_t>(0))
+                                       ? (QF_TW_SLOTS_ - 1U)
+                                       : QF_TW_SLOTS_;
+            uint_fast32_t j;
+            for (j = 1U; j <= last; ++j) {
+                if (l_wheel[tickRate][level][((now >> shift) + j)
+                        & (QF_TW_SLOTS_ - 1U)] != static_cast<QTimeEvt *>(0))
+                {
+                    QTimeEvtCtr const dist = static_cast<QTimeEvtCtr>(
+                        (((now >> shift) + j) << shift) - now);
+                    if ((next == static_cast<QTimeEvtCtr>(0))
+                        || (dist < next))
+                    {
+                        next = dist;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+#endif // QF_TIMEEVT_WHEEL
+
+    return next;
+}
+
+//****************************************************************************
+/// @description
+/// Finds the number of clock ticks until the next tick of the given tick
+/// rate, in which QP::QF::tickX_() needs to process some time events
+/// (see NOTE3 in qf_time.cpp).
+///
+/// @param[in]  tickRate  system clock tick rate to find out about.
+///
+/// @returns
+/// the number of ticks until the next tick with any work or zero if no
+/// time events are armed at the given tick rate.
+///
+QTimeEvtCtr QF::ticksToNextX(uint_fast8_t const tickRate) {
+    QF_CRIT_STAT_
+
+    QF_OBJ_CRIT_ENTRY_(QF_timeEvtLock_[tickRate]);
+    QTimeEvtCtr const next = nextTick_(tickRate);
+    QF_OBJ_CRIT_EXIT_(QF_timeEvtLock_[tickRate]);
+
+    return next;
+}
+
+//****************************************************************************
+/// @description
+/// Advances all time events of the given tick rate by up to @p nTicks
+/// clock ticks at once, but stops one tick before the next tick with any
+/// work (see QP::QF::ticksToNextX()). The tick after the skipped ticks must
+/// be then processed by QP::QF::tickX_() as usual.
+///
+/// @param[in]  tickRate  system clock tick rate to advance.
+/// @param[in]  nTicks    the maximum number of ticks to skip.
+///
+/// @returns
+/// the number of ticks actually skipped.
+///
+/// @note
+/// This function is intended only for the QF ports (see NOTE3 in
+/// qf_time.cpp).
+///
+QTimeEvtCtr QF::skipTicksX_(uint_fast8_t const tickRate,
+                            QTimeEvtCtr const nTicks)
+{
+    QF_CRIT_STAT_
+
+    QF_OBJ_CRIT_ENTRY_(QF_timeEvtLock_[tickRate]);
+
+    QTimeEvtCtr n = nextTick_(tickRate);
+    if ((n == static_cast<QTimeEvtCtr>(0)) || (nTicks < n)) {
+        n = nTicks;
+    }
+    else {
+        --n; // stop just before the tick with some work
+    }
+
+    timeEvtHead_[tickRate].m_ctr += n; // tick counter
+    tickCtr_[tickRate] += n; // monotonic tick counter
+
+#ifndef QF_TIMEEVT_WHEEL
+    // the main list and the "freshly armed" list of time events
+    QTimeEvt *t = timeEvtHead_[tickRate].m_next;
+    QTimeEvt *fresh = timeEvtHead_[tickRate].toTimeEvt();
+    for (;;) {
+        if (t == static_cast<QTimeEvt *>(0)) {
+            t = fresh; // continue with the "freshly armed" list
+            fresh = static_cast<QTimeEvt *>(0);
+        }
+        if (t == static_cast<QTimeEvt *>(0)) {
+            break;
+        }
+        if (t->m_ctr != static_cast<QTimeEvtCtr>(0)) { // armed?
+            t->m_ctr -= n; // cannot reach zero
+        }
+        t = t->m_next;
+    }
+#endif // QF_TIMEEVT_WHEEL
+
+    QF_OBJ_CRIT_EXIT_(QF_timeEvtLock_[tickRate]);
+
+    return n;
+}
+
+#endif // QF_TICKLESS
+
 //****************************************************************************
 /// @description
 /// When creating a time event, you must commit it to a specific active object
@@ -236,6 +793,13 @@ QTimeEvt::QTimeEvt(QActive * const act,
     m_act(act),
     m_ctr(static_cast<QTimeEvtCtr>(0)),
     m_interval(static_cast<QTimeEvtCtr>(0))
+#ifdef QF_TIMEEVT_WHEEL
+    , m_pprev(static_cast<QTimeEvt * volatile *>(0)),
+    m_expire(static_cast<QTimeEvtCtr>(0))
+#endif // QF_TIMEEVT_WHEEL
+#ifdef QF_TIMEEVT_SLACK
+    , m_slack(static_cast<QTimeEvtCtr>(0))
+#endif // QF_TIMEEVT_SLACK
 {
     /// @pre The signal must be valid and the tick rate in range
     Q_REQUIRE_ID(300, (sgnl >= Q_USER_SIG)
@@ -271,6 +835,13 @@ QTimeEvt::QTimeEvt()
     m_act(static_cast<QActive *>(0)),
     m_ctr(static_cast<QTimeEvtCtr>(0)),
     m_interval(static_cast<QTimeEvtCtr>(0))
+#ifdef QF_TIMEEVT_WHEEL
+    , m_pprev(static_cast<QTimeEvt * volatile *>(0)),
+    m_expire(static_cast<QTimeEvtCtr>(0))
+#endif // QF_TIMEEVT_WHEEL
+#ifdef QF_TIMEEVT_SLACK
+    , m_slack(static_cast<QTimeEvtCtr>(0))
+#endif // QF_TIMEEVT_SLACK
 {
 #ifndef Q_EVT_CTOR
     sig = static_cast<QSignal>(0);
@@ -329,10 +900,104 @@ void QTimeEvt::armX(QTimeEvtCtr const nTicks, QTimeEvtCtr const interval) {
                  && (tickRate < static_cast<uint_fast8_t>(QF_MAX_TICK_RATE))
                  && (static_cast<enum_t>(sig) >= Q_USER_SIG));
 
-    QF_CRIT_ENTRY_();
-    m_ctr = nTicks;
+#ifdef QF_TICKLESS
+    QTickCtr const now = QF_TIMEEVT_NOW_(); // the current tick, see NOTE3
+#endif // QF_TICKLESS
+
+    QF_OBJ_CRIT_ENTRY_(QF_TE_LOCK_);
+#ifdef QF_TIMEEVT_WHEEL
+    // the disarmed time event cannot be linked into the wheel
+    Q_ASSERT_OBJ_CRIT_(QF_TE_LOCK_, 410,
+        (refCtr_ & static_cast<uint8_t>(TE_IS_LINKED))
+        == static_cast<uint8_t>(0));
+#endif // QF_TIMEEVT_WHEEL
+
+#ifndef QF_TICKLESS
+    QTimeEvtCtr const ticks = arm_(tickRate, nTicks, interval);
+#else // count the timeout from the current tick, see NOTE3
+    QTimeEvtCtr const ticks = arm_(tickRate,
+                                   lag_(tickRate, nTicks, now), interval);
+#endif // QF_TICKLESS
+    QF_OBJ_CRIT_EXIT_(QF_TE_LOCK_);
+
+    QF_TIMEEVT_ARMED_(ticks); // the horizon might be shorter, see NOTE3
+}
+
+//****************************************************************************
+/// @description
+/// Arms a time event to fire at the absolute clock tick @p absTick of its
+/// tick rate (see QP::QF::getTickCtr()), optionally periodically with
+/// the period @p interval. Because the deadline does not depend on the
+/// moment of arming, periodic work rearmed from the state machine (e.g.,
+/// at @c absTick + period) stays phase-locked to the clock ticks.
+///
+/// @param[in] absTick  the absolute tick, in which the time event expires
+/// @param[in] interval interval (in clock ticks) for periodic time event.
+///
+/// @attention
+/// The deadline @p absTick must lie in the future, but no further than the
+/// dynamic range of QP::QTimeEvtCtr.
+///
+void QTimeEvt::armAt(QTickCtr const absTick, QTimeEvtCtr const interval) {
+    uint_fast8_t tickRate = static_cast<uint_fast8_t>(refCtr_)
+                            & static_cast<uint_fast8_t>(TE_TICK_RATE);
+    QTimeEvtCtr cntr = m_ctr;  // temporary to hold volatile
+    QF_CRIT_STAT_
+
+    /// @pre the host AO must be valid, time event must be disarmed,
+    /// and the signal must be valid.
+    ///
+    Q_REQUIRE_ID(450, (m_act != static_cast<void *>(0))
+                 && (cntr == static_cast<QTimeEvtCtr>(0))
+                 && (tickRate < static_cast<uint_fast8_t>(QF_MAX_TICK_RATE))
+                 && (static_cast<enum_t>(sig) >= Q_USER_SIG));
+
+    QF_OBJ_CRIT_ENTRY_(QF_TE_LOCK_);
+    QTickCtr const now = QF::tickCtr_[tickRate];
+
+    /// @pre the deadline must be in the future and within the range
+    /// of the time event counter
+    Q_ASSERT_OBJ_CRIT_(QF_TE_LOCK_, 460, (absTick > now)
+        && ((absTick - now)
+            <= static_cast<QTickCtr>(static_cast<QTimeEvtCtr>(~0U))));
+
+#ifdef QF_TIMEEVT_WHEEL
+    // the disarmed time event cannot be linked into the wheel
+    Q_ASSERT_OBJ_CRIT_(QF_TE_LOCK_, 470,
+        (refCtr_ & static_cast<uint8_t>(TE_IS_LINKED))
+        == static_cast<uint8_t>(0));
+#endif // QF_TIMEEVT_WHEEL
+
+    QTimeEvtCtr const ticks = arm_(tickRate,
+        static_cast<QTimeEvtCtr>(absTick - now), interval);
+    QF_OBJ_CRIT_EXIT_(QF_TE_LOCK_);
+
+    QF_TIMEEVT_ARMED_(ticks); // the horizon might be shorter, see NOTE3
+}
+
+//****************************************************************************
+/// @description
+/// Links the time event armed for @p nTicks ticks into the time events of
+/// the tick rate @p tickRate (shared by QP::QTimeEvt::armX() and
+/// QP::QTimeEvt::armAt()).
+///
+/// @note
+/// Must be called inside the critical section of the tick rate.
+///
+QTimeEvtCtr QTimeEvt::arm_(uint_fast8_t const tickRate,
+                           QTimeEvtCtr const nTicks,
+                           QTimeEvtCtr const interval)
+{
+#ifndef QF_TIMEEVT_SLACK
+    QTimeEvtCtr const ticks = nTicks;
+#else
+    QTimeEvtCtr const ticks = align_(tickRate, nTicks); // see NOTE4
+#endif // QF_TIMEEVT_SLACK
+
+    m_ctr = ticks;
     m_interval = interval;
 
+#ifndef QF_TIMEEVT_WHEEL
     // is the time event unlinked?
     // NOTE: For the duration of a single clock tick of the specified tick
     // rate a time event can be disarmed and yet still linked into the list,
@@ -354,19 +1019,82 @@ void QTimeEvt::armX(QTimeEvtCtr const nTicks, QTimeEvtCtr const interval) {
         m_next = QF::timeEvtHead_[tickRate].toTimeEvt();
         QF::timeEvtHead_[tickRate].m_act = this;
     }
+#else // timing wheel, see NOTE2
+    m_expire = static_cast<QTimeEvtCtr>(
+                   QF::timeEvtHead_[tickRate].m_ctr + ticks);
+    wheelInsert_(tickRate);
+#endif // QF_TIMEEVT_WHEEL
 
     QS_BEGIN_NOCRIT_(QS_QF_TIMEEVT_ARM, QS::priv_.locFilter[QS::TE_OBJ], this)
         QS_TIME_();        // timestamp
         QS_OBJ_(this);     // this time event object
         QS_OBJ_(m_act);    // the active object
-        QS_TEC_(nTicks);   // the number of ticks
+        QS_TEC_(ticks);    // the number of ticks
         QS_TEC_(interval); // the interval
         QS_U8_(static_cast<uint8_t>(tickRate)); // tick rate
     QS_END_NOCRIT_()
 
-    QF_CRIT_EXIT_();
+    return ticks;
 }
 
+#ifdef QF_TIMEEVT_SLACK
+//****************************************************************************
+/// @description
+/// Extends the number of ticks @p nTicks by at most the slack of the time
+/// event, so that the time event expires at the absolute tick (see
+/// QP::QF::getTickCtr()), which is a multiple of the largest power of two
+/// not exceeding (m_slack + 1). The time events of similar timeouts then
+/// expire in the same ticks (see NOTE4).
+///
+/// @note
+/// Must be called inside the critical section of the tick rate.
+///
+QTimeEvtCtr QTimeEvt::align_(uint_fast8_t const tickRate,
+                             QTimeEvtCtr const nTicks) const
+{
+    QTickCtr align = static_cast<QTickCtr>(1);
+    while ((align << 1) <= (static_cast<QTickCtr>(m_slack) + 1U)) {
+        align <<= 1;
+    }
+
+    QTickCtr const expire = QF::tickCtr_[tickRate] + nTicks;
+    QTickCtr const ticks = static_cast<QTickCtr>(nTicks)
+        + (((expire + align - 1U) & ~(align - 1U)) - expire);
+
+    // the aligned expiration out of the range of the time event counter?
+    return (ticks <= static_cast<QTickCtr>(static_cast<QTimeEvtCtr>(~0U)))
+           ? static_cast<QTimeEvtCtr>(ticks)
+           : nTicks;
+}
+#endif // QF_TIMEEVT_SLACK
+
+#ifdef QF_TICKLESS
+//****************************************************************************
+/// @description
+/// Extends the number of ticks @p nTicks by the number of ticks, by which
+/// the tick counter of @p tickRate lags behind the current tick @p now of
+/// the tickless QF port, so that the timeout counts from the current tick
+/// rather than from the last processed one (see NOTE3).
+///
+/// @note
+/// Must be called inside the critical section of the tick rate.
+///
+QTimeEvtCtr QTimeEvt::lag_(uint_fast8_t const tickRate,
+                           QTimeEvtCtr const nTicks, QTickCtr const now)
+{
+    QTickCtr ticks = static_cast<QTickCtr>(nTicks);
+    if (now > QF::tickCtr_[tickRate]) { // the tick counter lagging behind?
+        ticks += now - QF::tickCtr_[tickRate];
+    }
+
+    // beyond the range of the time event counter?
+    if (ticks > static_cast<QTickCtr>(static_cast<QTimeEvtCtr>(~0U))) {
+        ticks = static_cast<QTickCtr>(static_cast<QTimeEvtCtr>(~0U));
+    }
+    return static_cast<QTimeEvtCtr>(ticks);
+}
+#endif // QF_TICKLESS
+
 //****************************************************************************
 /// @description
 /// Disarm the time event so it can be safely reused.
@@ -385,7 +1113,7 @@ void QTimeEvt::armX(QTimeEvtCtr const nTicks, QTimeEvtCtr const interval) {
 ///
 bool QTimeEvt::disarm(void) {
     QF_CRIT_STAT_
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(QF_TE_LOCK_);
     bool wasArmed;
 
     // is the time event actually armed?
@@ -405,6 +1133,10 @@ bool QTimeEvt::disarm(void) {
         QS_END_NOCRIT_()
 
         m_ctr = static_cast<QTimeEvtCtr>(0); // schedule removal from the list
+#ifdef QF_TIMEEVT_WHEEL
+        wheelRemove_(static_cast<uint_fast8_t>(refCtr_)
+                     & static_cast<uint_fast8_t>(TE_TICK_RATE));
+#endif // QF_TIMEEVT_WHEEL
     }
     else { // the time event was already disarmed automatically
         wasArmed = false;
@@ -419,7 +1151,7 @@ bool QTimeEvt::disarm(void) {
         QS_END_NOCRIT_()
 
     }
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(QF_TE_LOCK_);
     return wasArmed;
 }
 
@@ -456,13 +1188,25 @@ bool QTimeEvt::rearm(QTimeEvtCtr const nTicks) {
                  && (nTicks != static_cast<QTimeEvtCtr>(0))
                  && (static_cast<enum_t>(sig) >= Q_USER_SIG));
 
-    QF_CRIT_ENTRY_();
+#ifdef QF_TICKLESS
+    QTickCtr const now = QF_TIMEEVT_NOW_(); // the current tick, see NOTE3
+#endif // QF_TICKLESS
+
+    QF_OBJ_CRIT_ENTRY_(QF_TE_LOCK_);
     bool wasArmed;
+    QTimeEvtCtr ticks = nTicks;
+#ifdef QF_TICKLESS
+    ticks = lag_(tickRate, ticks, now); // count from the current tick, NOTE3
+#endif // QF_TICKLESS
+#ifdef QF_TIMEEVT_SLACK
+    ticks = align_(tickRate, ticks); // see NOTE4
+#endif // QF_TIMEEVT_SLACK
 
     // is the time evt not running?
     if (m_ctr == static_cast<QTimeEvtCtr>(0)) {
         wasArmed = false;
 
+#ifndef QF_TIMEEVT_WHEEL
         // is the time event unlinked?
         // NOTE: For a duration of a single clock tick of the specified
         // tick rate a time event can be disarmed and yet still linked into
@@ -485,11 +1229,20 @@ bool QTimeEvt::rearm(QTimeEvtCtr const nTicks) {
             m_next = QF::timeEvtHead_[tickRate].toTimeEvt();
             QF::timeEvtHead_[tickRate].m_act = this;
         }
+#endif // QF_TIMEEVT_WHEEL
     }
     else { // the time event is being disarmed
         wasArmed = true;
+#ifdef QF_TIMEEVT_WHEEL
+        wheelRemove_(tickRate); // remove from the slot of the old expiration
+#endif // QF_TIMEEVT_WHEEL
     }
-    m_ctr = nTicks; // re-load the tick counter (shift the phasing)
+    m_ctr = ticks; // re-load the tick counter (shift the phasing)
+#ifdef QF_TIMEEVT_WHEEL
+    m_expire = static_cast<QTimeEvtCtr>(
+                   QF::timeEvtHead_[tickRate].m_ctr + ticks);
+    wheelInsert_(tickRate);
+#endif // QF_TIMEEVT_WHEEL
 
     QS_BEGIN_NOCRIT_(QS_QF_TIMEEVT_REARM,
                      QS::priv_.locFilter[QS::TE_OBJ], this)
@@ -503,7 +1256,9 @@ bool QTimeEvt::rearm(QTimeEvtCtr const nTicks) {
                             : static_cast<uint8_t>(0)));
     QS_END_NOCRIT_()
 
-    QF_CRIT_EXIT_();
+    QF_OBJ_CRIT_EXIT_(QF_TE_LOCK_);
+
+    QF_TIMEEVT_ARMED_(ticks); // the horizon might be shorter, see NOTE3
     return wasArmed;
 }
 
@@ -549,9 +1304,16 @@ bool QTimeEvt::wasDisarmed(void) {
 QTimeEvtCtr QTimeEvt::ctr(void) const {
     QF_CRIT_STAT_
 
-    QF_CRIT_ENTRY_();
+    QF_OBJ_CRIT_ENTRY_(QF_TE_LOCK_);
     QTimeEvtCtr ret = m_ctr;
-    QF_CRIT_EXIT_();
+#ifdef QF_TIMEEVT_WHEEL
+    if (ret != static_cast<QTimeEvtCtr>(0)) { // armed?
+        ret = static_cast<QTimeEvtCtr>(m_expire
+            - QF::timeEvtHead_[refCtr_ & static_cast<uint8_t>(TE_TICK_RATE)]
+                  .m_ctr);
+    }
+#endif // QF_TIMEEVT_WHEEL
+    QF_OBJ_CRIT_EXIT_(QF_TE_LOCK_);
 
     return ret;
 }
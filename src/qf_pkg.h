@@ -42,6 +42,12 @@
 //! helper macro to cast const away from an event pointer @p e_
 #define QF_EVT_CONST_CAST_(e_) const_cast<QEvt *>(e_)
 
+#ifdef QF_PS_BROADCAST
+//! the reserved (empty) signal of the doorbells of the broadcast channels,
+//! see QP::QBroadcast
+#define QF_BCAST_SIG_ (static_cast<QSignal>(0))
+#endif // QF_PS_BROADCAST
+
 // QF-specific critical section...
 #ifndef QF_CRIT_STAT_TYPE
     //! This is an internal macro for defining the critical section
@@ -107,6 +113,81 @@
 
 #endif // Q_NASSERT
 
+// Per-object critical sections ----------------------------------------------
+#ifdef QF_OBJ_LOCK_TYPE // per-object locks provided by the QF port?
+
+    //! This is an internal macro for entering a critical section protected
+    //! by the per-object lock @p lock_.
+    /// @description
+    /// When the QF port provides per-object locks (#QF_OBJ_LOCK_TYPE), the
+    /// event queues, event pools, subscriber lists and time events are each
+    /// protected by their own lock, so that operations on unrelated objects
+    /// can proceed in parallel. Otherwise this macro falls back to the
+    /// global QF critical section and the @p lock_ argument is ignored.
+    /// @sa #QF_OBJ_LOCK_TYPE, #QF_CRIT_ENTRY_
+    #define QF_OBJ_CRIT_ENTRY_(lock_)  QF_OBJ_LOCK(&(lock_))
+
+    //! This is an internal macro for exiting a critical section protected
+    //! by the per-object lock @p lock_.
+    /// @sa #QF_OBJ_CRIT_ENTRY_
+    #define QF_OBJ_CRIT_EXIT_(lock_)   QF_OBJ_UNLOCK(&(lock_))
+
+    //! This is an internal macro for acquiring an additional per-object
+    //! lock @p lock_ inside an already entered critical section.
+    /// @description
+    /// With the global QF critical section all objects are already protected
+    /// and this macro does nothing. With per-object locks the locks must be
+    /// always nested in the same order to avoid deadlocks: event queue,
+    /// subscriber list, or time events first; event reference counter next;
+    /// and the QS trace buffer last.
+    #define QF_OBJ_NEST_ENTRY_(lock_)  QF_OBJ_LOCK(&(lock_))
+
+    //! This is an internal macro for releasing the nested lock @p lock_.
+    /// @sa #QF_OBJ_NEST_ENTRY_
+    #define QF_OBJ_NEST_EXIT_(lock_)   QF_OBJ_UNLOCK(&(lock_))
+
+    //! the lock protecting the reference counter of a dynamic event @p e_
+    #define QF_EVT_LOCK_(e_)    (QF_evtLock_[(e_)->poolId_ - 1U])
+
+    //! the identifier of the lock QF_EVT_LOCK_() of a dynamic event @p e_
+    #define QF_EVT_LOCK_ID_(e_) ((e_)->poolId_)
+
+#else // only the global QF critical section
+
+    #define QF_OBJ_CRIT_ENTRY_(lock_)  QF_CRIT_ENTRY_()
+    #define QF_OBJ_CRIT_EXIT_(lock_)   QF_CRIT_EXIT_()
+    #define QF_OBJ_NEST_ENTRY_(lock_)  ((void)0)
+    #define QF_OBJ_NEST_EXIT_(lock_)   ((void)0)
+    #define QF_EVT_LOCK_ID_(e_)        (1U)
+
+#endif // QF_OBJ_LOCK_TYPE
+
+// Assertions inside the per-object crticial section -------------------------
+#ifdef Q_NASSERT // Q_NASSERT defined--assertion checking disabled
+
+    #define Q_ASSERT_OBJ_CRIT_(lock_, id_, test_)  ((void)0)
+    #define Q_REQUIRE_OBJ_CRIT_(lock_, id_, test_) ((void)0)
+    #define Q_ERROR_OBJ_CRIT_(lock_, id_)          ((void)0)
+
+#else  // Q_NASSERT not defined--assertion checking enabled
+
+    #define Q_ASSERT_OBJ_CRIT_(lock_, id_, test_) do {\
+        if ((test_)) {} else { \
+            QF_OBJ_CRIT_EXIT_(lock_); \
+            Q_onAssert(&Q_this_module_[0], static_cast<int_t>(id_)); \
+        } \
+    } while (false)
+
+    #define Q_REQUIRE_OBJ_CRIT_(lock_, id_, test_) \
+        Q_ASSERT_OBJ_CRIT_(lock_, (id_), (test_))
+
+    #define Q_ERROR_OBJ_CRIT_(lock_, id_) do { \
+        QF_OBJ_CRIT_EXIT_(lock_); \
+        Q_onAssert(&Q_this_module_[0], static_cast<int_t>(id_)); \
+    } while (false)
+
+#endif // Q_NASSERT
+
 
 namespace QP {
 
@@ -116,6 +197,17 @@ extern uint_fast8_t QF_maxPool_;     //!< # of initialized event pools
 extern QSubscrList *QF_subscrList_;  //!< the subscriber list array
 extern enum_t QF_maxPubSignal_;      //!< the maximum published signal
 
+#ifdef QF_OBJ_LOCK_TYPE
+//! locks of the reference counters of events from the given event pool
+extern QF_OBJ_LOCK_TYPE QF_evtLock_[QF_MAX_EPOOL];
+
+//! locks of the time events armed at the given tick rate
+extern QF_OBJ_LOCK_TYPE QF_timeEvtLock_[QF_MAX_TICK_RATE];
+
+//! lock of the subscriber lists
+extern QF_OBJ_LOCK_TYPE QF_subscrLock_;
+#endif // QF_OBJ_LOCK_TYPE
+
 //............................................................................
 //! Structure representing a free block in the Native QF Memory Pool
 /// @sa QP::QMPool
@@ -123,6 +215,59 @@ struct QFreeBlock {
     QFreeBlock * volatile m_next;    //!< link to the next free block
 };
 
+#ifdef QF_MAGAZINE_SIZE
+#ifndef QF_EPOOL_GET_MANY_
+    #error "QF_MAGAZINE_SIZE is not supported in this QF port"
+#endif
+
+//............................................................................
+//! Per-thread cache (magazine) of free blocks of one event pool
+/// @description
+/// When #QF_MAGAZINE_SIZE is defined, every thread allocating or recycling
+/// dynamic events keeps up to #QF_MAGAZINE_SIZE free blocks of every event
+/// pool, so that the event pools themselves are accessed only in batches.
+/// The array of QF_MAX_EPOOL magazines of the calling thread is provided by
+/// the QF port through the function QF_magazines_().
+struct QFMagazine {
+    uint_fast16_t m_n;                //!< number of cached blocks
+    void *m_blk[QF_MAGAZINE_SIZE];    //!< the cached blocks
+};
+
+//! the magazines of the calling thread or NULL if it has none (QF port)
+QFMagazine *QF_magazines_(void);
+
+//! return all blocks cached in the magazines @p mags to the event pools
+void QF_magazineFlush_(QFMagazine * const mags);
+#endif // QF_MAGAZINE_SIZE
+
+#ifdef QF_DRAIN_MAX
+#ifndef QF_EPOOL_PUT_MANY_
+    #error "QF_DRAIN_MAX is not supported in this QF port"
+#endif
+#endif // QF_DRAIN_MAX
+
+#ifdef QF_PRIO_BANDS
+#ifndef QF_BAND_SCHED_
+    #error "QF_PRIO_BANDS is not supported in this QF port"
+#endif
+#endif // QF_PRIO_BANDS
+
+#ifdef QF_TIMEEVT_SLACK
+#ifdef QF_NO_POST_BATCH
+    #error "QF_TIMEEVT_SLACK is not supported in this QF port"
+#endif
+#endif // QF_TIMEEVT_SLACK
+
+#ifdef QF_TICKLESS
+#ifndef QF_TIMEEVT_NOW_
+    #error "QF_TICKLESS is not supported in this QF port"
+#endif
+#else
+    //! notify the QF port that a time event was armed for @p nTicks_
+    //! (tickless QF ports only, see NOTE3 in qf_time.cpp)
+    #define QF_TIMEEVT_ARMED_(nTicks_)  ((void)(nTicks_))
+#endif // QF_TICKLESS
+
 //............................................................................
 // The following flags and bitmasks are for the fields of the @c refCtr_
 // attribute of the QP::QTimeEvt class (inherited from QEvt). This attribute
@@ -144,10 +289,12 @@ inline uint8_t QF_EVT_POOL_ID_ (QEvt const * const e) {
 }
 
 //! return the Reference Conter of an event @p e
-inline uint8_t QF_EVT_REF_CTR_ (QEvt const * const e) {
+inline QEvtRefCtr QF_EVT_REF_CTR_ (QEvt const * const e) {
     return e->refCtr_;
 }
 
+#ifndef QF_EVT_REF_ATOMIC
+
 //! increment the refCtr_ of an event @p e
 inline void QF_EVT_REF_CTR_INC_(QEvt const * const e) {
     ++(QF_EVT_CONST_CAST_(e))->refCtr_;
@@ -158,6 +305,64 @@ inline void QF_EVT_REF_CTR_DEC_(QEvt const * const e) {
     --(QF_EVT_CONST_CAST_(e))->refCtr_;
 }
 
+//! This is an internal macro for protecting the refCtr_ of a dynamic
+//! event @p e_ inside an already entered critical section.
+/// @sa #QF_OBJ_NEST_ENTRY_
+#define QF_EVT_NEST_ENTRY_(e_)  QF_OBJ_NEST_ENTRY_(QF_EVT_LOCK_(e_))
+
+//! This is an internal macro for releasing the refCtr_ of a dynamic
+//! event @p e_ protected with #QF_EVT_NEST_ENTRY_.
+#define QF_EVT_NEST_EXIT_(e_)   QF_OBJ_NEST_EXIT_(QF_EVT_LOCK_(e_))
+
+#else // atomic reference counters provided by the QF port
+
+#if (!defined QF_EVT_REF_ATOMIC_DEC) || (!defined QF_EVT_REF_ATOMIC_LOAD)
+    #error "QF_EVT_REF_ATOMIC is not supported in this QF port"
+#endif
+
+//! increment the refCtr_ of an event @p e
+/// @description
+/// When the QF port defines #QF_EVT_REF_ATOMIC, the reference counters
+/// of dynamic events are incremented and decremented by the atomic
+/// operations QF_EVT_REF_ATOMIC_INC() and QF_EVT_REF_ATOMIC_DEC() provided
+/// by the port, and need no critical section.
+inline void QF_EVT_REF_CTR_INC_(QEvt const * const e) {
+    QF_EVT_REF_ATOMIC_INC(&(QF_EVT_CONST_CAST_(e))->refCtr_);
+}
+
+//! decrement the refCtr_ of an event @p e
+inline void QF_EVT_REF_CTR_DEC_(QEvt const * const e) {
+    (void)QF_EVT_REF_ATOMIC_DEC(&(QF_EVT_CONST_CAST_(e))->refCtr_);
+}
+
+//! read the refCtr_ of an event @p e (acquire), see NOTE1 in qf_dyn.cpp
+inline QEvtRefCtr QF_EVT_REF_CTR_GET_(QEvt const * const e) {
+    return QF_EVT_REF_ATOMIC_LOAD(&e->refCtr_);
+}
+
+#define QF_EVT_NEST_ENTRY_(e_)  ((void)0)
+#define QF_EVT_NEST_EXIT_(e_)   ((void)0)
+
+#endif // QF_EVT_REF_ATOMIC
+
+#ifdef QF_EVT_INLINE
+//! the content of the ring-buffer slot for the event @p e_, which is
+//! the event itself packed by value for QP::QInlineEvt
+#define QF_EVT_TO_SLOT_(e_)        (QInlineEvt::toSlot_(e_))
+
+//! the event in the ring-buffer slot @p s_, which is unpacked into
+//! the QP::QInlineEvt @p ie_ of the queue if it was packed by value
+#define QF_EVT_FROM_SLOT_(s_, ie_) (QInlineEvt::fromSlot_((s_), (ie_)))
+
+//! true if the event @p e_ is the QP::QInlineEvt @p ie_ of the queue,
+//! which holds only the last event unpacked by QF_EVT_FROM_SLOT_()
+#define QF_EVT_IS_INLINE_(e_, ie_) ((e_) == &(ie_))
+#else
+#define QF_EVT_TO_SLOT_(e_)        (e_)
+#define QF_EVT_FROM_SLOT_(s_, ie_) (s_)
+#define QF_EVT_IS_INLINE_(e_, ie_) (false)
+#endif // QF_EVT_INLINE
+
 //! macro to test that a pointer @p x_ is in range between @p min_ and @p max_
 /// @description
 /// This macro is specifically and exclusively used for checking the range
@@ -139,11 +139,11 @@ void QS::filterOn(uint_fast8_t const rec) {
     }
     else if (rec == static_cast<uint_fast8_t>(QS_AO_RECORDS)) {
         priv_.glbFilter[1] |= static_cast<uint8_t>(0xFC);
-        priv_.glbFilter[2] |= static_cast<uint8_t>(0x07);
+        priv_.glbFilter[2] |= static_cast<uint8_t>(0x87);
         priv_.glbFilter[5] |= static_cast<uint8_t>(0x20);
     }
     else if (rec == static_cast<uint_fast8_t>(QS_EQ_RECORDS)) {
-        priv_.glbFilter[2] |= static_cast<uint8_t>(0x78);
+        priv_.glbFilter[2] |= static_cast<uint8_t>(0xF8);
         priv_.glbFilter[5] |= static_cast<uint8_t>(0x40);
     }
     else if (rec == static_cast<uint_fast8_t>(QS_MP_RECORDS)) {
@@ -233,11 +233,11 @@ void QS::filterOff(uint_fast8_t const rec) {
     }
     else if (rec == static_cast<uint_fast8_t>(QS_AO_RECORDS)) {
         priv_.glbFilter[1] &= static_cast<uint8_t>(~0xFCU);
-        priv_.glbFilter[2] &= static_cast<uint8_t>(~0x07U);
+        priv_.glbFilter[2] &= static_cast<uint8_t>(~0x87U);
         priv_.glbFilter[5] &= static_cast<uint8_t>(~0x20U);
     }
     else if (rec == static_cast<uint_fast8_t>(QS_EQ_RECORDS)) {
-        priv_.glbFilter[2] &= static_cast<uint8_t>(~0x78U);
+        priv_.glbFilter[2] &= static_cast<uint8_t>(~0xF8U);
         priv_.glbFilter[5] &= static_cast<uint8_t>(~0x40U);
     }
     else if (rec == static_cast<uint_fast8_t>(QS_MP_RECORDS)) {
@@ -394,7 +394,8 @@ void QS_target_info_(uint8_t const isReset) {
 
         // send the limits...
         QS_U8_(static_cast<uint8_t>(QF_MAX_ACTIVE));
-        QS_U8_(static_cast<uint8_t>(QF_MAX_EPOOL)
+        QS_U8_(static_cast<uint8_t>(
+                   (QF_MAX_EPOOL < 15) ? QF_MAX_EPOOL : 15) // 4 bits only
                | static_cast<uint8_t>(
                      static_cast<uint8_t>(QF_MAX_TICK_RATE) << 4));
 
@@ -119,6 +119,12 @@ struct TPVar {  // Test-Probe
     uint8_t  idx;
 };
 
+//! the highest priority of an active object, which QS-RX can address with
+//! the 8-bit priority (the priorities 253..255 are reserved for the special
+//! targets of the events, see WAIT4_EVT_FRAME)
+#define QS_RX_MAX_PRIO_ \
+    ((QF_MAX_ACTIVE < 252) ? QF_MAX_ACTIVE : 252)
+
 struct AFltVar {
     uint8_t prio;
 };
@@ -1034,7 +1040,7 @@ void QS::rxHandleGoodFrame_(uint8_t state) {
         }
         case WAIT4_AO_FILTER_FRAME: {
             rxReportAck_(QS_RX_AO_FILTER);
-            if (l_rx.var.aFlt.prio <= static_cast<uint8_t>(QF_MAX_ACTIVE)) {
+            if (l_rx.var.aFlt.prio <= static_cast<uint8_t>(QS_RX_MAX_PRIO_)) {
                 rxReportAck_(QS_RX_AO_FILTER);
                 QS::priv_.locFilter[QS::AO_OBJ] =
                     QF::active_[l_rx.var.aFlt.prio];
@@ -1059,7 +1065,7 @@ void QS::rxHandleGoodFrame_(uint8_t state) {
                 QF::PUBLISH(l_rx.var.evt.e, &QS::rxPriv_);
                 rxReportDone_(QS_RX_EVENT);
             }
-            else if (l_rx.var.evt.prio < static_cast<uint8_t>(QF_MAX_ACTIVE))
+            else if (l_rx.var.evt.prio < static_cast<uint8_t>(QS_RX_MAX_PRIO_))
             {
                 if (!QF::active_[l_rx.var.evt.prio]->POST_X(
                                 l_rx.var.evt.e,
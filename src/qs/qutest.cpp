@@ -49,6 +49,11 @@ namespace QP {
 
 Q_DEFINE_THIS_MODULE("qutest")
 
+// QS::tickX_() below walks the linear lists of the time events
+#ifdef QF_TIMEEVT_WHEEL
+    #error "QF_TIMEEVT_WHEEL is not supported in QUTest"
+#endif // QF_TIMEEVT_WHEEL
+
 // Global objects ============================================================
 uint8_t volatile QF_intNest;
 
@@ -80,17 +85,17 @@ int_t QF::run(void) {
 }
 
 //............................................................................
-void QActive::start(uint_fast8_t const prio,
+void QActive::start(QPrio const prio,
                     QEvt const *qSto[], uint_fast16_t const qLen,
                     void * const, uint_fast16_t const,
                     QEvt const * const ie)
 {
     // priority must be in range
-    Q_REQUIRE_ID(200, (static_cast<uint_fast8_t>(0) < prio)
-        && (prio <= static_cast<uint_fast8_t>(QF_MAX_ACTIVE)));
+    Q_REQUIRE_ID(200, (static_cast<QPrio>(0) < prio)
+        && (prio <= static_cast<QPrio>(QF_MAX_ACTIVE)));
 
     m_eQueue.init(qSto, qLen); // initialize QEQueue of this AO
-    m_prio = static_cast<uint8_t>(prio); // set the QF prio of this AO
+    m_prio = static_cast<QPrioStore>(prio); // set the QF prio of this AO
 
     QF::add_(this); // make QF aware of this AO
 
@@ -107,7 +112,7 @@ QActiveDummy::QActiveDummy(void)
   : QActive(Q_STATE_CAST(0))
 {}
 //............................................................................
-void QActiveDummy::start(uint_fast8_t const prio,
+void QActiveDummy::start(QPrio const prio,
         QEvt const * qSto[], uint_fast16_t const qLen,
         void * const stkSto, uint_fast16_t const stkSize,
         QEvt const * const ie)
@@ -116,15 +121,15 @@ void QActiveDummy::start(uint_fast8_t const prio,
     // queue must NOT be provided
     // stack must NOT be provided
     // initialization event (ie) must NOT be provided
-    Q_REQUIRE_ID(300, (static_cast<uint_fast8_t>(0) < prio)
-        && (prio <= static_cast<uint_fast8_t>(QF_MAX_ACTIVE))
+    Q_REQUIRE_ID(300, (static_cast<QPrio>(0) < prio)
+        && (prio <= static_cast<QPrio>(QF_MAX_ACTIVE))
         && (qSto == static_cast<QEvt const **>(0))
         && (qLen == static_cast<uint_fast16_t>(0))
         && (stkSto == static_cast<void *>(0))
         && (stkSize == static_cast<uint_fast16_t>(0))
         && (ie == static_cast<QEvt const *>(0)));
 
-    m_prio = static_cast<uint8_t>(prio); // set the QF prio of this AO
+    m_prio = static_cast<QPrioStore>(prio); // set the QF prio of this AO
 
     QF::add_(this); // make QF aware of this AO
 
@@ -250,6 +255,23 @@ void QActiveDummy::postLIFO(QEvt const * const e) {
     // recycle the event immediately, because it was not really posted
     QF::gc(e);
 }
+//............................................................................
+bool QActiveDummy::postBatch_(QEvt const * const evts[],
+                              uint_fast16_t const n,
+                              uint_fast16_t const margin,
+                              void const * const sender)
+{
+    bool status = true;
+    uint_fast16_t i;
+
+    // post the events one by one, so that each of them can be examined
+    for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        if (!POST_X(evts[i], margin, sender)) {
+            status = false;
+        }
+    }
+    return status;
+}
 
 //****************************************************************************
 void QS::processTestEvts_(void) {
@@ -259,7 +281,7 @@ void QS::processTestEvts_(void) {
     QS_TEST_PROBE(return;)
 
     while (rxPriv_.readySet.notEmpty()) {
-        uint_fast8_t p = rxPriv_.readySet.findMax();
+        QPrio p = rxPriv_.readySet.findMax();
         QActive *a = QF::active_[p];
 
         // perform the run-to-completion (RTC) step...
@@ -269,8 +291,10 @@ void QS::processTestEvts_(void) {
         // 3. determine if event is garbage and collect it if so
         //
         QEvt const *e = a->get_();
-        a->dispatch(e);
-        QF::gc(e);
+        if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+            a->dispatch(e);
+            QF::gc(e);
+        }
 
         if (a->m_eQueue.isEmpty()) { // empty queue?
             rxPriv_.readySet.remove(p);
@@ -292,6 +316,8 @@ void QS::tickX_(uint_fast8_t const tickRate, void const * const sender) {
     QF_CRIT_ENTRY_();
     QTimeEvt *prev = &QF::timeEvtHead_[tickRate];
 
+    ++QF::tickCtr_[tickRate]; // monotonic tick counter
+
     QS_BEGIN_NOCRIT_(QS_QF_TICK, static_cast<void*>(0), static_cast<void*>(0))
         QS_TEC_(static_cast<QTimeEvtCtr>(++prev->m_ctr)); // tick ctr
         QS_U8_(static_cast<uint8_t>(tickRate));           // tick rate
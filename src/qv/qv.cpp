@@ -82,6 +82,8 @@ void QF::init(void) {
 
     bzero(&QF::timeEvtHead_[0],
           static_cast<uint_fast16_t>(sizeof(QF::timeEvtHead_)));
+    bzero(&QF::tickCtr_[0],
+          static_cast<uint_fast16_t>(sizeof(QF::tickCtr_)));
     bzero(&active_[0], static_cast<uint_fast16_t>(sizeof(active_)));
     bzero(&QV_readySet_, static_cast<uint_fast16_t>(sizeof(QV_readySet_)));
 
@@ -124,7 +126,7 @@ void QF::stop(void) {
 ///
 int_t QF::run(void) {
 #ifdef Q_SPY
-    uint_fast8_t pprev = static_cast<uint_fast8_t>(0); // previous priority
+    QPrio pprev = static_cast<QPrio>(0); // previous priority
 #endif
 
     onStartup(); // startup callback
@@ -135,7 +137,10 @@ int_t QF::run(void) {
 
         // find the maximum priority AO ready to run
         if (QV_readySet_.notEmpty()) {
-            uint_fast8_t p = QV_readySet_.findMax();
+            QPrio p = QV_readySet_.findMax();
+#ifdef QF_PRIO_BANDS
+            p = bandNext_(p, QV_readySet_); // round-robin in the band
+#endif
             QActive *a = active_[p];
 
 #ifdef Q_SPY
@@ -158,8 +163,10 @@ int_t QF::run(void) {
             // 3. determine if event is garbage and collect it if so
             //
             QEvt const *e = a->get_();
-            a->dispatch(e);
-            gc(e);
+            if (e != static_cast<QEvt const *>(0)) { // not a stale doorbell?
+                a->dispatch(e);
+                gc(e);
+            }
 
             QF_INT_DISABLE();
 
@@ -169,14 +176,14 @@ int_t QF::run(void) {
         }
         else { // no AO ready to run --> idle
 #ifdef Q_SPY
-            if (pprev != static_cast<uint_fast8_t>(0)) {
+            if (pprev != static_cast<QPrio>(0)) {
                 QS_BEGIN_NOCRIT_(QS_SCHED_IDLE,
                     static_cast<void *>(0), static_cast<void *>(0))
                     QS_TIME_();                          // timestamp
                     QS_U8_(static_cast<uint8_t>(pprev)); // previous prio
                 QS_END_NOCRIT_()
 
-                pprev = static_cast<uint_fast8_t>(0); // update previous prio
+                pprev = static_cast<QPrio>(0); // update previous prio
             }
 #endif // Q_SPY
 
@@ -214,7 +221,7 @@ int_t QF::run(void) {
 /// The following example shows starting an AO when a per-task stack is needed
 /// @include qf_start.cpp
 ///
-void QActive::start(uint_fast8_t const prio,
+void QActive::start(QPrio const prio,
                      QEvt const *qSto[], uint_fast16_t const qLen,
                      void * const stkSto, uint_fast16_t const,
                      QEvt const * const ie)
@@ -222,12 +229,12 @@ void QActive::start(uint_fast8_t const prio,
     /// @pre the priority must be in range and the stack storage must not
     /// be provided, because the QV kernel does not need per-AO stacks.
     ///
-    Q_REQUIRE_ID(500, (static_cast<uint_fast8_t>(0) < prio)
-                      && (prio <= static_cast<uint_fast8_t>(QF_MAX_ACTIVE))
+    Q_REQUIRE_ID(500, (static_cast<QPrio>(0) < prio)
+                      && (prio <= static_cast<QPrio>(QF_MAX_ACTIVE))
                       && (stkSto == static_cast<void *>(0)));
 
     m_eQueue.init(qSto, qLen); // initialize QEQueue of this AO
-    m_prio = static_cast<uint8_t>(prio);  // set the QF prio of this AO
+    m_prio = static_cast<QPrioStore>(prio); // set the QF prio of this AO
 
     QF::add_(this); // make QF aware of this AO
 
@@ -252,7 +259,7 @@ void QActive::stop(void) {
 
     QF_CRIT_STAT_
     QF_CRIT_ENTRY_();
-    QV_readySet_.remove(static_cast<uint_fast8_t>(m_prio)); // AO is not ready
+    QV_readySet_.remove(static_cast<QPrio>(m_prio)); // AO is not ready
     QF_CRIT_EXIT_();
 }
 
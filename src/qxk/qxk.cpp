@@ -87,6 +87,7 @@ void QF::init(void) {
     QF_maxPubSignal_ = static_cast<enum_t>(0);
 
     bzero(&timeEvtHead_[0], static_cast<uint_fast16_t>(sizeof(timeEvtHead_)));
+    bzero(&tickCtr_[0],     static_cast<uint_fast16_t>(sizeof(tickCtr_)));
     bzero(&active_[0],      static_cast<uint_fast16_t>(sizeof(active_)));
     bzero(&QXK_attr_,       static_cast<uint_fast16_t>(sizeof(QXK_attr_)));
     bzero(&l_idleThread,    static_cast<uint_fast16_t>(sizeof(l_idleThread)));
@@ -171,7 +172,7 @@ int_t QF::run(void) {
 // @param[in] ie      pointer to the optional initialization event
 //                    (might be NULL).
 //
-void QActive::start(uint_fast8_t const prio,
+void QActive::start(QPrio const prio,
                      QEvt const *qSto[], uint_fast16_t const qLen,
                      void * const stkSto, uint_fast16_t const stkSize,
                      QEvt const * const ie)
@@ -489,8 +490,10 @@ void QXK_activate_(void) {
         // 3. determine if event is garbage and collect it if so
         //
         QP::QEvt const *e = a->get_();
-        a->dispatch(e);
-        QP::QF::gc(e);
+        if (e != static_cast<QP::QEvt const *>(0)) { // not a stale doorbell?
+            a->dispatch(e);
+            QP::QF::gc(e);
+        }
 
         QF_INT_DISABLE(); // unconditionally disable interrupts
 
@@ -51,6 +51,11 @@
     #error "Source file included in a project NOT based on the QXK kernel"
 #endif // qxk_h
 
+// the timeouts of the extended threads link the time events directly
+#ifdef QF_TIMEEVT_WHEEL
+    #error "QF_TIMEEVT_WHEEL is not supported in the QXK kernel"
+#endif // QF_TIMEEVT_WHEEL
+
 namespace QP {
 
 Q_DEFINE_THIS_MODULE("qxk_xthr")
@@ -113,7 +118,7 @@ void QXThread::dispatch(QEvt const * const /*e*/) {
 /// The following example shows starting an extended thread:
 /// @include qxk_xstart.cpp
 ///
-void QXThread::start(uint_fast8_t const prio,
+void QXThread::start(QPrio const prio,
                      QEvt const *qSto[], uint_fast16_t const qLen,
                      void * const stkSto, uint_fast16_t const stkSize,
                      QEvt const * const /*ie*/)
@@ -267,7 +272,8 @@ bool QXThread::post_(QEvt const * const e, uint_fast16_t const margin,
 
             // queue empty?
             if (m_eQueue.m_frontEvt == static_cast<QEvt const *>(0)) {
-                m_eQueue.m_frontEvt = e;  // deliver event directly
+                // deliver event directly
+                m_eQueue.m_frontEvt = QF_EVT_TO_SLOT_(e);
 
                 // is this thread blocked on the queue?
                 if (isBlockedOn(&m_eQueue)) {
@@ -282,7 +288,8 @@ bool QXThread::post_(QEvt const * const e, uint_fast16_t const margin,
             // queue is not empty, insert event into the ring-buffer
             else {
                 // insert event into the ring buffer (FIFO)
-                QF_PTR_AT_(m_eQueue.m_ring, m_eQueue.m_head) = e;
+                QF_PTR_AT_(m_eQueue.m_ring, m_eQueue.m_head) =
+                    QF_EVT_TO_SLOT_(e);
 
                 // need to wrap the head couner?
                 if (m_eQueue.m_head == static_cast<QEQueueCtr>(0)) {
@@ -333,6 +340,38 @@ void QXThread::postLIFO(QEvt const * const /*e*/) {
     Q_ERROR_ID(410);
 }
 
+//****************************************************************************
+/// @description
+/// The extended thread posts the batch of events one by one, so it cannot
+/// guarantee that either all or none of the events are posted. Therefore
+/// only the batches with the delivery guarantee (POST_BATCH()) are allowed.
+///
+/// @param[in] evts   array of pointers to the events to post
+/// @param[in] n      number of the events in the array
+/// @param[in] margin must be QP::QF_NO_MARGIN
+///
+/// @sa
+/// QActive::postBatch_()
+///
+#ifndef Q_SPY
+bool QXThread::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                          uint_fast16_t const margin)
+#else
+bool QXThread::postBatch_(QEvt const * const evts[], uint_fast16_t const n,
+                          uint_fast16_t const margin,
+                          void const * const sender)
+#endif
+{
+    uint_fast16_t i;
+
+    Q_REQUIRE_ID(420, margin == QF_NO_MARGIN);
+
+    for (i = static_cast<uint_fast16_t>(0); i < n; ++i) {
+        (void)POST(evts[i], sender); // asserts if the queue overflows
+    }
+    return true; // the events are always posted correctly
+}
+
 //****************************************************************************
 /// @description
 /// The QXThread::queueGet() operation allows the calling extended thread to
@@ -392,7 +431,9 @@ QEvt const *QXThread::queueGet(uint_fast16_t const nTicks) {
 
     // is the queue not empty?
     if (thr->m_eQueue.m_frontEvt != static_cast<QEvt *>(0)) {
-        e = thr->m_eQueue.m_frontEvt; // always remove from the front
+        // always remove from the front
+        e = QF_EVT_FROM_SLOT_(thr->m_eQueue.m_frontEvt,
+                              thr->m_eQueue.m_inlineEvt);
         // volatile into tmp
         nFree= thr->m_eQueue.m_nFree + static_cast<QEQueueCtr>(1);
         thr->m_eQueue.m_nFree = nFree; // update the number of free